@@ -29,6 +29,9 @@
 set(CRC_BASE_SOURCES
     crc/crc_base.c
     crc/crc64_base.c
+    crc/crc_combine.c
+    crc/crc_engine.c
+    crc/crc_pi.c
 )
 
 set(CRC_BASE_ALIASES_SOURCES
@@ -36,6 +39,8 @@ set(CRC_BASE_ALIASES_SOURCES
 )
 
 set(CRC_X86_64_SOURCES
+    crc/crc_mb.c
+    crc/crc_copy.c
     crc/crc_const.asm
     crc/crc16_t10dif_01.asm
     crc/crc16_t10dif_avx2.asm
@@ -82,6 +87,8 @@ set(CRC_X86_64_SOURCES
 set(CRC_RISCV64_SOURCES
     crc/riscv64/crc_multibinary_riscv.S
     crc/riscv64/crc_riscv64_dispatcher.c
+    crc/crc_mb.c
+    crc/crc_copy.c
     crc/riscv64/crc16_t10dif_vclmul.S
     crc/riscv64/crc16_t10dif_copy_vclmul.S
     crc/riscv64/crc32_ieee_norm_vclmul.S
@@ -100,6 +107,8 @@ set(CRC_RISCV64_SOURCES
 set(CRC_AARCH64_SOURCES
     crc/aarch64/crc_multibinary_arm.S
     crc/aarch64/crc_aarch64_dispatcher.c
+    crc/crc_mb.c
+    crc/crc_copy.c
     crc/aarch64/crc16_t10dif_pmull.S
     crc/aarch64/crc16_t10dif_copy_pmull.S
     crc/aarch64/crc32_ieee_norm_pmull.S
@@ -144,6 +153,7 @@ endif()
 set(CRC_HEADERS
     include/crc.h
     include/crc64.h
+    include/crc_pi.h
 )
 
 # Add to main extern headers list
@@ -157,6 +167,11 @@ if(ISAL_BUILD_TESTS)
         crc16_t10dif_copy_test
         crc64_funcs_test
         crc32_funcs_test
+        crc_combine_test
+        crc_mb_test
+        crc_copy_test
+        crc_engine_test
+        crc_pi_test
     )
 
     # Create check test executables
@@ -29,6 +29,8 @@
 
 set(ERASURE_CODE_BASE_SOURCES
     erasure_code/ec_base.c
+    erasure_code/ec_decode_cache.c
+    erasure_code/ec_encode_mt.c
 )
 
 set(ERASURE_CODE_BASE_ALIASES_SOURCES
@@ -206,6 +208,8 @@ if(ISAL_BUILD_TESTS)
         erasure_code_test
         gf_inverse_test
         erasure_code_update_test
+        erasure_code_decode_test
+        erasure_code_mt_test
     )
 
     # Unit tests (additional unit tests)
@@ -38,6 +38,12 @@ set(IGZIP_BASE_SOURCES
     igzip/igzip_icf_body.c
     igzip/huff_codes.c
     igzip/igzip_inflate.c
+    igzip/igzip_deflate_parallel.c
+    igzip/igzip_inflate_parallel.c
+    igzip/igzip_bgzf.c
+    igzip/igzip_inflate_index.c
+    igzip/igzip_inflate_compact.c
+    igzip/igzip_deflate_compact.c
 )
 
 set(IGZIP_BASE_ALIASES_SOURCES
@@ -128,6 +134,14 @@ if(ISAL_BUILD_TESTS)
         igzip_rand_test
         igzip_wrapper_hdr_test
         checksum32_funcs_test
+        igzip_deflate_parallel_test
+        igzip_inflate_parallel_test
+        igzip_bgzf_test
+        igzip_inflate_index_test
+        igzip_inflate_hdr_cache_test
+        igzip_inflate_verify_test
+        igzip_inflate_compact_test
+        igzip_deflate_compact_test
     )
 
     # Create check test executables
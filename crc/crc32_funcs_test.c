@@ -103,6 +103,9 @@ eob_test(func_case_t *test_func);
 int
 update_test(func_case_t *test_func);
 
+int
+combine_test(void);
+
 void *buf_alloc = NULL;
 
 int
@@ -139,6 +142,14 @@ main(int argc, char *argv[])
                 }
         }
 
+        printf("Test crc32_gzip_refl_combine\t");
+        fail_case = combine_test();
+        printf(" done: %s\n", fail_case ? "Fail" : "Pass");
+        if (fail_case) {
+                printf("\ncrc32_gzip_refl_combine Failed %d tests\n", fail_case);
+                fail++;
+        }
+
         printf("CRC32 Tests all done: %s\n", fail ? "Fail" : "Pass");
 
         aligned_free(buf_alloc);
@@ -349,3 +360,40 @@ update_test(func_case_t *test_func)
 
         return fail;
 }
+
+// Combine CRCs of split buffers and compare against a single pass
+int
+combine_test(void)
+{
+        uint32_t crc_ref, crc1, crc2, crc, r;
+        int fail = 0;
+        int i;
+        uint64_t len, split;
+        unsigned char *buf = NULL;
+
+        buf = (unsigned char *) buf_alloc; // reset buf
+        rand_buffer(buf, MAX_BUF * TEST_SIZE);
+
+        for (i = 0; i < TEST_SIZE * 4; i++) {
+                r = rand();
+                len = rand() % (MAX_BUF * TEST_SIZE + 1);
+                split = (i == 0) ? 0 : (i == 1) ? len : rand() % (len + 1);
+
+                crc_ref = crc32_gzip_refl_ref(r, buf, len);
+                crc1 = crc32_gzip_refl(r, buf, split);
+                crc2 = crc32_gzip_refl(0, buf + split, len - split);
+                crc = crc32_gzip_refl_combine(crc1, crc2, len - split);
+
+                if (crc != crc_ref) {
+                        fail++;
+                        printf("fail crc combine len=%lu split=%lu 0x%8x 0x%8x\n",
+                               (unsigned long) len, (unsigned long) split, crc_ref, crc);
+                }
+#ifdef TEST_VERBOSE
+                else if (i % TEST_SIZE == 0)
+                        printf(".");
+#endif
+        }
+
+        return fail;
+}
@@ -668,3 +668,160 @@ crc64_rocksoft_norm_base(uint64_t seed, const uint8_t *buf, uint64_t len)
 
         return ~crc;
 }
+
+/*
+ * Multi-buffer version runs CRC_MB_LANES independent buffers in lockstep over
+ * their common length so that the table lookups of different lanes overlap.
+ */
+
+#define CRC_MB_LANES 4
+
+void
+crc64_rocksoft_refl_mb_base(uint32_t n, unsigned char *const *bufs, const uint64_t *lens,
+                            uint64_t *crcs)
+{
+        uint32_t i;
+        uint64_t j, common;
+        int k;
+
+        for (i = 0; i + CRC_MB_LANES <= n; i += CRC_MB_LANES) {
+                const unsigned char *p0 = bufs[i], *p1 = bufs[i + 1];
+                const unsigned char *p2 = bufs[i + 2], *p3 = bufs[i + 3];
+                uint64_t c0 = ~crcs[i], c1 = ~crcs[i + 1], c2 = ~crcs[i + 2], c3 = ~crcs[i + 3];
+
+                common = lens[i];
+                for (k = 1; k < CRC_MB_LANES; k++)
+                        if (lens[i + k] < common)
+                                common = lens[i + k];
+
+                for (j = 0; j < common; j++) {
+                        c0 = crc64_rocksoft_refl_table[(uint8_t) c0 ^ p0[j]] ^ (c0 >> 8);
+                        c1 = crc64_rocksoft_refl_table[(uint8_t) c1 ^ p1[j]] ^ (c1 >> 8);
+                        c2 = crc64_rocksoft_refl_table[(uint8_t) c2 ^ p2[j]] ^ (c2 >> 8);
+                        c3 = crc64_rocksoft_refl_table[(uint8_t) c3 ^ p3[j]] ^ (c3 >> 8);
+                }
+                crcs[i] = ~c0;
+                crcs[i + 1] = ~c1;
+                crcs[i + 2] = ~c2;
+                crcs[i + 3] = ~c3;
+
+                for (k = 0; k < CRC_MB_LANES; k++)
+                        crcs[i + k] = crc64_rocksoft_refl_base(crcs[i + k], bufs[i + k] + common,
+                                                               lens[i + k] - common);
+        }
+
+        for (; i < n; i++)
+                crcs[i] = crc64_rocksoft_refl_base(crcs[i], bufs[i], lens[i]);
+}
+
+uint64_t
+crc64_ecma_refl_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_ecma_refl_table[(uint8_t) crc ^ byte] ^ (crc >> 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
+
+uint64_t
+crc64_ecma_norm_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_ecma_norm_table[((crc >> 56) ^ byte) & 0xff] ^ (crc << 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
+
+uint64_t
+crc64_iso_refl_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_iso_refl_table[(uint8_t) crc ^ byte] ^ (crc >> 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
+
+uint64_t
+crc64_iso_norm_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_iso_norm_table[((crc >> 56) ^ byte) & 0xff] ^ (crc << 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
+
+uint64_t
+crc64_jones_refl_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_jones_refl_table[(uint8_t) crc ^ byte] ^ (crc >> 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
+
+uint64_t
+crc64_jones_norm_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_jones_norm_table[((crc >> 56) ^ byte) & 0xff] ^ (crc << 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
+
+uint64_t
+crc64_rocksoft_refl_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_rocksoft_refl_table[(uint8_t) crc ^ byte] ^ (crc >> 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
+
+uint64_t
+crc64_rocksoft_norm_copy_base(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        uint64_t i, crc = ~seed;
+
+        for (i = 0; i < len; i++) {
+                uint8_t byte = src[i];
+                crc = crc64_rocksoft_norm_table[((crc >> 56) ^ byte) & 0xff] ^ (crc << 8);
+                dst[i] = byte;
+        }
+
+        return ~crc;
+}
@@ -247,3 +247,126 @@ crc32_gzip_refl_base(uint32_t seed, uint8_t *buf, uint64_t len)
 
         return ~crc;
 }
+
+/*
+ * Multi-buffer versions run CRC_MB_LANES independent buffers in lockstep over
+ * their common length so that the table lookups of different lanes overlap.
+ * Each lane then finishes its own tail.
+ */
+
+#define CRC_MB_LANES 4
+
+// crc32_iscsi_base() takes an int length so longer buffers go in pieces
+#define CRC_MB_MAX_CALL (1 << 30)
+
+static uint32_t
+crc32_iscsi_base_long(unsigned char *buf, uint64_t len, uint32_t crc)
+{
+        for (; len > CRC_MB_MAX_CALL; buf += CRC_MB_MAX_CALL, len -= CRC_MB_MAX_CALL)
+                crc = crc32_iscsi_base(buf, CRC_MB_MAX_CALL, crc);
+        return crc32_iscsi_base(buf, (int) len, crc);
+}
+
+static inline uint64_t
+crc_mb_min_len(const uint64_t *lens)
+{
+        uint64_t m = lens[0];
+        int k;
+
+        for (k = 1; k < CRC_MB_LANES; k++)
+                if (lens[k] < m)
+                        m = lens[k];
+        return m;
+}
+
+void
+crc32_iscsi_mb_base(uint32_t n, unsigned char *const *bufs, const uint64_t *lens, uint32_t *crcs)
+{
+        uint32_t i;
+        uint64_t j, common;
+        int k;
+
+        for (i = 0; i + CRC_MB_LANES <= n; i += CRC_MB_LANES) {
+                const unsigned char *p0 = bufs[i], *p1 = bufs[i + 1];
+                const unsigned char *p2 = bufs[i + 2], *p3 = bufs[i + 3];
+                uint32_t c0 = crcs[i], c1 = crcs[i + 1], c2 = crcs[i + 2], c3 = crcs[i + 3];
+
+                common = crc_mb_min_len(&lens[i]);
+                for (j = 0; j < common; j++) {
+                        c0 = (c0 >> 8) ^ crc32_table_iscsi_refl[(c0 ^ p0[j]) & 0xff];
+                        c1 = (c1 >> 8) ^ crc32_table_iscsi_refl[(c1 ^ p1[j]) & 0xff];
+                        c2 = (c2 >> 8) ^ crc32_table_iscsi_refl[(c2 ^ p2[j]) & 0xff];
+                        c3 = (c3 >> 8) ^ crc32_table_iscsi_refl[(c3 ^ p3[j]) & 0xff];
+                }
+                crcs[i] = c0;
+                crcs[i + 1] = c1;
+                crcs[i + 2] = c2;
+                crcs[i + 3] = c3;
+
+                for (k = 0; k < CRC_MB_LANES; k++)
+                        crcs[i + k] = crc32_iscsi_base_long(bufs[i + k] + common,
+                                                            lens[i + k] - common, crcs[i + k]);
+        }
+
+        for (; i < n; i++)
+                crcs[i] = crc32_iscsi_base_long(bufs[i], lens[i], crcs[i]);
+}
+
+void
+crc16_t10dif_mb_base(uint32_t n, unsigned char *const *bufs, const uint64_t *lens, uint16_t *crcs)
+{
+        uint32_t i;
+        uint64_t j, common;
+        int k;
+
+        for (i = 0; i + CRC_MB_LANES <= n; i += CRC_MB_LANES) {
+                const unsigned char *p0 = bufs[i], *p1 = bufs[i + 1];
+                const unsigned char *p2 = bufs[i + 2], *p3 = bufs[i + 3];
+                uint16_t c0 = crcs[i], c1 = crcs[i + 1], c2 = crcs[i + 2], c3 = crcs[i + 3];
+
+                common = crc_mb_min_len(&lens[i]);
+                for (j = 0; j < common; j++) {
+                        c0 = (c0 << 8) ^ crc16tab[((c0 >> 8) ^ p0[j]) & 0xff];
+                        c1 = (c1 << 8) ^ crc16tab[((c1 >> 8) ^ p1[j]) & 0xff];
+                        c2 = (c2 << 8) ^ crc16tab[((c2 >> 8) ^ p2[j]) & 0xff];
+                        c3 = (c3 << 8) ^ crc16tab[((c3 >> 8) ^ p3[j]) & 0xff];
+                }
+                crcs[i] = c0;
+                crcs[i + 1] = c1;
+                crcs[i + 2] = c2;
+                crcs[i + 3] = c3;
+
+                for (k = 0; k < CRC_MB_LANES; k++)
+                        crcs[i + k] = crc16_t10dif_base(crcs[i + k], bufs[i + k] + common,
+                                                        lens[i + k] - common);
+        }
+
+        for (; i < n; i++)
+                crcs[i] = crc16_t10dif_base(crcs[i], bufs[i], lens[i]);
+}
+
+uint32_t
+crc32_iscsi_copy_base(uint32_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        unsigned int crc = seed;
+
+        while (len--) {
+                crc = (crc >> 8) ^ crc32_table_iscsi_refl[(crc & 0x000000FF) ^ *src];
+                *dst++ = *src++;
+        }
+
+        return crc;
+}
+
+uint32_t
+crc32_gzip_refl_copy_base(uint32_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        unsigned int crc = ~seed;
+
+        while (len--) {
+                crc = (crc >> 8) ^ crc32_table_gzip_refl[(crc & 0x000000FF) ^ *src];
+                *dst++ = *src++;
+        }
+
+        return ~crc;
+}
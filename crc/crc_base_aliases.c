@@ -108,3 +108,82 @@ crc64_rocksoft_norm(uint64_t seed, const uint8_t *buf, uint64_t len)
 {
         return crc64_rocksoft_norm_base(seed, buf, len);
 }
+
+void
+crc32_iscsi_mb(uint32_t n, unsigned char *const *bufs, const uint64_t *lens, uint32_t *crcs)
+{
+        crc32_iscsi_mb_base(n, bufs, lens, crcs);
+}
+
+void
+crc16_t10dif_mb(uint32_t n, unsigned char *const *bufs, const uint64_t *lens, uint16_t *crcs)
+{
+        crc16_t10dif_mb_base(n, bufs, lens, crcs);
+}
+
+void
+crc64_rocksoft_refl_mb(uint32_t n, unsigned char *const *bufs, const uint64_t *lens,
+                       uint64_t *crcs)
+{
+        crc64_rocksoft_refl_mb_base(n, bufs, lens, crcs);
+}
+
+uint32_t
+crc32_iscsi_copy(uint32_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc32_iscsi_copy_base(seed, dst, src, len);
+}
+
+uint32_t
+crc32_gzip_refl_copy(uint32_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc32_gzip_refl_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_ecma_refl_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_ecma_refl_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_ecma_norm_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_ecma_norm_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_iso_refl_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_iso_refl_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_iso_norm_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_iso_norm_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_jones_refl_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_jones_refl_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_jones_norm_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_jones_norm_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_rocksoft_refl_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_rocksoft_refl_copy_base(seed, dst, src, len);
+}
+
+uint64_t
+crc64_rocksoft_norm_copy(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc64_rocksoft_norm_copy_base(seed, dst, src, len);
+}
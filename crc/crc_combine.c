@@ -0,0 +1,355 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/*
+ * CRC combine
+ *
+ * Appending len2 bytes to a message multiplies its CRC register by x^(8*len2)
+ * modulo the CRC polynomial P. For every CRC in crc.h and crc64.h, including
+ * the ones with pre/post inversion, the CRC of A|B can therefore be formed as
+ *
+ *     crc(seed, A|B) = (crc(seed, A) * x^(8*len(B)) mod P) ^ crc(0, B)
+ *
+ * The length dependent factor x^(8*len2) mod P is found by square-and-multiply
+ * and can be computed once with *_combine_precompute() when many pieces share
+ * the same length. The remaining fold is a single multiply mod P.
+ *
+ * Values are kept in the bit order of the CRC register. For reflected CRCs the
+ * coefficient of x^0 is the most significant bit of the width, for normal CRCs
+ * it is bit 0.
+ */
+
+#include <stdint.h>
+#include "crc.h"
+#include "crc64.h"
+
+static uint64_t
+refl_multmodp(uint64_t a, uint64_t b, uint64_t poly, int width)
+{
+        uint64_t m = 1ULL << (width - 1);
+        uint64_t p = 0;
+
+        while (a != 0) {
+                if (a & m) {
+                        p ^= b;
+                        a ^= m;
+                }
+                m >>= 1;
+                b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+        }
+        return p;
+}
+
+static uint64_t
+norm_multmodp(uint64_t a, uint64_t b, uint64_t poly, int width)
+{
+        const uint64_t top = 1ULL << (width - 1);
+        const uint64_t mask = top | (top - 1);
+        uint64_t p = 0;
+
+        while (a != 0) {
+                if (a & 1)
+                        p ^= b;
+                a >>= 1;
+                b = (b & top) ? ((b << 1) & mask) ^ poly : (b << 1) & mask;
+        }
+        return p;
+}
+
+static uint64_t
+refl_x8nmodp(uint64_t n, uint64_t poly, int width)
+{
+        uint64_t p = 1ULL << (width - 1);       // x^0
+        uint64_t x2k = 1ULL << (width - 1 - 8); // x^8
+
+        while (n != 0) {
+                if (n & 1)
+                        p = refl_multmodp(x2k, p, poly, width);
+                x2k = refl_multmodp(x2k, x2k, poly, width);
+                n >>= 1;
+        }
+        return p;
+}
+
+static uint64_t
+norm_x8nmodp(uint64_t n, uint64_t poly, int width)
+{
+        uint64_t p = 1;        // x^0
+        uint64_t x2k = 1 << 8; // x^8
+
+        while (n != 0) {
+                if (n & 1)
+                        p = norm_multmodp(x2k, p, poly, width);
+                x2k = norm_multmodp(x2k, x2k, poly, width);
+                n >>= 1;
+        }
+        return p;
+}
+
+#define CRC16_T10DIF_POLY 0x8bb7
+
+uint16_t
+crc16_t10dif_combine_precompute(uint64_t len2)
+{
+        return (uint16_t) norm_x8nmodp(len2, CRC16_T10DIF_POLY, 16);
+}
+
+uint16_t
+crc16_t10dif_combine_fast(uint16_t crc1, uint16_t crc2, uint16_t xk)
+{
+        return (uint16_t) norm_multmodp(xk, crc1, CRC16_T10DIF_POLY, 16) ^ crc2;
+}
+
+uint16_t
+crc16_t10dif_combine(uint16_t crc1, uint16_t crc2, uint64_t len2)
+{
+        return crc16_t10dif_combine_fast(crc1, crc2, crc16_t10dif_combine_precompute(len2));
+}
+
+#define CRC32_IEEE_POLY 0x04c11db7
+
+uint32_t
+crc32_ieee_combine_precompute(uint64_t len2)
+{
+        return (uint32_t) norm_x8nmodp(len2, CRC32_IEEE_POLY, 32);
+}
+
+uint32_t
+crc32_ieee_combine_fast(uint32_t crc1, uint32_t crc2, uint32_t xk)
+{
+        return (uint32_t) norm_multmodp(xk, crc1, CRC32_IEEE_POLY, 32) ^ crc2;
+}
+
+uint32_t
+crc32_ieee_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+        return crc32_ieee_combine_fast(crc1, crc2, crc32_ieee_combine_precompute(len2));
+}
+
+#define CRC32_GZIP_REFL_POLY 0xedb88320
+
+uint32_t
+crc32_gzip_refl_combine_precompute(uint64_t len2)
+{
+        return (uint32_t) refl_x8nmodp(len2, CRC32_GZIP_REFL_POLY, 32);
+}
+
+uint32_t
+crc32_gzip_refl_combine_fast(uint32_t crc1, uint32_t crc2, uint32_t xk)
+{
+        return (uint32_t) refl_multmodp(xk, crc1, CRC32_GZIP_REFL_POLY, 32) ^ crc2;
+}
+
+uint32_t
+crc32_gzip_refl_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+        return crc32_gzip_refl_combine_fast(crc1, crc2, crc32_gzip_refl_combine_precompute(len2));
+}
+
+#define CRC32_ISCSI_POLY 0x82f63b78
+
+uint32_t
+crc32_iscsi_combine_precompute(uint64_t len2)
+{
+        return (uint32_t) refl_x8nmodp(len2, CRC32_ISCSI_POLY, 32);
+}
+
+uint32_t
+crc32_iscsi_combine_fast(uint32_t crc1, uint32_t crc2, uint32_t xk)
+{
+        return (uint32_t) refl_multmodp(xk, crc1, CRC32_ISCSI_POLY, 32) ^ crc2;
+}
+
+uint32_t
+crc32_iscsi_combine(uint32_t crc1, uint32_t crc2, uint64_t len2)
+{
+        return crc32_iscsi_combine_fast(crc1, crc2, crc32_iscsi_combine_precompute(len2));
+}
+
+#define CRC64_ECMA_REFL_POLY 0xc96c5795d7870f42ULL
+
+uint64_t
+crc64_ecma_refl_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) refl_x8nmodp(len2, CRC64_ECMA_REFL_POLY, 64);
+}
+
+uint64_t
+crc64_ecma_refl_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) refl_multmodp(xk, crc1, CRC64_ECMA_REFL_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_ecma_refl_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_ecma_refl_combine_fast(crc1, crc2, crc64_ecma_refl_combine_precompute(len2));
+}
+
+#define CRC64_ECMA_NORM_POLY 0x42f0e1eba9ea3693ULL
+
+uint64_t
+crc64_ecma_norm_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) norm_x8nmodp(len2, CRC64_ECMA_NORM_POLY, 64);
+}
+
+uint64_t
+crc64_ecma_norm_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) norm_multmodp(xk, crc1, CRC64_ECMA_NORM_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_ecma_norm_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_ecma_norm_combine_fast(crc1, crc2, crc64_ecma_norm_combine_precompute(len2));
+}
+
+#define CRC64_ISO_REFL_POLY 0xd800000000000000ULL
+
+uint64_t
+crc64_iso_refl_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) refl_x8nmodp(len2, CRC64_ISO_REFL_POLY, 64);
+}
+
+uint64_t
+crc64_iso_refl_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) refl_multmodp(xk, crc1, CRC64_ISO_REFL_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_iso_refl_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_iso_refl_combine_fast(crc1, crc2, crc64_iso_refl_combine_precompute(len2));
+}
+
+#define CRC64_ISO_NORM_POLY 0x000000000000001bULL
+
+uint64_t
+crc64_iso_norm_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) norm_x8nmodp(len2, CRC64_ISO_NORM_POLY, 64);
+}
+
+uint64_t
+crc64_iso_norm_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) norm_multmodp(xk, crc1, CRC64_ISO_NORM_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_iso_norm_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_iso_norm_combine_fast(crc1, crc2, crc64_iso_norm_combine_precompute(len2));
+}
+
+#define CRC64_JONES_REFL_POLY 0x95ac9329ac4bc9b5ULL
+
+uint64_t
+crc64_jones_refl_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) refl_x8nmodp(len2, CRC64_JONES_REFL_POLY, 64);
+}
+
+uint64_t
+crc64_jones_refl_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) refl_multmodp(xk, crc1, CRC64_JONES_REFL_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_jones_refl_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_jones_refl_combine_fast(crc1, crc2, crc64_jones_refl_combine_precompute(len2));
+}
+
+#define CRC64_JONES_NORM_POLY 0xad93d23594c935a9ULL
+
+uint64_t
+crc64_jones_norm_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) norm_x8nmodp(len2, CRC64_JONES_NORM_POLY, 64);
+}
+
+uint64_t
+crc64_jones_norm_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) norm_multmodp(xk, crc1, CRC64_JONES_NORM_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_jones_norm_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_jones_norm_combine_fast(crc1, crc2, crc64_jones_norm_combine_precompute(len2));
+}
+
+#define CRC64_ROCKSOFT_REFL_POLY 0x9a6c9329ac4bc9b5ULL
+
+uint64_t
+crc64_rocksoft_refl_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) refl_x8nmodp(len2, CRC64_ROCKSOFT_REFL_POLY, 64);
+}
+
+uint64_t
+crc64_rocksoft_refl_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) refl_multmodp(xk, crc1, CRC64_ROCKSOFT_REFL_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_rocksoft_refl_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_rocksoft_refl_combine_fast(crc1, crc2,
+                                                crc64_rocksoft_refl_combine_precompute(len2));
+}
+
+#define CRC64_ROCKSOFT_NORM_POLY 0xad93d23594c93659ULL
+
+uint64_t
+crc64_rocksoft_norm_combine_precompute(uint64_t len2)
+{
+        return (uint64_t) norm_x8nmodp(len2, CRC64_ROCKSOFT_NORM_POLY, 64);
+}
+
+uint64_t
+crc64_rocksoft_norm_combine_fast(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return (uint64_t) norm_multmodp(xk, crc1, CRC64_ROCKSOFT_NORM_POLY, 64) ^ crc2;
+}
+
+uint64_t
+crc64_rocksoft_norm_combine(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc64_rocksoft_norm_combine_fast(crc1, crc2,
+                                                crc64_rocksoft_norm_combine_precompute(len2));
+}
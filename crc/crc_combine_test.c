@@ -0,0 +1,282 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "crc.h"
+#include "crc64.h"
+#include "test.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED 0x1234
+#endif
+
+#define MAX_BUF   (512 * 1024)
+#define TEST_LOOP 64
+#define NSHARDS   16
+
+typedef uint64_t (*crc_func_t)(uint64_t, const uint8_t *, uint64_t);
+typedef uint64_t (*combine_func_t)(uint64_t, uint64_t, uint64_t);
+typedef uint64_t (*precompute_func_t)(uint64_t);
+
+typedef struct func_case {
+        char *note;
+        crc_func_t crc_call;
+        combine_func_t combine_call;
+        precompute_func_t precompute_call;
+        combine_func_t combine_fast_call;
+} func_case_t;
+
+// Wrappers to give every CRC width a common 64-bit interface
+
+static uint64_t
+crc16_t10dif_wrap(uint64_t seed, const uint8_t *buf, uint64_t len)
+{
+        return crc16_t10dif((uint16_t) seed, buf, len);
+}
+
+static uint64_t
+crc16_t10dif_combine_wrap(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc16_t10dif_combine((uint16_t) crc1, (uint16_t) crc2, len2);
+}
+
+static uint64_t
+crc16_t10dif_combine_precompute_wrap(uint64_t len2)
+{
+        return crc16_t10dif_combine_precompute(len2);
+}
+
+static uint64_t
+crc16_t10dif_combine_fast_wrap(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return crc16_t10dif_combine_fast((uint16_t) crc1, (uint16_t) crc2, (uint16_t) xk);
+}
+
+static uint64_t
+crc32_ieee_wrap(uint64_t seed, const uint8_t *buf, uint64_t len)
+{
+        return crc32_ieee((uint32_t) seed, buf, len);
+}
+
+static uint64_t
+crc32_ieee_combine_wrap(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc32_ieee_combine((uint32_t) crc1, (uint32_t) crc2, len2);
+}
+
+static uint64_t
+crc32_ieee_combine_precompute_wrap(uint64_t len2)
+{
+        return crc32_ieee_combine_precompute(len2);
+}
+
+static uint64_t
+crc32_ieee_combine_fast_wrap(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return crc32_ieee_combine_fast((uint32_t) crc1, (uint32_t) crc2, (uint32_t) xk);
+}
+
+static uint64_t
+crc32_gzip_refl_wrap(uint64_t seed, const uint8_t *buf, uint64_t len)
+{
+        return crc32_gzip_refl((uint32_t) seed, buf, len);
+}
+
+static uint64_t
+crc32_gzip_refl_combine_wrap(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc32_gzip_refl_combine((uint32_t) crc1, (uint32_t) crc2, len2);
+}
+
+static uint64_t
+crc32_gzip_refl_combine_precompute_wrap(uint64_t len2)
+{
+        return crc32_gzip_refl_combine_precompute(len2);
+}
+
+static uint64_t
+crc32_gzip_refl_combine_fast_wrap(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return crc32_gzip_refl_combine_fast((uint32_t) crc1, (uint32_t) crc2, (uint32_t) xk);
+}
+
+static uint64_t
+crc32_iscsi_wrap(uint64_t seed, const uint8_t *buf, uint64_t len)
+{
+        return crc32_iscsi((unsigned char *) buf, (int) len, (unsigned int) seed);
+}
+
+static uint64_t
+crc32_iscsi_combine_wrap(uint64_t crc1, uint64_t crc2, uint64_t len2)
+{
+        return crc32_iscsi_combine((uint32_t) crc1, (uint32_t) crc2, len2);
+}
+
+static uint64_t
+crc32_iscsi_combine_precompute_wrap(uint64_t len2)
+{
+        return crc32_iscsi_combine_precompute(len2);
+}
+
+static uint64_t
+crc32_iscsi_combine_fast_wrap(uint64_t crc1, uint64_t crc2, uint64_t xk)
+{
+        return crc32_iscsi_combine_fast((uint32_t) crc1, (uint32_t) crc2, (uint32_t) xk);
+}
+
+func_case_t test_funcs[] = {
+        { "crc16_t10dif", crc16_t10dif_wrap, crc16_t10dif_combine_wrap,
+          crc16_t10dif_combine_precompute_wrap, crc16_t10dif_combine_fast_wrap },
+        { "crc32_ieee", crc32_ieee_wrap, crc32_ieee_combine_wrap,
+          crc32_ieee_combine_precompute_wrap, crc32_ieee_combine_fast_wrap },
+        { "crc32_gzip_refl", crc32_gzip_refl_wrap, crc32_gzip_refl_combine_wrap,
+          crc32_gzip_refl_combine_precompute_wrap, crc32_gzip_refl_combine_fast_wrap },
+        { "crc32_iscsi", crc32_iscsi_wrap, crc32_iscsi_combine_wrap,
+          crc32_iscsi_combine_precompute_wrap, crc32_iscsi_combine_fast_wrap },
+        { "crc64_ecma_refl", crc64_ecma_refl, crc64_ecma_refl_combine,
+          crc64_ecma_refl_combine_precompute, crc64_ecma_refl_combine_fast },
+        { "crc64_ecma_norm", crc64_ecma_norm, crc64_ecma_norm_combine,
+          crc64_ecma_norm_combine_precompute, crc64_ecma_norm_combine_fast },
+        { "crc64_iso_refl", crc64_iso_refl, crc64_iso_refl_combine,
+          crc64_iso_refl_combine_precompute, crc64_iso_refl_combine_fast },
+        { "crc64_iso_norm", crc64_iso_norm, crc64_iso_norm_combine,
+          crc64_iso_norm_combine_precompute, crc64_iso_norm_combine_fast },
+        { "crc64_jones_refl", crc64_jones_refl, crc64_jones_refl_combine,
+          crc64_jones_refl_combine_precompute, crc64_jones_refl_combine_fast },
+        { "crc64_jones_norm", crc64_jones_norm, crc64_jones_norm_combine,
+          crc64_jones_norm_combine_precompute, crc64_jones_norm_combine_fast },
+        { "crc64_rocksoft_refl", crc64_rocksoft_refl, crc64_rocksoft_refl_combine,
+          crc64_rocksoft_refl_combine_precompute, crc64_rocksoft_refl_combine_fast },
+        { "crc64_rocksoft_norm", crc64_rocksoft_norm, crc64_rocksoft_norm_combine,
+          crc64_rocksoft_norm_combine_precompute, crc64_rocksoft_norm_combine_fast }
+};
+
+// Generates pseudo-random data
+
+void
+rand_buffer(unsigned char *buf, long buffer_size)
+{
+        long i;
+        for (i = 0; i < buffer_size; i++)
+                buf[i] = rand();
+}
+
+// Split a buffer at random points and combine the two pieces
+int
+split_test(func_case_t *test_func, uint8_t *buf)
+{
+        uint64_t crc_ref, crc1, crc2, crc, crc_fast, seed;
+        uint64_t len, split;
+        int fail = 0;
+        int i;
+
+        for (i = 0; i < TEST_LOOP; i++) {
+                seed = ((uint64_t) rand() << 32) | rand();
+                len = rand() % (MAX_BUF + 1);
+                split = (i == 0) ? 0 : (i == 1) ? len : rand() % (len + 1);
+
+                crc_ref = test_func->crc_call(seed, buf, len);
+                crc1 = test_func->crc_call(seed, buf, split);
+                crc2 = test_func->crc_call(0, buf + split, len - split);
+                crc = test_func->combine_call(crc1, crc2, len - split);
+                crc_fast = test_func->combine_fast_call(
+                        crc1, crc2, test_func->precompute_call(len - split));
+
+                if (crc != crc_ref || crc_fast != crc_ref) {
+                        fail++;
+                        printf("\nfail %s len=%" PRIu64 " split=%" PRIu64 " 0x%" PRIx64
+                               " 0x%" PRIx64 " 0x%" PRIx64 "\n",
+                               test_func->note, len, split, crc_ref, crc, crc_fast);
+                }
+        }
+        return fail;
+}
+
+// Checksum equal sized shards independently and fold them with one constant
+int
+shard_test(func_case_t *test_func, uint8_t *buf)
+{
+        uint64_t crc_ref, crc, xk, seed;
+        uint64_t shard_len;
+        int fail = 0;
+        int i, j;
+
+        for (i = 0; i < TEST_LOOP / 8; i++) {
+                seed = rand();
+                shard_len = rand() % (MAX_BUF / NSHARDS + 1);
+                xk = test_func->precompute_call(shard_len);
+
+                crc_ref = test_func->crc_call(seed, buf, shard_len * NSHARDS);
+                crc = test_func->crc_call(seed, buf, shard_len);
+                for (j = 1; j < NSHARDS; j++)
+                        crc = test_func->combine_fast_call(
+                                crc, test_func->crc_call(0, buf + j * shard_len, shard_len), xk);
+
+                if (crc != crc_ref) {
+                        fail++;
+                        printf("\nfail %s shards of %" PRIu64 " 0x%" PRIx64 " 0x%" PRIx64 "\n",
+                               test_func->note, shard_len, crc_ref, crc);
+                }
+        }
+        return fail;
+}
+
+int
+main(int argc, char *argv[])
+{
+        int fail = 0, fail_case;
+        int i;
+        uint8_t *buf;
+
+        buf = malloc(MAX_BUF);
+        if (buf == NULL) {
+                printf("alloc error: Fail");
+                return -1;
+        }
+        srand(TEST_SEED);
+        rand_buffer(buf, MAX_BUF);
+        printf("CRC combine Tests\n");
+
+        for (i = 0; i < sizeof(test_funcs) / sizeof(test_funcs[0]); i++) {
+                printf("Test %s\t", test_funcs[i].note);
+                fail_case = split_test(&test_funcs[i], buf);
+                fail_case += shard_test(&test_funcs[i], buf);
+                printf(" done: %s\n", fail_case ? "Fail" : "Pass");
+                fail += fail_case;
+        }
+
+        printf("CRC combine Tests all done: %s\n", fail ? "Fail" : "Pass");
+        free(buf);
+
+        return fail;
+}
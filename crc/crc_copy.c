@@ -0,0 +1,134 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/*
+ * Copy with CRC for architectures with accelerated CRC kernels.
+ *
+ * The source is processed in blocks small enough to stay in the first level
+ * cache. Each block is read from memory once by the CRC kernel and then copied
+ * out of cache, so the data crosses the memory bus once for the read instead of
+ * twice as with a full CRC pass followed by a separate copy.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "crc.h"
+#include "crc64.h"
+
+#define CRC_COPY_BLOCK (16 * 1024)
+
+typedef uint64_t (*crc_copy_func_t)(uint64_t, const uint8_t *, uint64_t);
+
+static uint64_t
+crc_copy(crc_copy_func_t crc_func, uint64_t crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        while (len > 0) {
+                uint32_t n = len > CRC_COPY_BLOCK ? CRC_COPY_BLOCK : (uint32_t) len;
+
+                crc = crc_func(crc, src, n);
+                memcpy(dst, src, n);
+                src += n;
+                dst += n;
+                len -= n;
+        }
+        return crc;
+}
+
+/* 32-bit kernels in the shape of crc_copy_func_t, len is at most CRC_COPY_BLOCK */
+static uint64_t
+crc32_iscsi_block(uint64_t crc, const uint8_t *buf, uint64_t len)
+{
+        return crc32_iscsi((unsigned char *) buf, (int) len, (uint32_t) crc);
+}
+
+static uint64_t
+crc32_gzip_refl_block(uint64_t crc, const uint8_t *buf, uint64_t len)
+{
+        return crc32_gzip_refl((uint32_t) crc, buf, len);
+}
+
+uint32_t
+crc32_iscsi_copy(uint32_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return (uint32_t) crc_copy(crc32_iscsi_block, init_crc, dst, src, len);
+}
+
+uint32_t
+crc32_gzip_refl_copy(uint32_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return (uint32_t) crc_copy(crc32_gzip_refl_block, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_ecma_refl_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_ecma_refl, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_ecma_norm_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_ecma_norm, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_iso_refl_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_iso_refl, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_iso_norm_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_iso_norm, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_jones_refl_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_jones_refl, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_jones_norm_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_jones_norm, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_rocksoft_refl_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_rocksoft_refl, init_crc, dst, src, len);
+}
+
+uint64_t
+crc64_rocksoft_norm_copy(uint64_t init_crc, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc_copy(crc64_rocksoft_norm, init_crc, dst, src, len);
+}
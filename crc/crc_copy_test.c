@@ -0,0 +1,246 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "crc.h"
+#include "crc64.h"
+#include "test.h"
+
+#ifndef RANDOMS
+#define RANDOMS 20
+#endif
+#ifndef TEST_SEED
+#define TEST_SEED 0x1234
+#endif
+
+#define MAX_BUF   2345
+#define TEST_SIZE 217
+#define TEST_LEN  (40 * 1024)
+
+typedef uint64_t (*crc_func_t)(uint64_t, const uint8_t *, uint64_t);
+typedef uint64_t (*crc_copy_func_t)(uint64_t, uint8_t *, uint8_t *, uint64_t);
+
+typedef struct func_case {
+        char *note;
+        crc_copy_func_t crc_copy_call;
+        crc_copy_func_t crc_copy_base_call;
+        crc_func_t crc_call;
+} func_case_t;
+
+// Wrappers to give the 32-bit CRCs a common 64-bit interface
+
+static uint64_t
+crc32_iscsi_wrap(uint64_t seed, const uint8_t *buf, uint64_t len)
+{
+        return crc32_iscsi((uint8_t *) buf, (int) len, (unsigned int) seed);
+}
+
+static uint64_t
+crc32_iscsi_copy_wrap(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc32_iscsi_copy((uint32_t) seed, dst, src, len);
+}
+
+static uint64_t
+crc32_iscsi_copy_base_wrap(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc32_iscsi_copy_base((uint32_t) seed, dst, src, len);
+}
+
+static uint64_t
+crc32_gzip_refl_wrap(uint64_t seed, const uint8_t *buf, uint64_t len)
+{
+        return crc32_gzip_refl((uint32_t) seed, buf, len);
+}
+
+static uint64_t
+crc32_gzip_refl_copy_wrap(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc32_gzip_refl_copy((uint32_t) seed, dst, src, len);
+}
+
+static uint64_t
+crc32_gzip_refl_copy_base_wrap(uint64_t seed, uint8_t *dst, uint8_t *src, uint64_t len)
+{
+        return crc32_gzip_refl_copy_base((uint32_t) seed, dst, src, len);
+}
+
+func_case_t test_funcs[] = {
+        { "crc32_iscsi_copy", crc32_iscsi_copy_wrap, crc32_iscsi_copy_base_wrap,
+          crc32_iscsi_wrap },
+        { "crc32_gzip_refl_copy", crc32_gzip_refl_copy_wrap, crc32_gzip_refl_copy_base_wrap,
+          crc32_gzip_refl_wrap },
+        { "crc64_ecma_refl_copy", crc64_ecma_refl_copy, crc64_ecma_refl_copy_base,
+          crc64_ecma_refl },
+        { "crc64_ecma_norm_copy", crc64_ecma_norm_copy, crc64_ecma_norm_copy_base,
+          crc64_ecma_norm },
+        { "crc64_iso_refl_copy", crc64_iso_refl_copy, crc64_iso_refl_copy_base, crc64_iso_refl },
+        { "crc64_iso_norm_copy", crc64_iso_norm_copy, crc64_iso_norm_copy_base, crc64_iso_norm },
+        { "crc64_jones_refl_copy", crc64_jones_refl_copy, crc64_jones_refl_copy_base,
+          crc64_jones_refl },
+        { "crc64_jones_norm_copy", crc64_jones_norm_copy, crc64_jones_norm_copy_base,
+          crc64_jones_norm },
+        { "crc64_rocksoft_refl_copy", crc64_rocksoft_refl_copy, crc64_rocksoft_refl_copy_base,
+          crc64_rocksoft_refl },
+        { "crc64_rocksoft_norm_copy", crc64_rocksoft_norm_copy, crc64_rocksoft_norm_copy_base,
+          crc64_rocksoft_norm }
+};
+
+void
+rand_buffer(unsigned char *buf, long buffer_size)
+{
+        long i;
+        for (i = 0; i < buffer_size; i++)
+                buf[i] = rand();
+}
+
+int
+memtst(unsigned char *buf, unsigned char c, int len)
+{
+        int i;
+        for (i = 0; i < len; i++)
+                if (*buf++ != c)
+                        return 1;
+
+        return 0;
+}
+
+int
+crc_copy_check(func_case_t *test_func, const char *description, uint8_t *dst, uint8_t *src,
+               uint8_t dst_fill_val, int len, int tot)
+{
+        uint64_t seed, crc_dut, crc_ref;
+        int rem = tot - len;
+        int base;
+
+        seed = ((uint64_t) rand() << 32) | rand();
+        crc_ref = test_func->crc_call(seed, src, len);
+
+        for (base = 0; base < 2; base++) {
+                memset(dst, dst_fill_val, tot);
+                if (base)
+                        crc_dut = test_func->crc_copy_base_call(seed, dst, src, len);
+                else
+                        crc_dut = test_func->crc_copy_call(seed, dst, src, len);
+
+                if (crc_dut != crc_ref) {
+                        printf("%s%s %s, crc gen fail: 0x%llx 0x%llx len=%d\n", test_func->note,
+                               base ? "_base" : "", description, (unsigned long long) crc_dut,
+                               (unsigned long long) crc_ref, len);
+                        return 1;
+                } else if (memcmp(dst, src, len)) {
+                        printf("%s%s %s, copy fail: len=%d\n", test_func->note,
+                               base ? "_base" : "", description, len);
+                        return 1;
+                } else if (memtst(&dst[len], dst_fill_val, rem)) {
+                        printf("%s%s %s, writeover fail: len=%d\n", test_func->note,
+                               base ? "_base" : "", description, len);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+int
+copy_test(func_case_t *test_func, uint8_t *src_raw, uint8_t *dst_raw)
+{
+        int r = 0;
+        int i;
+        int len, tot;
+        uint8_t *src = src_raw, *dst = dst_raw;
+
+        // Test of all zeros
+        memset(src, 0, TEST_LEN);
+        r |= crc_copy_check(test_func, "zero tst", dst, src, 0x5e, MAX_BUF, TEST_LEN);
+
+        // Another simple test pattern
+        memset(src, 0xff, TEST_LEN);
+        r |= crc_copy_check(test_func, "simp tst", dst, src, 0x5e, MAX_BUF, TEST_LEN);
+
+        // Do a few short len random data tests
+        rand_buffer(src, TEST_LEN);
+        rand_buffer(dst, TEST_LEN);
+        for (i = 0; i < MAX_BUF; i++)
+                r |= crc_copy_check(test_func, "short len", dst, src, rand(), i, MAX_BUF);
+
+        // Do a few longer tests, crossing the internal block size
+        for (i = TEST_LEN; i >= (TEST_LEN - TEST_SIZE); i--)
+                r |= crc_copy_check(test_func, "long len", dst, src, rand(), i, TEST_LEN);
+
+        // Do random size, random data
+        for (i = 0; i < RANDOMS; i++) {
+                len = rand() % TEST_LEN;
+                r |= crc_copy_check(test_func, "rand len", dst, src, rand(), len, TEST_LEN);
+        }
+
+        // Run tests at end of buffer
+        for (i = 0; i < RANDOMS; i++) {
+                len = rand() % TEST_LEN;
+                src = &src_raw[TEST_LEN - len - 1];
+                dst = &dst_raw[TEST_LEN - len - 1];
+                tot = len;
+                r |= crc_copy_check(test_func, "end of buffer", dst, src, rand(), len, tot);
+        }
+
+        return r;
+}
+
+int
+main(int argc, char *argv[])
+{
+        int r = 0, fail;
+        int i;
+        uint8_t *src_raw = NULL, *dst_raw = NULL;
+
+        printf("Test crc_copy_test:\n");
+        src_raw = (uint8_t *) malloc(TEST_LEN);
+        dst_raw = (uint8_t *) malloc(TEST_LEN);
+        if (NULL == src_raw || NULL == dst_raw) {
+                printf("alloc error: Fail");
+                return -1;
+        }
+
+        srand(TEST_SEED);
+
+        for (i = 0; i < sizeof(test_funcs) / sizeof(test_funcs[0]); i++) {
+                fail = copy_test(&test_funcs[i], src_raw, dst_raw);
+                printf("Test %s\t done: %s\n", test_funcs[i].note, fail ? "Fail" : "Pass");
+                r |= fail;
+        }
+
+        printf("Test done: %s\n", r ? "Fail" : "Pass");
+
+        free(src_raw);
+        free(dst_raw);
+
+        return r;
+}
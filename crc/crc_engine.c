@@ -0,0 +1,377 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/*
+ * Runtime parameterized CRC
+ *
+ * Any CRC of width 8 to 64 bits is run as a 64-bit CRC: normal (MSB first)
+ * CRCs are kept left aligned in a 64-bit register and reflected (LSB first)
+ * CRCs right aligned, the bit reverse of the same thing, which lets every width
+ * share the same code.
+ *
+ * Long buffers are folded 64 bytes at a time with carry-less multiply where the
+ * CPU has it, using constants of x^n mod P derived from the polynomial at init.
+ * The folded 16-byte remainder and short buffers go through slice-by-8 tables,
+ * also derived at init, which are the whole implementation elsewhere.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "crc.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define CRC_ENGINE_CLMUL
+#define CLMUL_TARGET __attribute__((target("pclmul,ssse3")))
+
+typedef __m128i v128;
+
+static int
+clmul_available(void)
+{
+        unsigned int a, b, c, d;
+
+        if (!__get_cpuid(1, &a, &b, &c, &d))
+                return 0;
+        return (c & bit_PCLMUL) && (c & bit_SSSE3);
+}
+
+CLMUL_TARGET static inline v128
+v_load(const uint8_t *p)
+{
+        return _mm_loadu_si128((const __m128i *) p);
+}
+
+CLMUL_TARGET static inline void
+v_store(uint8_t *p, v128 v)
+{
+        _mm_storeu_si128((__m128i *) p, v);
+}
+
+CLMUL_TARGET static inline v128
+v_set(uint64_t hi, uint64_t lo)
+{
+        return _mm_set_epi64x(hi, lo);
+}
+
+CLMUL_TARGET static inline v128
+v_bswap(v128 v)
+{
+        return _mm_shuffle_epi8(v, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+                                                14, 15));
+}
+
+CLMUL_TARGET static inline v128
+v_xor(v128 a, v128 b)
+{
+        return _mm_xor_si128(a, b);
+}
+
+// a.lo * k.lo ^ a.hi * k.hi ^ d
+CLMUL_TARGET static inline v128
+v_fold(v128 a, v128 k, v128 d)
+{
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(a, k, 0x00),
+                                           _mm_clmulepi64_si128(a, k, 0x11)),
+                             d);
+}
+
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#include <arm_neon.h>
+#define CRC_ENGINE_CLMUL
+#define CLMUL_TARGET
+
+typedef uint64x2_t v128;
+
+static int
+clmul_available(void)
+{
+        return 1;
+}
+
+static inline v128
+v_load(const uint8_t *p)
+{
+        return vreinterpretq_u64_u8(vld1q_u8(p));
+}
+
+static inline void
+v_store(uint8_t *p, v128 v)
+{
+        vst1q_u8(p, vreinterpretq_u8_u64(v));
+}
+
+static inline v128
+v_set(uint64_t hi, uint64_t lo)
+{
+        return vcombine_u64(vcreate_u64(lo), vcreate_u64(hi));
+}
+
+static inline v128
+v_bswap(v128 v)
+{
+        v128 r = vreinterpretq_u64_u8(vrev64q_u8(vreinterpretq_u8_u64(v)));
+
+        return vextq_u64(r, r, 1);
+}
+
+static inline v128
+v_xor(v128 a, v128 b)
+{
+        return veorq_u64(a, b);
+}
+
+// a.lo * k.lo ^ a.hi * k.hi ^ d
+static inline v128
+v_fold(v128 a, v128 k, v128 d)
+{
+        poly128_t l = vmull_p64((poly64_t) vgetq_lane_u64(a, 0), (poly64_t) vgetq_lane_u64(k, 0));
+        poly128_t h = vmull_high_p64(vreinterpretq_p64_u64(a), vreinterpretq_p64_u64(k));
+
+        return veorq_u64(veorq_u64(vreinterpretq_u64_p128(l), vreinterpretq_u64_p128(h)), d);
+}
+#endif
+
+// Folding is only worth it past a few blocks
+#define CRC_ENGINE_FOLD_MIN 128
+
+static uint64_t
+reflect_bits(uint64_t v, int width)
+{
+        uint64_t r = 0;
+        int i;
+
+        for (i = 0; i < width; i++) {
+                r = (r << 1) | (v & 1);
+                v >>= 1;
+        }
+        return r;
+}
+
+static inline uint64_t
+load_le64(const uint8_t *p)
+{
+        uint64_t v = 0;
+        int i;
+
+        for (i = 7; i >= 0; i--)
+                v = (v << 8) | p[i];
+        return v;
+}
+
+static inline uint64_t
+load_be64(const uint8_t *p)
+{
+        uint64_t v = 0;
+        int i;
+
+        for (i = 0; i < 8; i++)
+                v = (v << 8) | p[i];
+        return v;
+}
+
+// x^n mod P for n >= 64, left aligned in the normal domain
+static uint64_t
+xpow_mod(int n, uint64_t p)
+{
+        uint64_t r = p;
+
+        for (n -= 64; n > 0; n--)
+                r = (r >> 63) ? (r << 1) ^ p : r << 1;
+        return r;
+}
+
+/*
+ * A 16-byte lane A is moved d bits along with A.hi * x^(d+64) + A.lo * x^d.
+ * Reflected lanes hold A bit reversed, where the reverse of a 64 by 64-bit
+ * product comes out one bit short, so their constants are taken one power
+ * lower and bit reversed, and the halves swap.
+ */
+static void
+fold_consts(uint64_t p, int reflected, int d, uint64_t *k)
+{
+        if (reflected) {
+                k[0] = reflect_bits(xpow_mod(d + 63, p), 64);
+                k[1] = reflect_bits(xpow_mod(d - 1, p), 64);
+        } else {
+                k[0] = xpow_mod(d, p);
+                k[1] = xpow_mod(d + 64, p);
+        }
+}
+
+int
+crc_engine_init(uint64_t poly, int width, int reflected, struct crc_engine *ctx)
+{
+        uint64_t r, p;
+        int i, j, k;
+
+        if (ctx == NULL || width < 8 || width > 64)
+                return -1;
+
+        if (width < 64)
+                poly &= (1ULL << width) - 1;
+
+        ctx->poly = poly;
+        ctx->width = width;
+        ctx->reflected = reflected ? 1 : 0;
+
+        fold_consts(poly << (64 - width), ctx->reflected, 512, &ctx->fold[0]);
+        fold_consts(poly << (64 - width), ctx->reflected, 128, &ctx->fold[2]);
+#ifdef CRC_ENGINE_CLMUL
+        ctx->clmul = clmul_available();
+#else
+        ctx->clmul = 0;
+#endif
+
+        if (ctx->reflected) {
+                p = reflect_bits(poly, width);
+                for (i = 0; i < 256; i++) {
+                        r = i;
+                        for (j = 0; j < 8; j++)
+                                r = (r & 1) ? (r >> 1) ^ p : r >> 1;
+                        ctx->table[0][i] = r;
+                }
+                for (k = 1; k < 8; k++)
+                        for (i = 0; i < 256; i++) {
+                                r = ctx->table[k - 1][i];
+                                ctx->table[k][i] = (r >> 8) ^ ctx->table[0][r & 0xff];
+                        }
+        } else {
+                p = poly << (64 - width);
+                for (i = 0; i < 256; i++) {
+                        r = (uint64_t) i << 56;
+                        for (j = 0; j < 8; j++)
+                                r = (r >> 63) ? (r << 1) ^ p : r << 1;
+                        ctx->table[0][i] = r;
+                }
+                for (k = 1; k < 8; k++)
+                        for (i = 0; i < 256; i++) {
+                                r = ctx->table[k - 1][i];
+                                ctx->table[k][i] = (r << 8) ^ ctx->table[0][r >> 56];
+                        }
+        }
+
+        return 0;
+}
+
+// Table update of the 64-bit register, right aligned if reflected, else left aligned
+static uint64_t
+table_update(const struct crc_engine *ctx, uint64_t c, const uint8_t *buf, uint64_t len)
+{
+        const uint64_t(*t)[256] = ctx->table;
+
+        if (ctx->reflected) {
+                for (; len >= 8; len -= 8, buf += 8) {
+                        c ^= load_le64(buf);
+                        c = t[7][c & 0xff] ^ t[6][(c >> 8) & 0xff] ^ t[5][(c >> 16) & 0xff] ^
+                            t[4][(c >> 24) & 0xff] ^ t[3][(c >> 32) & 0xff] ^
+                            t[2][(c >> 40) & 0xff] ^ t[1][(c >> 48) & 0xff] ^ t[0][c >> 56];
+                }
+                while (len--)
+                        c = (c >> 8) ^ t[0][(c ^ *buf++) & 0xff];
+
+                return c;
+        }
+
+        for (; len >= 8; len -= 8, buf += 8) {
+                c ^= load_be64(buf);
+                c = t[7][c >> 56] ^ t[6][(c >> 48) & 0xff] ^ t[5][(c >> 40) & 0xff] ^
+                    t[4][(c >> 32) & 0xff] ^ t[3][(c >> 24) & 0xff] ^ t[2][(c >> 16) & 0xff] ^
+                    t[1][(c >> 8) & 0xff] ^ t[0][c & 0xff];
+        }
+        while (len--)
+                c = (c << 8) ^ t[0][(c >> 56) ^ *buf++];
+
+        return c;
+}
+
+#ifdef CRC_ENGINE_CLMUL
+/*
+ * Fold whole 16-byte blocks of at least 64 bytes into one 16-byte lane whose
+ * CRC from zero is the CRC of the blocks from c, then finish with the tables.
+ * Normal lanes are byte swapped so the first byte is the most significant.
+ */
+CLMUL_TARGET static uint64_t
+fold_update(const struct crc_engine *ctx, uint64_t c, const uint8_t *buf, uint64_t len)
+{
+        const int refl = ctx->reflected;
+        const v128 k512 = v_set(ctx->fold[1], ctx->fold[0]);
+        const v128 k128 = v_set(ctx->fold[3], ctx->fold[2]);
+        v128 a0, a1, a2, a3;
+        uint8_t rem[16];
+
+#define LANE(p) (refl ? v_load(p) : v_bswap(v_load(p)))
+        a0 = v_xor(LANE(buf), refl ? v_set(0, c) : v_set(c, 0));
+        a1 = LANE(buf + 16);
+        a2 = LANE(buf + 32);
+        a3 = LANE(buf + 48);
+
+        for (buf += 64, len -= 64; len >= 64; buf += 64, len -= 64) {
+                a0 = v_fold(a0, k512, LANE(buf));
+                a1 = v_fold(a1, k512, LANE(buf + 16));
+                a2 = v_fold(a2, k512, LANE(buf + 32));
+                a3 = v_fold(a3, k512, LANE(buf + 48));
+        }
+
+        a1 = v_fold(a0, k128, a1);
+        a2 = v_fold(a1, k128, a2);
+        a3 = v_fold(a2, k128, a3);
+
+        for (; len >= 16; buf += 16, len -= 16)
+                a3 = v_fold(a3, k128, LANE(buf));
+#undef LANE
+
+        v_store(rem, refl ? a3 : v_bswap(a3));
+        c = table_update(ctx, 0, rem, sizeof(rem));
+
+        return table_update(ctx, c, buf, len);
+}
+#endif
+
+uint64_t
+crc_engine_update(const struct crc_engine *ctx, uint64_t crc, const uint8_t *buf, uint64_t len)
+{
+        const int shift = 64 - ctx->width;
+        uint64_t c;
+
+        if (ctx->reflected)
+                c = (shift > 0) ? crc & ((1ULL << ctx->width) - 1) : crc;
+        else
+                c = crc << shift;
+
+#ifdef CRC_ENGINE_CLMUL
+        if (ctx->clmul && len >= CRC_ENGINE_FOLD_MIN)
+                c = fold_update(ctx, c, buf, len);
+        else
+#endif
+                c = table_update(ctx, c, buf, len);
+
+        return ctx->reflected ? c : c >> shift;
+}
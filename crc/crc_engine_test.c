@@ -0,0 +1,232 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include "crc.h"
+#include "crc64.h"
+#include "test.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED 0x1234
+#endif
+
+#define MAX_BUF   4096
+#define TEST_LOOP 200
+
+// CRC models with the standard check value of "123456789"
+struct crc_model {
+        const char *name;
+        int width;
+        uint64_t poly;
+        int reflected;
+        uint64_t init;
+        uint64_t xorout;
+        uint64_t check;
+};
+
+static const struct crc_model models[] = {
+        { "CRC-8/SMBUS", 8, 0x07, 0, 0x00, 0x00, 0xf4 },
+        { "CRC-8/MAXIM-DOW", 8, 0x31, 1, 0x00, 0x00, 0xa1 },
+        { "CRC-10/ATM", 10, 0x233, 0, 0x000, 0x000, 0x199 },
+        { "CRC-16/IBM-3740", 16, 0x1021, 0, 0xffff, 0x0000, 0x29b1 },
+        { "CRC-16/KERMIT", 16, 0x1021, 1, 0x0000, 0x0000, 0x2189 },
+        { "CRC-16/T10-DIF", 16, 0x8bb7, 0, 0x0000, 0x0000, 0xd0db },
+        { "CRC-24/OPENPGP", 24, 0x864cfb, 0, 0xb704ce, 0x000000, 0x21cf02 },
+        { "CRC-32/ISO-HDLC", 32, 0x04c11db7, 1, 0xffffffff, 0xffffffff, 0xcbf43926 },
+        { "CRC-32/ISCSI", 32, 0x1edc6f41, 1, 0xffffffff, 0xffffffff, 0xe3069283 },
+        { "CRC-32/BZIP2", 32, 0x04c11db7, 0, 0xffffffff, 0xffffffff, 0xfc891918 },
+        { "CRC-40/GSM", 40, 0x0004820009ULL, 0, 0, 0xffffffffffULL, 0xd4164fc646ULL },
+        { "CRC-64/ECMA-182", 64, 0x42f0e1eba9ea3693ULL, 0, 0, 0, 0x6c40df5f0b497347ULL },
+        { "CRC-64/XZ", 64, 0x42f0e1eba9ea3693ULL, 1, ~0ULL, ~0ULL, 0x995dc9bbdf1939faULL },
+};
+
+static uint64_t
+width_mask(int width)
+{
+        return width == 64 ? ~0ULL : (1ULL << width) - 1;
+}
+
+static uint64_t
+model_crc(const struct crc_engine *ctx, const struct crc_model *m, const uint8_t *buf, uint64_t len)
+{
+        uint64_t crc = crc_engine_update(ctx, m->init, buf, len);
+
+        return (crc ^ m->xorout) & width_mask(m->width);
+}
+
+// Known check values, whole and split at every position
+int
+check_test(void)
+{
+        const uint8_t check_str[] = "123456789";
+        struct crc_engine ctx;
+        uint64_t crc;
+        int i, s, fail = 0;
+
+        for (i = 0; i < sizeof(models) / sizeof(models[0]); i++) {
+                const struct crc_model *m = &models[i];
+
+                if (crc_engine_init(m->poly, m->width, m->reflected, &ctx) != 0) {
+                        printf("fail init %s\n", m->name);
+                        fail++;
+                        continue;
+                }
+                crc = model_crc(&ctx, m, check_str, 9);
+                if (crc != m->check) {
+                        printf("fail %s: 0x%" PRIx64 " expected 0x%" PRIx64 "\n", m->name, crc,
+                               m->check);
+                        fail++;
+                }
+                for (s = 0; s <= 9; s++) {
+                        crc = crc_engine_update(&ctx, m->init, check_str, s);
+                        crc = crc_engine_update(&ctx, crc, check_str + s, 9 - s);
+                        crc = (crc ^ m->xorout) & width_mask(m->width);
+                        if (crc != m->check) {
+                                printf("fail %s split %d: 0x%" PRIx64 " expected 0x%" PRIx64 "\n",
+                                       m->name, s, crc, m->check);
+                                fail++;
+                        }
+                }
+        }
+        return fail;
+}
+
+// Long buffers in one call against the same data a few bytes at a time
+int
+long_test(uint8_t *buf)
+{
+        struct crc_engine ctx;
+        uint64_t len, pos, step, crc, ref;
+        int i, j, fail = 0;
+
+        for (i = 0; i < sizeof(models) / sizeof(models[0]); i++) {
+                const struct crc_model *m = &models[i];
+
+                crc_engine_init(m->poly, m->width, m->reflected, &ctx);
+                for (j = 0; j < TEST_LOOP / 10; j++) {
+                        len = rand() % (MAX_BUF + 1);
+
+                        ref = m->init;
+                        for (pos = 0; pos < len; pos += step) {
+                                step = 1 + rand() % 15;
+                                if (step > len - pos)
+                                        step = len - pos;
+                                ref = crc_engine_update(&ctx, ref, buf + pos, step);
+                        }
+                        ref = (ref ^ m->xorout) & width_mask(m->width);
+                        crc = model_crc(&ctx, m, buf, len);
+                        if (crc != ref) {
+                                printf("fail %s len=%" PRIu64 ": 0x%" PRIx64 " expected 0x%" PRIx64
+                                       "\n",
+                                       m->name, len, crc, ref);
+                                fail++;
+                                break;
+                        }
+                }
+        }
+        return fail;
+}
+
+// Random data against the built in CRC functions
+int
+builtin_test(uint8_t *buf)
+{
+        struct crc_engine t10dif, gzip, iscsi, ecma_refl, jones_norm;
+        uint64_t len, seed;
+        int i, fail = 0;
+
+        crc_engine_init(0x8bb7, 16, 0, &t10dif);
+        crc_engine_init(0x04c11db7, 32, 1, &gzip);
+        crc_engine_init(0x1edc6f41, 32, 1, &iscsi);
+        crc_engine_init(0x42f0e1eba9ea3693ULL, 64, 1, &ecma_refl);
+        crc_engine_init(0xad93d23594c935a9ULL, 64, 0, &jones_norm);
+
+        for (i = 0; i < TEST_LOOP; i++) {
+                len = rand() % (MAX_BUF + 1);
+                seed = ((uint64_t) rand() << 32) ^ rand();
+
+                if (crc_engine_update(&t10dif, seed & 0xffff, buf, len) !=
+                    crc16_t10dif((uint16_t) seed, buf, len))
+                        fail++;
+                if ((crc_engine_update(&gzip, ~seed & 0xffffffff, buf, len) ^ 0xffffffff) !=
+                    crc32_gzip_refl((uint32_t) seed, buf, len))
+                        fail++;
+                if (crc_engine_update(&iscsi, seed & 0xffffffff, buf, len) !=
+                    crc32_iscsi(buf, (int) len, (uint32_t) seed))
+                        fail++;
+                if (~crc_engine_update(&ecma_refl, ~seed, buf, len) !=
+                    crc64_ecma_refl(seed, buf, len))
+                        fail++;
+                if (~crc_engine_update(&jones_norm, ~seed, buf, len) !=
+                    crc64_jones_norm(seed, buf, len))
+                        fail++;
+                if (fail) {
+                        printf("fail builtin compare len=%" PRIu64 "\n", len);
+                        break;
+                }
+        }
+        return fail;
+}
+
+int
+main(int argc, char *argv[])
+{
+        struct crc_engine ctx;
+        int fail = 0;
+        uint8_t *buf;
+        int i;
+
+        buf = malloc(MAX_BUF);
+        if (buf == NULL) {
+                printf("alloc error: Fail");
+                return -1;
+        }
+        srand(TEST_SEED);
+        for (i = 0; i < MAX_BUF; i++)
+                buf[i] = rand();
+
+        printf("CRC engine Tests\n");
+
+        if (crc_engine_init(0x07, 7, 0, &ctx) == 0 || crc_engine_init(0x07, 65, 0, &ctx) == 0) {
+                printf("fail width check\n");
+                fail++;
+        }
+        fail += check_test();
+        fail += long_test(buf);
+        fail += builtin_test(buf);
+
+        printf("CRC engine Tests all done: %s\n", fail ? "Fail" : "Pass");
+        free(buf);
+
+        return fail;
+}
@@ -94,6 +94,11 @@ static const size_t CRC64_TYPES_LEN = 8;
 #define COLD_CACHE_TEST_MEM (1024 * 1024 * 1024)
 #define COLD_CACHE_MIN_LEN  (1024)
 
+#define MAX_MB_COUNT 4096
+
+// Number of buffers per batch for the multi-buffer API, 0 runs single buffer functions
+static size_t mb_count = 0;
+
 // Define function pointer types for CRC functions with standard parameter format (seed, buffer,
 // len)
 typedef uint32_t (*crc32_func_t)(uint32_t seed, const uint8_t *buf, uint64_t len);
@@ -237,6 +242,96 @@ run_standard_crc_benchmark(struct perf *start, const crc_func_info_t *func_info,
         }
 }
 
+// Helper function to run benchmark for multi-buffer CRC functions on a batch of mb_count buffers
+// laid out back to back. Returns 0 if the CRC type has no multi-buffer version.
+static int
+run_mb_crc_benchmark(const uint8_t *buffer, const size_t len, const crc_type_t type,
+                     const int run_base_version, const int csv_output)
+{
+        struct perf start;
+        const char *function_suffix = run_base_version ? "_base" : "";
+        const char *crc_type_str;
+        unsigned char **bufs;
+        uint64_t *lens;
+        uint64_t *crcs64;
+        uint32_t *crcs32;
+        uint16_t *crcs16;
+        const uint32_t n = (uint32_t) mb_count;
+
+        if (type != CRC32_ISCSI && type != CRC16_T10DIF && type != CRC64_ROCKSOFT_REFL)
+                return 0;
+
+        bufs = (unsigned char **) malloc(n * sizeof(unsigned char *));
+        lens = (uint64_t *) malloc(n * sizeof(uint64_t));
+        crcs64 = (uint64_t *) calloc(n, sizeof(uint64_t));
+        crcs32 = (uint32_t *) calloc(n, sizeof(uint32_t));
+        crcs16 = (uint16_t *) calloc(n, sizeof(uint16_t));
+        if (!bufs || !lens || !crcs64 || !crcs32 || !crcs16) {
+                printf("Failed to allocate multi-buffer arrays\n");
+                goto exit;
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+                bufs[i] = (unsigned char *) buffer + i * len;
+                lens[i] = len;
+        }
+
+        perf_init(&start);
+        switch (type) {
+        case CRC32_ISCSI:
+                crc_type_str = "crc32_iscsi_mb";
+                if (run_base_version)
+                        BENCHMARK(&start, BENCHMARK_TIME,
+                                  crc32_iscsi_mb_base(n, bufs, lens, crcs32));
+                else
+                        BENCHMARK(&start, BENCHMARK_TIME, crc32_iscsi_mb(n, bufs, lens, crcs32));
+                break;
+        case CRC16_T10DIF:
+                crc_type_str = "crc16_t10dif_mb";
+                if (run_base_version)
+                        BENCHMARK(&start, BENCHMARK_TIME,
+                                  crc16_t10dif_mb_base(n, bufs, lens, crcs16));
+                else
+                        BENCHMARK(&start, BENCHMARK_TIME, crc16_t10dif_mb(n, bufs, lens, crcs16));
+                break;
+        default:
+                crc_type_str = "crc64_rocksoft_refl_mb";
+                if (run_base_version)
+                        BENCHMARK(&start, BENCHMARK_TIME,
+                                  crc64_rocksoft_refl_mb_base(n, bufs, lens, crcs64));
+                else
+                        BENCHMARK(&start, BENCHMARK_TIME,
+                                  crc64_rocksoft_refl_mb(n, bufs, lens, crcs64));
+                break;
+        }
+
+        if (csv_output) {
+#ifdef USE_RDTSC
+                // When USE_RDTSC is defined, report cycles per buffer in the batch
+                double cycles = (double) (long long) get_base_elapsed(&start);
+                double cycles_per_buffer = cycles / ((double) start.iterations * n);
+                printf("%s%s,%zu,%.0f\n", crc_type_str, function_suffix, len, cycles_per_buffer);
+#else
+                // Calculate throughput in MB/s over the whole batch
+                double time_elapsed = get_time_elapsed(&start);
+                long long total_units = start.iterations * (long long) len * n;
+                double throughput = ((double) total_units) / (1000000 * time_elapsed);
+                printf("%s%s,%zu,%.2f\n", crc_type_str, function_suffix, len, throughput);
+#endif
+        } else {
+                printf("%s%s x%u : ", crc_type_str, function_suffix, n);
+                perf_print(start, (double) len * n);
+        }
+
+exit:
+        free(bufs);
+        free(lens);
+        free(crcs64);
+        free(crcs32);
+        free(crcs16);
+        return 1;
+}
+
 // Function to run a specific CRC benchmark
 static void
 run_benchmark(const void *buf, const size_t len, const crc_type_t type, const int run_base_version,
@@ -252,6 +347,10 @@ run_benchmark(const void *buf, const size_t len, const crc_type_t type, const in
         uint8_t **buffer_list = NULL;
         size_t num_buffers = 0;
 
+        // Multi-buffer mode replaces the functions that have a batch version
+        if (mb_count && run_mb_crc_benchmark(buffer, len, type, run_base_version, csv_output))
+                return;
+
         // Create list of random buffer address within the large memory space already allocated for
         // cold cache tests
         if (use_cold_cache) {
@@ -382,6 +481,9 @@ print_help(void)
         printf("  -c, --csv           Output results in CSV format\n");
         printf("      --cold          Use cold cache for benchmarks (buffer not in cache, "
                "t10dif_copy not supported)\n");
+        printf("  -m, --mb COUNT      Benchmark the multi-buffer API on batches of COUNT buffers\n");
+        printf("                      (iscsi, t10dif and rocksoft_refl only)\n");
+        printf("                      Example: --mb 256 --range=512:*2:8K\n");
 }
 
 // Helper function to parse string input for CRC type
@@ -755,6 +857,19 @@ main(const int argc, char *const argv[])
                         printf("Cold cache option enabled\n");
                 }
 
+                // Multi-buffer option
+                else if (strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--mb") == 0) {
+                        if (i + 1 < argc && argv[i + 1][0] != '-') {
+                                i++; // Move to the argument
+                                mb_count = strtoul(argv[i], NULL, 10);
+                        }
+                        if (mb_count == 0 || mb_count > MAX_MB_COUNT) {
+                                printf("Option --mb requires a buffer count from 1 to %d.\n",
+                                       MAX_MB_COUNT);
+                                return 1;
+                        }
+                }
+
                 // Type option
                 else if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--type") == 0)) {
                         if (i + 1 < argc && argv[i + 1][0] != '-') {
@@ -948,6 +1063,8 @@ main(const int argc, char *const argv[])
 
         if (use_cold_cache)
                 test_len = COLD_CACHE_TEST_MEM;
+        else if (mb_count)
+                test_len *= mb_count;
 
         if (posix_memalign(&buf, 64, test_len)) {
                 printf("alloc error: Fail\n");
@@ -0,0 +1,166 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/*
+ * Multi-buffer CRC for architectures with accelerated single buffer kernels.
+ *
+ * Where the CPU has a CRC32C instruction, crc32_iscsi batches run
+ * CRC_MB_LANES buffers in lockstep over their common length, one instruction
+ * per lane per 8 bytes, which hides the instruction latency that a single
+ * short buffer cannot. Lane tails and the other CRCs go to the dispatched
+ * kernels one buffer at a time: their carry-less multiply folding already
+ * overlaps several streams within a buffer and runs far ahead of the table
+ * lockstep versions in crc_base.c, which serve the architectures without such
+ * kernels.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "crc.h"
+#include "crc64.h"
+
+#define CRC_MB_LANES 4
+
+// crc32_iscsi() takes an int length so longer buffers go in pieces
+#define CRC_MB_MAX_CALL (1 << 30)
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define CRC_MB_CRC32C
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+
+static inline int
+crc32c_available(void)
+{
+        return __builtin_cpu_supports("sse4.2");
+}
+
+CRC32C_TARGET static inline uint32_t
+crc32c_u64(uint32_t crc, uint64_t v)
+{
+        return (uint32_t) _mm_crc32_u64(crc, v);
+}
+
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define CRC_MB_CRC32C
+#define CRC32C_TARGET
+
+static inline int
+crc32c_available(void)
+{
+        return 1;
+}
+
+static inline uint32_t
+crc32c_u64(uint32_t crc, uint64_t v)
+{
+        return __crc32cd(crc, v);
+}
+#endif
+
+static uint32_t
+crc32_iscsi_long(unsigned char *buf, uint64_t len, uint32_t crc)
+{
+        for (; len > CRC_MB_MAX_CALL; buf += CRC_MB_MAX_CALL, len -= CRC_MB_MAX_CALL)
+                crc = crc32_iscsi(buf, CRC_MB_MAX_CALL, crc);
+        return crc32_iscsi(buf, (int) len, crc);
+}
+
+#ifdef CRC_MB_CRC32C
+static inline uint64_t
+load_u64(const unsigned char *p)
+{
+        uint64_t v;
+
+        memcpy(&v, p, sizeof(v));
+        return v;
+}
+
+CRC32C_TARGET static void
+crc32_iscsi_lanes(unsigned char *const *bufs, const uint64_t *lens, uint32_t *crcs)
+{
+        const unsigned char *p0 = bufs[0], *p1 = bufs[1], *p2 = bufs[2], *p3 = bufs[3];
+        uint32_t c0 = crcs[0], c1 = crcs[1], c2 = crcs[2], c3 = crcs[3];
+        uint64_t j, common = lens[0];
+        int k;
+
+        for (k = 1; k < CRC_MB_LANES; k++)
+                if (lens[k] < common)
+                        common = lens[k];
+        common &= ~(uint64_t) 7;
+
+        for (j = 0; j < common; j += 8) {
+                c0 = crc32c_u64(c0, load_u64(p0 + j));
+                c1 = crc32c_u64(c1, load_u64(p1 + j));
+                c2 = crc32c_u64(c2, load_u64(p2 + j));
+                c3 = crc32c_u64(c3, load_u64(p3 + j));
+        }
+        crcs[0] = c0;
+        crcs[1] = c1;
+        crcs[2] = c2;
+        crcs[3] = c3;
+
+        for (k = 0; k < CRC_MB_LANES; k++)
+                crcs[k] = crc32_iscsi_long(bufs[k] + common, lens[k] - common, crcs[k]);
+}
+#endif
+
+void
+crc32_iscsi_mb(uint32_t n, unsigned char *const *bufs, const uint64_t *lens, uint32_t *crcs)
+{
+        uint32_t i = 0;
+
+#ifdef CRC_MB_CRC32C
+        if (crc32c_available())
+                for (; i + CRC_MB_LANES <= n; i += CRC_MB_LANES)
+                        crc32_iscsi_lanes(&bufs[i], &lens[i], &crcs[i]);
+#endif
+        for (; i < n; i++)
+                crcs[i] = crc32_iscsi_long(bufs[i], lens[i], crcs[i]);
+}
+
+void
+crc16_t10dif_mb(uint32_t n, unsigned char *const *bufs, const uint64_t *lens, uint16_t *crcs)
+{
+        uint32_t i;
+
+        for (i = 0; i < n; i++)
+                crcs[i] = crc16_t10dif(crcs[i], bufs[i], lens[i]);
+}
+
+void
+crc64_rocksoft_refl_mb(uint32_t n, unsigned char *const *bufs, const uint64_t *lens,
+                       uint64_t *crcs)
+{
+        uint32_t i;
+
+        for (i = 0; i < n; i++)
+                crcs[i] = crc64_rocksoft_refl(crcs[i], bufs[i], lens[i]);
+}
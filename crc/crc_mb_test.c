@@ -0,0 +1,128 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "crc.h"
+#include "crc64.h"
+#include "test.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED 0x1234
+#endif
+
+#define MAX_BUFS  37
+#define MAX_LEN   (8 * 1024)
+#define TEST_LOOP 64
+
+// Generates pseudo-random data
+
+void
+rand_buffer(unsigned char *buf, long buffer_size)
+{
+        long i;
+        for (i = 0; i < buffer_size; i++)
+                buf[i] = rand();
+}
+
+int
+main(int argc, char *argv[])
+{
+        unsigned char *bufs[MAX_BUFS];
+        uint64_t lens[MAX_BUFS];
+        uint32_t crc32_mb[MAX_BUFS], crc32_mb_base[MAX_BUFS], crc32_ref[MAX_BUFS];
+        uint16_t crc16_mb[MAX_BUFS], crc16_mb_base[MAX_BUFS], crc16_ref[MAX_BUFS];
+        uint64_t crc64_mb[MAX_BUFS], crc64_mb_base[MAX_BUFS], crc64_ref[MAX_BUFS];
+        unsigned char *data;
+        uint32_t i, n;
+        int t, fail = 0;
+
+        data = malloc(MAX_BUFS * MAX_LEN);
+        if (data == NULL) {
+                printf("alloc error: Fail");
+                return -1;
+        }
+        srand(TEST_SEED);
+        rand_buffer(data, MAX_BUFS * MAX_LEN);
+        printf("CRC multi-buffer Tests\n");
+
+        for (t = 0; t < TEST_LOOP; t++) {
+                n = rand() % (MAX_BUFS + 1);
+                for (i = 0; i < n; i++) {
+                        // Mostly equal sector sized buffers with some odd ones
+                        lens[i] = (t & 1) ? rand() % (MAX_LEN + 1) : 512 << (t % 5);
+                        bufs[i] = data + (uint64_t) i * MAX_LEN + (rand() % 16) * (t & 2);
+                        if (bufs[i] + lens[i] > data + (uint64_t) (i + 1) * MAX_LEN)
+                                lens[i] = data + (uint64_t) (i + 1) * MAX_LEN - bufs[i];
+
+                        crc32_mb[i] = crc32_mb_base[i] = rand();
+                        crc16_mb[i] = crc16_mb_base[i] = rand();
+                        crc64_mb[i] = crc64_mb_base[i] = ((uint64_t) rand() << 32) | rand();
+
+                        crc32_ref[i] = crc32_iscsi(bufs[i], (int) lens[i], crc32_mb[i]);
+                        crc16_ref[i] = crc16_t10dif(crc16_mb[i], bufs[i], lens[i]);
+                        crc64_ref[i] = crc64_rocksoft_refl(crc64_mb[i], bufs[i], lens[i]);
+                }
+
+                crc32_iscsi_mb(n, bufs, lens, crc32_mb);
+                crc32_iscsi_mb_base(n, bufs, lens, crc32_mb_base);
+                crc16_t10dif_mb(n, bufs, lens, crc16_mb);
+                crc16_t10dif_mb_base(n, bufs, lens, crc16_mb_base);
+                crc64_rocksoft_refl_mb(n, bufs, lens, crc64_mb);
+                crc64_rocksoft_refl_mb_base(n, bufs, lens, crc64_mb_base);
+
+                for (i = 0; i < n; i++) {
+                        if (crc32_mb[i] != crc32_ref[i] || crc32_mb_base[i] != crc32_ref[i]) {
+                                fail++;
+                                printf("fail crc32_iscsi_mb buf %u of %u len=%lu\n", i, n,
+                                       (unsigned long) lens[i]);
+                        }
+                        if (crc16_mb[i] != crc16_ref[i] || crc16_mb_base[i] != crc16_ref[i]) {
+                                fail++;
+                                printf("fail crc16_t10dif_mb buf %u of %u len=%lu\n", i, n,
+                                       (unsigned long) lens[i]);
+                        }
+                        if (crc64_mb[i] != crc64_ref[i] || crc64_mb_base[i] != crc64_ref[i]) {
+                                fail++;
+                                printf("fail crc64_rocksoft_refl_mb buf %u of %u len=%lu\n", i, n,
+                                       (unsigned long) lens[i]);
+                        }
+                }
+#ifdef TEST_VERBOSE
+                printf(".");
+#endif
+        }
+
+        printf("CRC multi-buffer Tests all done: %s\n", fail ? "Fail" : "Pass");
+        free(data);
+
+        return fail;
+}
@@ -0,0 +1,260 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "crc.h"
+#include "crc64.h"
+#include "crc_pi.h"
+
+/*
+ * Guards are computed for a batch of blocks at a time through the multi-buffer
+ * CRC functions, then the tuples are written or checked.
+ */
+#define PI_BATCH 64
+
+#define APP_TAG_ESCAPE 0xffff
+
+struct pi_layout {
+        uint32_t tuple_size;
+        uint32_t tuple_offset; // offset of the tuple in the metadata of a block
+        uint32_t md_guarded;   // metadata bytes before the tuple covered by the guard
+        uint64_t data_stride;  // distance between data blocks
+        uint64_t md_stride;    // distance between metadata of blocks
+};
+
+static inline void
+store_be(uint8_t *p, uint64_t v, int bytes)
+{
+        while (bytes--) {
+                p[bytes] = (uint8_t) v;
+                v >>= 8;
+        }
+}
+
+static inline uint64_t
+load_be(const uint8_t *p, int bytes)
+{
+        uint64_t v = 0;
+        int i;
+
+        for (i = 0; i < bytes; i++)
+                v = (v << 8) | p[i];
+        return v;
+}
+
+static int
+pi_get_layout(const struct isal_pi_format *fmt, const uint8_t *data, const uint8_t *md,
+              struct pi_layout *l)
+{
+        if (fmt == NULL || data == NULL || fmt->block_size == 0)
+                return ISAL_PI_INVALID_FORMAT;
+
+        switch (fmt->guard_type) {
+        case ISAL_PI_GUARD_16:
+                l->tuple_size = ISAL_PI_16_TUPLE_SIZE;
+                break;
+        case ISAL_PI_GUARD_64:
+                l->tuple_size = ISAL_PI_64_TUPLE_SIZE;
+                break;
+        default:
+                return ISAL_PI_INVALID_FORMAT;
+        }
+
+        if (fmt->md_size < l->tuple_size)
+                return ISAL_PI_INVALID_FORMAT;
+
+        l->tuple_offset = fmt->pi_last ? fmt->md_size - l->tuple_size : 0;
+        l->md_guarded = l->tuple_offset;
+
+        switch (fmt->layout) {
+        case ISAL_PI_DIF:
+                l->data_stride = (uint64_t) fmt->block_size + fmt->md_size;
+                l->md_stride = l->data_stride;
+                break;
+        case ISAL_PI_DIX:
+                if (md == NULL)
+                        return ISAL_PI_INVALID_FORMAT;
+                l->data_stride = fmt->block_size;
+                l->md_stride = fmt->md_size;
+                break;
+        default:
+                return ISAL_PI_INVALID_FORMAT;
+        }
+        return 0;
+}
+
+static inline const uint8_t *
+pi_block_md(const struct isal_pi_format *fmt, const struct pi_layout *l, const uint8_t *data,
+            const uint8_t *md, uint32_t i)
+{
+        if (fmt->layout == ISAL_PI_DIF)
+                return data + i * l->data_stride + fmt->block_size;
+        return md + i * l->md_stride;
+}
+
+/*
+ * Compute the guards of blocks [first, first + n) into guard[]. For DIF the
+ * guarded metadata directly follows the data and is covered in the same pass.
+ */
+static void
+pi_guards(const struct isal_pi_format *fmt, const struct pi_layout *l, const uint8_t *data,
+          const uint8_t *md, uint32_t first, uint32_t n, uint64_t *guard)
+{
+        unsigned char *bufs[PI_BATCH];
+        uint64_t lens[PI_BATCH];
+        uint16_t crc16[PI_BATCH];
+        uint32_t i;
+        int dif = fmt->layout == ISAL_PI_DIF;
+
+        for (i = 0; i < n; i++) {
+                bufs[i] = (unsigned char *) data + (uint64_t) (first + i) * l->data_stride;
+                lens[i] = fmt->block_size + (dif ? l->md_guarded : 0);
+        }
+
+        if (fmt->guard_type == ISAL_PI_GUARD_16) {
+                memset(crc16, 0, sizeof(crc16));
+                crc16_t10dif_mb(n, bufs, lens, crc16);
+                for (i = 0; i < n; i++)
+                        guard[i] = crc16[i];
+        } else {
+                memset(guard, 0, n * sizeof(guard[0]));
+                crc64_rocksoft_refl_mb(n, bufs, lens, guard);
+        }
+
+        if (dif || l->md_guarded == 0)
+                return;
+
+        for (i = 0; i < n; i++) {
+                const uint8_t *m = md + (uint64_t) (first + i) * l->md_stride;
+
+                if (fmt->guard_type == ISAL_PI_GUARD_16)
+                        guard[i] = crc16_t10dif((uint16_t) guard[i], m, l->md_guarded);
+                else
+                        guard[i] = crc64_rocksoft_refl(guard[i], m, l->md_guarded);
+        }
+}
+
+int
+isal_pi_generate(const struct isal_pi_format *fmt, uint8_t *data, uint8_t *md, uint32_t nblocks,
+                 uint64_t ref_tag, uint16_t app_tag)
+{
+        struct pi_layout l;
+        uint64_t guard[PI_BATCH];
+        uint32_t b, i, n;
+        int ret;
+
+        ret = pi_get_layout(fmt, data, md, &l);
+        if (ret)
+                return ret;
+
+        for (b = 0; b < nblocks; b += n) {
+                n = (nblocks - b) < PI_BATCH ? nblocks - b : PI_BATCH;
+                pi_guards(fmt, &l, data, md, b, n, guard);
+
+                for (i = 0; i < n; i++) {
+                        uint8_t *t = (uint8_t *) pi_block_md(fmt, &l, data, md, b + i) +
+                                     l.tuple_offset;
+                        uint64_t ref = ref_tag + b + i;
+
+                        if (fmt->guard_type == ISAL_PI_GUARD_16) {
+                                store_be(t, guard[i], 2);
+                                store_be(t + 2, app_tag, 2);
+                                store_be(t + 4, ref, 4);
+                        } else {
+                                store_be(t, guard[i], 8);
+                                store_be(t + 8, app_tag, 2);
+                                store_be(t + 10, ref, 6);
+                        }
+                }
+        }
+        return 0;
+}
+
+int
+isal_pi_verify(const struct isal_pi_format *fmt, const uint8_t *data, const uint8_t *md,
+               uint32_t nblocks, uint64_t ref_tag, uint16_t app_tag, uint16_t app_mask,
+               uint64_t *fail_map)
+{
+        struct pi_layout l;
+        uint64_t guard[PI_BATCH];
+        uint32_t b, i, n;
+        int ret, fails = 0;
+
+        ret = pi_get_layout(fmt, data, md, &l);
+        if (ret)
+                return ret;
+
+        if (fail_map != NULL)
+                memset(fail_map, 0, ((nblocks + 63) / 64) * sizeof(uint64_t));
+
+        for (b = 0; b < nblocks; b += n) {
+                n = (nblocks - b) < PI_BATCH ? nblocks - b : PI_BATCH;
+                if (fmt->check & ISAL_PI_CHECK_GUARD)
+                        pi_guards(fmt, &l, data, md, b, n, guard);
+
+                for (i = 0; i < n; i++) {
+                        const uint8_t *t = pi_block_md(fmt, &l, data, md, b + i) + l.tuple_offset;
+                        uint64_t ref = ref_tag + b + i;
+                        uint64_t t_guard, t_ref;
+                        uint16_t t_app;
+                        int bad = 0;
+
+                        if (fmt->guard_type == ISAL_PI_GUARD_16) {
+                                t_guard = load_be(t, 2);
+                                t_app = (uint16_t) load_be(t + 2, 2);
+                                t_ref = load_be(t + 4, 4);
+                                ref &= 0xffffffff;
+                        } else {
+                                t_guard = load_be(t, 8);
+                                t_app = (uint16_t) load_be(t + 8, 2);
+                                t_ref = load_be(t + 10, 6);
+                                ref &= 0xffffffffffffULL;
+                        }
+
+                        if (t_app == APP_TAG_ESCAPE)
+                                continue;
+
+                        if ((fmt->check & ISAL_PI_CHECK_GUARD) && t_guard != guard[i])
+                                bad = 1;
+                        if ((fmt->check & ISAL_PI_CHECK_APP) &&
+                            ((t_app ^ app_tag) & app_mask) != 0)
+                                bad = 1;
+                        if ((fmt->check & ISAL_PI_CHECK_REF) && t_ref != ref)
+                                bad = 1;
+
+                        if (bad) {
+                                fails++;
+                                if (fail_map != NULL)
+                                        fail_map[(b + i) / 64] |= 1ULL << ((b + i) % 64);
+                        }
+                }
+        }
+        return fails;
+}
@@ -0,0 +1,269 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "crc.h"
+#include "crc64.h"
+#include "crc_pi.h"
+#include "test.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED 0x1234
+#endif
+
+#define MAX_BLOCKS 130
+#define MAX_MD     64
+#define MAP_WORDS  ((MAX_BLOCKS + 63) / 64)
+
+// Generates pseudo-random data
+
+void
+rand_buffer(unsigned char *buf, long buffer_size)
+{
+        long i;
+        for (i = 0; i < buffer_size; i++)
+                buf[i] = rand();
+}
+
+static uint8_t *
+block_md(const struct isal_pi_format *fmt, uint8_t *data, uint8_t *md, uint32_t i)
+{
+        if (fmt->layout == ISAL_PI_DIF)
+                return data + (uint64_t) i * (fmt->block_size + fmt->md_size) + fmt->block_size;
+        return md + (uint64_t) i * fmt->md_size;
+}
+
+static uint8_t *
+block_data(const struct isal_pi_format *fmt, uint8_t *data, uint32_t i)
+{
+        uint32_t stride = fmt->block_size + (fmt->layout == ISAL_PI_DIF ? fmt->md_size : 0);
+
+        return data + (uint64_t) i * stride;
+}
+
+// Check the tuple of a block against a guard computed directly
+static int
+check_tuple(const struct isal_pi_format *fmt, uint8_t *data, uint8_t *md, uint32_t i,
+            uint64_t ref_tag, uint16_t app_tag)
+{
+        uint32_t tuple = fmt->guard_type == ISAL_PI_GUARD_16 ? ISAL_PI_16_TUPLE_SIZE
+                                                             : ISAL_PI_64_TUPLE_SIZE;
+        uint32_t prefix = fmt->pi_last ? fmt->md_size - tuple : 0;
+        uint8_t *m = block_md(fmt, data, md, i);
+        uint8_t *t = m + prefix;
+        uint8_t *d = block_data(fmt, data, i);
+        uint64_t guard = 0, ref = 0;
+        uint16_t app;
+        int j;
+
+        if (fmt->guard_type == ISAL_PI_GUARD_16) {
+                uint16_t g = crc16_t10dif(0, d, fmt->block_size);
+
+                g = crc16_t10dif(g, m, prefix);
+                for (j = 0; j < 2; j++)
+                        guard = (guard << 8) | t[j];
+                app = (t[2] << 8) | t[3];
+                for (j = 4; j < 8; j++)
+                        ref = (ref << 8) | t[j];
+                return guard != g || app != app_tag || ref != ((ref_tag + i) & 0xffffffff);
+        } else {
+                uint64_t g = crc64_rocksoft_refl(0, d, fmt->block_size);
+
+                g = crc64_rocksoft_refl(g, m, prefix);
+                for (j = 0; j < 8; j++)
+                        guard = (guard << 8) | t[j];
+                app = (t[8] << 8) | t[9];
+                for (j = 10; j < 16; j++)
+                        ref = (ref << 8) | t[j];
+                return guard != g || app != app_tag || ref != ((ref_tag + i) & 0xffffffffffffULL);
+        }
+}
+
+static int
+test_format(struct isal_pi_format *fmt, uint8_t *data, uint8_t *md, uint32_t nblocks)
+{
+        uint64_t map[MAP_WORDS];
+        uint64_t ref_tag = ((uint64_t) rand() << 32) | rand();
+        uint16_t app_tag = rand() & 0x7fff;
+        uint32_t tuple = fmt->guard_type == ISAL_PI_GUARD_16 ? ISAL_PI_16_TUPLE_SIZE
+                                                             : ISAL_PI_64_TUPLE_SIZE;
+        uint32_t i, bad = rand() % nblocks;
+        uint8_t *t, *d, save;
+        int ret, fail = 0;
+
+        fmt->check = ISAL_PI_CHECK_ALL;
+        if (isal_pi_generate(fmt, data, md, nblocks, ref_tag, app_tag) != 0) {
+                printf("fail generate\n");
+                return 1;
+        }
+
+        for (i = 0; i < nblocks; i++)
+                if (check_tuple(fmt, data, md, i, ref_tag, app_tag)) {
+                        printf("fail tuple of block %u\n", i);
+                        fail++;
+                }
+
+        ret = isal_pi_verify(fmt, data, md, nblocks, ref_tag, app_tag, 0xffff, map);
+        if (ret != 0 || map[0] != 0) {
+                printf("fail verify of generated blocks ret=%d\n", ret);
+                fail++;
+        }
+
+        // Corrupt data of one block
+        d = block_data(fmt, data, bad) + rand() % fmt->block_size;
+        save = *d;
+        *d ^= 1 << (rand() % 8);
+        ret = isal_pi_verify(fmt, data, md, nblocks, ref_tag, app_tag, 0xffff, map);
+        if (ret != 1 || !(map[bad / 64] & (1ULL << (bad % 64)))) {
+                printf("fail detect data error in block %u ret=%d\n", bad, ret);
+                fail++;
+        }
+
+        // Guard check disabled
+        fmt->check = ISAL_PI_CHECK_APP | ISAL_PI_CHECK_REF;
+        if (isal_pi_verify(fmt, data, md, nblocks, ref_tag, app_tag, 0xffff, NULL) != 0) {
+                printf("fail verify without guard check\n");
+                fail++;
+        }
+        fmt->check = ISAL_PI_CHECK_ALL;
+        *d = save;
+
+        // Corrupt guarded metadata ahead of the tuple
+        if (fmt->pi_last && fmt->md_size > tuple) {
+                d = block_md(fmt, data, md, bad);
+                *d ^= 0x80;
+                ret = isal_pi_verify(fmt, data, md, nblocks, ref_tag, app_tag, 0xffff, map);
+                if (ret != 1 || !(map[bad / 64] & (1ULL << (bad % 64)))) {
+                        printf("fail detect metadata error in block %u ret=%d\n", bad, ret);
+                        fail++;
+                }
+                *d ^= 0x80;
+        }
+
+        // Wrong expected reference tag fails every block
+        ret = isal_pi_verify(fmt, data, md, nblocks, ref_tag + 1, app_tag, 0xffff, map);
+        if (ret != (int) nblocks) {
+                printf("fail detect ref tag error ret=%d\n", ret);
+                fail++;
+        }
+
+        // Application tag is compared under the mask
+        ret = isal_pi_verify(fmt, data, md, nblocks, ref_tag, app_tag ^ 0x100, 0xfeff, map);
+        if (ret != 0) {
+                printf("fail app tag mask ret=%d\n", ret);
+                fail++;
+        }
+        ret = isal_pi_verify(fmt, data, md, nblocks, ref_tag, app_tag ^ 0x100, 0xffff, map);
+        if (ret != (int) nblocks) {
+                printf("fail detect app tag error ret=%d\n", ret);
+                fail++;
+        }
+
+        // Escape application tag skips the block
+        t = block_md(fmt, data, md, bad) + (fmt->pi_last ? fmt->md_size - tuple : 0);
+        t += fmt->guard_type == ISAL_PI_GUARD_16 ? 2 : 8;
+        t[0] = t[1] = 0xff;
+        d = block_data(fmt, data, bad);
+        *d ^= 1;
+        ret = isal_pi_verify(fmt, data, md, nblocks, ref_tag, app_tag, 0xffff, map);
+        if (ret != 0) {
+                printf("fail escape app tag ret=%d\n", ret);
+                fail++;
+        }
+        *d ^= 1;
+
+        return fail;
+}
+
+int
+main(int argc, char *argv[])
+{
+        struct isal_pi_format fmt;
+        uint32_t block_sizes[] = { 512, 4096 };
+        uint32_t md_sizes[] = { 8, 16, 64 };
+        uint8_t *data, *md;
+        uint32_t c, nblocks;
+        uint64_t map[MAP_WORDS];
+        int fail = 0;
+
+        data = malloc((uint64_t) MAX_BLOCKS * (4096 + MAX_MD));
+        md = malloc((uint64_t) MAX_BLOCKS * MAX_MD);
+        if (data == NULL || md == NULL) {
+                printf("alloc error: Fail");
+                return -1;
+        }
+        srand(TEST_SEED);
+        printf("CRC protection information Tests\n");
+
+        for (c = 0; c < 2 * 3 * 2 * 2 * 2; c++) {
+                fmt.block_size = block_sizes[c % 2];
+                fmt.md_size = md_sizes[(c / 2) % 3];
+                fmt.guard_type = (c / 6) % 2 ? ISAL_PI_GUARD_64 : ISAL_PI_GUARD_16;
+                fmt.layout = (c / 12) % 2 ? ISAL_PI_DIX : ISAL_PI_DIF;
+                fmt.pi_last = (c / 24) % 2;
+                if (fmt.guard_type == ISAL_PI_GUARD_64 && fmt.md_size < ISAL_PI_64_TUPLE_SIZE)
+                        continue;
+
+                rand_buffer(data, (long) MAX_BLOCKS * (4096 + MAX_MD));
+                rand_buffer(md, (long) MAX_BLOCKS * MAX_MD);
+                nblocks = 1 + rand() % MAX_BLOCKS;
+                fail += test_format(&fmt, data, md, nblocks);
+#ifdef TEST_VERBOSE
+                printf(".");
+#endif
+        }
+
+        // Invalid formats
+        fmt.block_size = 512;
+        fmt.md_size = 8;
+        fmt.guard_type = ISAL_PI_GUARD_64;
+        fmt.layout = ISAL_PI_DIF;
+        fmt.pi_last = 0;
+        fmt.check = ISAL_PI_CHECK_ALL;
+        if (isal_pi_generate(&fmt, data, md, 1, 0, 0) != ISAL_PI_INVALID_FORMAT ||
+            isal_pi_verify(&fmt, data, md, 1, 0, 0, 0xffff, map) != ISAL_PI_INVALID_FORMAT) {
+                printf("fail invalid md size\n");
+                fail++;
+        }
+        fmt.guard_type = ISAL_PI_GUARD_16;
+        fmt.layout = ISAL_PI_DIX;
+        if (isal_pi_generate(&fmt, data, NULL, 1, 0, 0) != ISAL_PI_INVALID_FORMAT) {
+                printf("fail invalid DIX metadata\n");
+                fail++;
+        }
+
+        printf("CRC protection information Tests all done: %s\n", fail ? "Fail" : "Pass");
+        free(data);
+        free(md);
+
+        return fail;
+}
@@ -0,0 +1,421 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_THREADS
+#include <pthread.h>
+#endif
+
+#include "erasure_code.h"
+
+#define EC_DECODE_MAX_FRAGS 255
+#define EC_DECODE_TBL_ALIGN 64
+
+struct ec_decode_entry {
+        struct ec_decode_entry *prev;  /* LRU list, head is most recently used */
+        struct ec_decode_entry *next;
+        struct ec_decode_entry *hnext; /* Hash bucket chain */
+        uint32_t hash;
+        int refs;   /* Callers currently decoding with the tables */
+        int cached; /* Entry is owned by the cache */
+        int nerrs;
+        unsigned char erasures[EC_DECODE_MAX_FRAGS];
+        unsigned char decode_index[EC_DECODE_MAX_FRAGS];
+        unsigned char *gftbls; /* 32 * k * nerrs from ec_init_tables(), after the entry */
+};
+
+struct ec_decode_cache {
+        int k;
+        int m;
+        int entries;
+        int count;
+        unsigned char *encode_matrix;
+        struct ec_decode_entry **buckets;
+        uint32_t bucket_mask;
+        struct ec_decode_entry *head;
+        struct ec_decode_entry *tail;
+#ifdef HAVE_THREADS
+        pthread_mutex_t mutex;
+#endif
+};
+
+int
+ec_gen_decode_matrix(int k, int m, unsigned char *encode_matrix,
+                     const unsigned char *erasure_list, int nerrs, unsigned char *decode_matrix,
+                     unsigned char *decode_index)
+{
+        unsigned char frag_in_err[EC_DECODE_MAX_FRAGS];
+        unsigned char *b, *invert_matrix, s;
+        int i, j, p, r, ret = -1;
+
+        if (k < 1 || m <= k || m > EC_DECODE_MAX_FRAGS || nerrs < 1 || nerrs > m - k)
+                return -1;
+
+        memset(frag_in_err, 0, sizeof(frag_in_err));
+        for (i = 0; i < nerrs; i++) {
+                if (erasure_list[i] >= m || frag_in_err[erasure_list[i]])
+                        return -1;
+                frag_in_err[erasure_list[i]] = 1;
+        }
+
+        b = malloc(2 * k * k);
+        if (b == NULL)
+                return -1;
+        invert_matrix = b + k * k;
+
+        // Construct b from the encode rows of the first k surviving fragments
+        for (i = 0, r = 0; i < k; i++, r++) {
+                while (frag_in_err[r])
+                        r++;
+                memcpy(&b[k * i], &encode_matrix[k * r], k);
+                decode_index[i] = r;
+        }
+
+        if (gf_invert_matrix(b, invert_matrix, k) < 0)
+                goto out;
+
+        for (p = 0; p < nerrs; p++) {
+                if (erasure_list[p] < k) {
+                        // A source is a row of the inverse
+                        memcpy(&decode_matrix[k * p], &invert_matrix[k * erasure_list[p]], k);
+                } else {
+                        // A parity is its encode row times the inverse
+                        for (i = 0; i < k; i++) {
+                                s = 0;
+                                for (j = 0; j < k; j++)
+                                        s ^= gf_mul(invert_matrix[j * k + i],
+                                                    encode_matrix[k * erasure_list[p] + j]);
+                                decode_matrix[k * p + i] = s;
+                        }
+                }
+        }
+        ret = 0;
+out:
+        free(b);
+        return ret;
+}
+
+static void
+cache_lock(struct ec_decode_cache *cache)
+{
+#ifdef HAVE_THREADS
+        pthread_mutex_lock(&cache->mutex);
+#endif
+}
+
+static void
+cache_unlock(struct ec_decode_cache *cache)
+{
+#ifdef HAVE_THREADS
+        pthread_mutex_unlock(&cache->mutex);
+#endif
+}
+
+static uint32_t
+erasure_hash(const unsigned char *erasure_list, int nerrs)
+{
+        uint32_t h = 2166136261u; // FNV-1a
+        int i;
+
+        for (i = 0; i < nerrs; i++)
+                h = (h ^ erasure_list[i]) * 16777619u;
+        return h;
+}
+
+static void
+lru_unlink(struct ec_decode_cache *cache, struct ec_decode_entry *e)
+{
+        if (e->prev != NULL)
+                e->prev->next = e->next;
+        else
+                cache->head = e->next;
+        if (e->next != NULL)
+                e->next->prev = e->prev;
+        else
+                cache->tail = e->prev;
+}
+
+static void
+lru_push_head(struct ec_decode_cache *cache, struct ec_decode_entry *e)
+{
+        e->prev = NULL;
+        e->next = cache->head;
+        if (cache->head != NULL)
+                cache->head->prev = e;
+        else
+                cache->tail = e;
+        cache->head = e;
+}
+
+static struct ec_decode_entry *
+cache_find(struct ec_decode_cache *cache, uint32_t hash, const unsigned char *erasure_list,
+           int nerrs)
+{
+        struct ec_decode_entry *e;
+
+        for (e = cache->buckets[hash & cache->bucket_mask]; e != NULL; e = e->hnext)
+                if (e->hash == hash && e->nerrs == nerrs &&
+                    memcmp(e->erasures, erasure_list, nerrs) == 0)
+                        return e;
+        return NULL;
+}
+
+static void
+cache_remove(struct ec_decode_cache *cache, struct ec_decode_entry *e)
+{
+        struct ec_decode_entry **pp = &cache->buckets[e->hash & cache->bucket_mask];
+
+        while (*pp != e)
+                pp = &(*pp)->hnext;
+        *pp = e->hnext;
+        lru_unlink(cache, e);
+        cache->count--;
+}
+
+/* Make room for one entry, evicting the least recently used idle one */
+static int
+cache_make_room(struct ec_decode_cache *cache)
+{
+        struct ec_decode_entry *e;
+
+        if (cache->count < cache->entries)
+                return 1;
+
+        for (e = cache->tail; e != NULL; e = e->prev)
+                if (e->refs == 0) {
+                        cache_remove(cache, e);
+                        free(e);
+                        return 1;
+                }
+        return 0;
+}
+
+static struct ec_decode_entry *
+entry_build(struct ec_decode_cache *cache, uint32_t hash, const unsigned char *erasure_list,
+            int nerrs)
+{
+        struct ec_decode_entry *e;
+        unsigned char *decode_matrix;
+        int k = cache->k;
+
+        e = malloc(sizeof(*e) + EC_DECODE_TBL_ALIGN + 32 * k * nerrs);
+        decode_matrix = malloc(k * nerrs);
+        if (e == NULL || decode_matrix == NULL)
+                goto fail;
+        e->gftbls = (unsigned char *) (((uintptr_t) (e + 1) + EC_DECODE_TBL_ALIGN - 1) &
+                                       ~(uintptr_t) (EC_DECODE_TBL_ALIGN - 1));
+
+        if (ec_gen_decode_matrix(k, cache->m, cache->encode_matrix, erasure_list, nerrs,
+                                 decode_matrix, e->decode_index) != 0)
+                goto fail;
+
+        ec_init_tables(k, nerrs, decode_matrix, e->gftbls);
+        free(decode_matrix);
+
+        memcpy(e->erasures, erasure_list, nerrs);
+        e->nerrs = nerrs;
+        e->hash = hash;
+        e->refs = 1;
+        e->cached = 0;
+        return e;
+fail:
+        free(decode_matrix);
+        free(e);
+        return NULL;
+}
+
+static struct ec_decode_entry *
+cache_get(struct ec_decode_cache *cache, const unsigned char *erasure_list, int nerrs)
+{
+        struct ec_decode_entry *e, *built;
+        uint32_t hash = erasure_hash(erasure_list, nerrs);
+
+        cache_lock(cache);
+        e = cache_find(cache, hash, erasure_list, nerrs);
+        if (e != NULL) {
+                e->refs++;
+                lru_unlink(cache, e);
+                lru_push_head(cache, e);
+        }
+        cache_unlock(cache);
+        if (e != NULL)
+                return e;
+
+        // Build outside the lock so other patterns are not held up by the inversion
+        built = entry_build(cache, hash, erasure_list, nerrs);
+        if (built == NULL)
+                return NULL;
+
+        cache_lock(cache);
+        e = cache_find(cache, hash, erasure_list, nerrs);
+        if (e != NULL) {
+                // Another thread inserted the same pattern meanwhile
+                e->refs++;
+                lru_unlink(cache, e);
+                lru_push_head(cache, e);
+                cache_unlock(cache);
+                free(built);
+                return e;
+        }
+        if (cache_make_room(cache)) {
+                built->cached = 1;
+                built->hnext = cache->buckets[hash & cache->bucket_mask];
+                cache->buckets[hash & cache->bucket_mask] = built;
+                lru_push_head(cache, built);
+                cache->count++;
+        }
+        cache_unlock(cache);
+        return built;
+}
+
+static void
+cache_put(struct ec_decode_cache *cache, struct ec_decode_entry *e)
+{
+        if (!e->cached) {
+                // Not shared, every entry in the cache was busy
+                free(e);
+                return;
+        }
+        cache_lock(cache);
+        e->refs--;
+        cache_unlock(cache);
+}
+
+struct ec_decode_cache *
+ec_decode_cache_create(int k, int m, const unsigned char *encode_matrix, int entries)
+{
+        struct ec_decode_cache *cache;
+        uint32_t nbuckets = 1;
+
+        if (k < 1 || m <= k || m > EC_DECODE_MAX_FRAGS || encode_matrix == NULL || entries < 1)
+                return NULL;
+
+        while (nbuckets < 2 * (uint32_t) entries && nbuckets < (1 << 16))
+                nbuckets <<= 1;
+
+        cache = calloc(1, sizeof(*cache));
+        if (cache == NULL)
+                return NULL;
+
+        cache->encode_matrix = malloc(m * k);
+        cache->buckets = calloc(nbuckets, sizeof(cache->buckets[0]));
+        if (cache->encode_matrix == NULL || cache->buckets == NULL) {
+                free(cache->encode_matrix);
+                free(cache->buckets);
+                free(cache);
+                return NULL;
+        }
+#ifdef HAVE_THREADS
+        if (pthread_mutex_init(&cache->mutex, NULL) != 0) {
+                free(cache->encode_matrix);
+                free(cache->buckets);
+                free(cache);
+                return NULL;
+        }
+#endif
+        memcpy(cache->encode_matrix, encode_matrix, m * k);
+        cache->k = k;
+        cache->m = m;
+        cache->entries = entries;
+        cache->bucket_mask = nbuckets - 1;
+        return cache;
+}
+
+void
+ec_decode_cache_free(struct ec_decode_cache *cache)
+{
+        struct ec_decode_entry *e, *next;
+
+        if (cache == NULL)
+                return;
+
+        for (e = cache->head; e != NULL; e = next) {
+                next = e->next;
+                free(e);
+        }
+#ifdef HAVE_THREADS
+        pthread_mutex_destroy(&cache->mutex);
+#endif
+        free(cache->encode_matrix);
+        free(cache->buckets);
+        free(cache);
+}
+
+// Regenerates with pool if given, else with up to num_threads new threads
+static int
+decode_data(struct ec_decode_cache *cache, int len, const unsigned char *erasure_list, int nerrs,
+            unsigned char **frags, unsigned char **recover, struct ec_thread_pool *pool,
+            int num_threads)
+{
+        unsigned char *srcs[EC_DECODE_MAX_FRAGS];
+        struct ec_decode_entry *e;
+        int i;
+
+        if (cache == NULL || len < 0 || nerrs < 1 || nerrs > cache->m - cache->k)
+                return -1;
+
+        e = cache_get(cache, erasure_list, nerrs);
+        if (e == NULL)
+                return -1;
+
+        for (i = 0; i < cache->k; i++)
+                srcs[i] = frags[e->decode_index[i]];
+
+        if (pool != NULL)
+                ec_encode_data_pool(len, cache->k, nerrs, e->gftbls, srcs, recover, pool);
+        else
+                ec_encode_data_mt(len, cache->k, nerrs, e->gftbls, srcs, recover, num_threads);
+
+        cache_put(cache, e);
+        return 0;
+}
+
+int
+ec_decode_data_mt(struct ec_decode_cache *cache, int len, const unsigned char *erasure_list,
+                  int nerrs, unsigned char **frags, unsigned char **recover, int num_threads)
+{
+        return decode_data(cache, len, erasure_list, nerrs, frags, recover, NULL, num_threads);
+}
+
+int
+ec_decode_data_pool(struct ec_decode_cache *cache, int len, const unsigned char *erasure_list,
+                    int nerrs, unsigned char **frags, unsigned char **recover,
+                    struct ec_thread_pool *pool)
+{
+        return decode_data(cache, len, erasure_list, nerrs, frags, recover, pool, 1);
+}
+
+int
+ec_decode_data(struct ec_decode_cache *cache, int len, const unsigned char *erasure_list,
+               int nerrs, unsigned char **frags, unsigned char **recover)
+{
+        return decode_data(cache, len, erasure_list, nerrs, frags, recover, NULL, 1);
+}
@@ -0,0 +1,265 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdlib.h>
+#ifdef HAVE_THREADS
+#include <pthread.h>
+#endif
+
+#include "erasure_code.h"
+
+#define EC_MT_MIN_SLICE   (64 * 1024)
+#define EC_MT_ALIGN       64
+#define EC_MT_MAX_VECS    256
+#define EC_MT_MAX_THREADS 256
+
+struct ec_mt_slice {
+        int len;
+        int k;
+        int rows;
+        unsigned char *gftbls;
+        unsigned char *data[EC_MT_MAX_VECS];
+        unsigned char *coding[EC_MT_MAX_VECS];
+};
+
+#ifdef HAVE_THREADS
+struct ec_mt_thread {
+        struct ec_thread_pool *pool;
+        int id;
+        pthread_t thread;
+};
+#endif
+
+/*
+ * Workers started once by ec_thread_pool_create() wait on the start condition
+ * for each job, worker i takes slice i of it and the last one to finish wakes
+ * the caller, which runs slice 0 itself.
+ */
+struct ec_thread_pool {
+        int num_threads; // started workers plus the calling thread
+        struct ec_mt_slice *slices;
+#ifdef HAVE_THREADS
+        struct ec_mt_thread *threads;
+        pthread_mutex_t busy; // held by the call using the pool
+        pthread_mutex_t lock;
+        pthread_cond_t start;
+        pthread_cond_t done;
+        unsigned long job;
+        int nslices;
+        int pending;
+        int stop;
+#endif
+};
+
+#ifdef HAVE_THREADS
+static void
+ec_mt_run(struct ec_mt_slice *s)
+{
+        ec_encode_data(s->len, s->k, s->rows, s->gftbls, s->data, s->coding);
+}
+
+static void *
+ec_mt_worker(void *arg)
+{
+        struct ec_mt_thread *w = arg;
+        struct ec_thread_pool *pool = w->pool;
+        unsigned long job = 0;
+
+        pthread_mutex_lock(&pool->lock);
+        for (;;) {
+                while (pool->job == job && !pool->stop)
+                        pthread_cond_wait(&pool->start, &pool->lock);
+                if (pool->stop)
+                        break;
+                job = pool->job;
+                pthread_mutex_unlock(&pool->lock);
+
+                if (w->id < pool->nslices)
+                        ec_mt_run(&pool->slices[w->id]);
+
+                pthread_mutex_lock(&pool->lock);
+                if (--pool->pending == 0)
+                        pthread_cond_signal(&pool->done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+        return NULL;
+}
+#endif
+
+struct ec_thread_pool *
+ec_thread_pool_create(int num_threads)
+{
+        struct ec_thread_pool *pool;
+        int t;
+
+        if (num_threads < 1)
+                num_threads = 1;
+        if (num_threads > EC_MT_MAX_THREADS)
+                num_threads = EC_MT_MAX_THREADS;
+
+        pool = calloc(1, sizeof(*pool));
+        if (pool == NULL)
+                return NULL;
+
+        pool->num_threads = 1;
+#ifdef HAVE_THREADS
+        if (num_threads == 1)
+                return pool;
+
+        pool->slices = malloc(num_threads * sizeof(*pool->slices));
+        pool->threads = calloc(num_threads, sizeof(*pool->threads));
+        if (pool->slices == NULL || pool->threads == NULL) {
+                free(pool->slices);
+                free(pool->threads);
+                free(pool);
+                return NULL;
+        }
+
+        pthread_mutex_init(&pool->busy, NULL);
+        pthread_mutex_init(&pool->lock, NULL);
+        pthread_cond_init(&pool->start, NULL);
+        pthread_cond_init(&pool->done, NULL);
+
+        // A worker that fails to start leaves the pool with fewer threads
+        for (t = 1; t < num_threads; t++) {
+                pool->threads[t].pool = pool;
+                pool->threads[t].id = t;
+                if (pthread_create(&pool->threads[t].thread, NULL, ec_mt_worker,
+                                   &pool->threads[t]))
+                        break;
+        }
+        pool->num_threads = t;
+#else
+        (void) t;
+#endif
+        return pool;
+}
+
+void
+ec_thread_pool_free(struct ec_thread_pool *pool)
+{
+#ifdef HAVE_THREADS
+        int t;
+#endif
+
+        if (pool == NULL)
+                return;
+
+#ifdef HAVE_THREADS
+        if (pool->num_threads > 1) {
+                pthread_mutex_lock(&pool->lock);
+                pool->stop = 1;
+                pthread_cond_broadcast(&pool->start);
+                pthread_mutex_unlock(&pool->lock);
+
+                for (t = 1; t < pool->num_threads; t++)
+                        pthread_join(pool->threads[t].thread, NULL);
+        }
+        if (pool->threads != NULL) {
+                pthread_cond_destroy(&pool->done);
+                pthread_cond_destroy(&pool->start);
+                pthread_mutex_destroy(&pool->lock);
+                pthread_mutex_destroy(&pool->busy);
+        }
+        free(pool->threads);
+#endif
+        free(pool->slices);
+        free(pool);
+}
+
+void
+ec_encode_data_pool(int len, int k, int rows, unsigned char *gftbls, unsigned char **data,
+                    unsigned char **coding, struct ec_thread_pool *pool)
+{
+        int nslices = (pool != NULL) ? pool->num_threads : 1;
+#ifdef HAVE_THREADS
+        int i, t, slice;
+#endif
+
+        if (nslices > len / EC_MT_MIN_SLICE)
+                nslices = len / EC_MT_MIN_SLICE;
+
+        if (nslices <= 1 || k > EC_MT_MAX_VECS || rows > EC_MT_MAX_VECS) {
+                ec_encode_data(len, k, rows, gftbls, data, coding);
+                return;
+        }
+
+#ifdef HAVE_THREADS
+        pthread_mutex_lock(&pool->busy);
+
+        slice = ((len + nslices - 1) / nslices + EC_MT_ALIGN - 1) & ~(EC_MT_ALIGN - 1);
+        nslices = (len + slice - 1) / slice;
+
+        for (t = 0; t < nslices; t++) {
+                struct ec_mt_slice *s = &pool->slices[t];
+                int off = t * slice;
+
+                s->len = (len - off < slice) ? len - off : slice;
+                s->k = k;
+                s->rows = rows;
+                s->gftbls = gftbls;
+                for (i = 0; i < k; i++)
+                        s->data[i] = data[i] + off;
+                for (i = 0; i < rows; i++)
+                        s->coding[i] = coding[i] + off;
+        }
+
+        pthread_mutex_lock(&pool->lock);
+        pool->nslices = nslices;
+        pool->pending = pool->num_threads - 1;
+        pool->job++;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->lock);
+
+        ec_mt_run(&pool->slices[0]);
+
+        pthread_mutex_lock(&pool->lock);
+        while (pool->pending > 0)
+                pthread_cond_wait(&pool->done, &pool->lock);
+        pthread_mutex_unlock(&pool->lock);
+
+        pthread_mutex_unlock(&pool->busy);
+#endif
+}
+
+void
+ec_encode_data_mt(int len, int k, int rows, unsigned char *gftbls, unsigned char **data,
+                  unsigned char **coding, int num_threads)
+{
+        struct ec_thread_pool *pool = NULL;
+
+        if (num_threads > len / EC_MT_MIN_SLICE)
+                num_threads = len / EC_MT_MIN_SLICE;
+
+        if (num_threads > 1 && k <= EC_MT_MAX_VECS && rows <= EC_MT_MAX_VECS)
+                pool = ec_thread_pool_create(num_threads);
+
+        ec_encode_data_pool(len, k, rows, gftbls, data, coding, pool);
+        ec_thread_pool_free(pool);
+}
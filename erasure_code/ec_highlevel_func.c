@@ -156,16 +156,52 @@ gf_6vect_mad_avx2(int len, int vec, int vec_i, unsigned char *gftbls, unsigned c
 extern int
 gf_vect_mul_avx2_gfni(int len, unsigned char *gftbl, void *src, void *dest);
 
-void
-ec_encode_data_sse(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
-                   unsigned char **coding)
+/*
+ * When rows exceed the widest dot product kernel, each group of rows re-reads
+ * all k sources. For large lengths, split len into tiles whose k sources fit
+ * in L2 and encode every group of rows on a tile before moving to the next, so
+ * only the first group streams the sources from memory.
+ */
+#define EC_TILE_BYTES (512 * 1024)
+#define EC_TILE_MIN   (4 * 1024)
+#define EC_TILE_VECS  256
+
+typedef void (*ec_encode_rows_func)(int len, int k, int rows, unsigned char *g_tbls,
+                                    unsigned char **data, unsigned char **coding);
+
+static void
+ec_encode_data_tiled(int len, int k, int rows, int max_rows, unsigned char *g_tbls,
+                     unsigned char **data, unsigned char **coding, ec_encode_rows_func encode_rows)
 {
+        unsigned char *data_tile[EC_TILE_VECS], *coding_tile[EC_TILE_VECS];
+        int i, off, tile, tile_len;
 
-        if (len < 16) {
-                ec_encode_data_base(len, k, rows, g_tbls, data, coding);
+        tile = (EC_TILE_BYTES / k) & ~63;
+        if (tile < EC_TILE_MIN)
+                tile = EC_TILE_MIN;
+
+        if (rows <= max_rows || len < 2 * tile || k > EC_TILE_VECS || rows > EC_TILE_VECS) {
+                encode_rows(len, k, rows, g_tbls, data, coding);
                 return;
         }
 
+        for (off = 0; off < len; off += tile_len) {
+                // Fold a short remainder into the last tile
+                tile_len = (len - off < 2 * tile) ? len - off : tile;
+
+                for (i = 0; i < k; i++)
+                        data_tile[i] = data[i] + off;
+                for (i = 0; i < rows; i++)
+                        coding_tile[i] = coding[i] + off;
+
+                encode_rows(tile_len, k, rows, g_tbls, data_tile, coding_tile);
+        }
+}
+
+static void
+ec_encode_rows_sse(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                   unsigned char **coding)
+{
         while (rows >= 6) {
                 gf_6vect_dot_prod_sse(len, k, g_tbls, data, coding);
                 g_tbls += 6 * k * 32;
@@ -194,7 +230,7 @@ ec_encode_data_sse(int len, int k, int rows, unsigned char *g_tbls, unsigned cha
 }
 
 void
-ec_encode_data_avx(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+ec_encode_data_sse(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
                    unsigned char **coding)
 {
         if (len < 16) {
@@ -202,6 +238,13 @@ ec_encode_data_avx(int len, int k, int rows, unsigned char *g_tbls, unsigned cha
                 return;
         }
 
+        ec_encode_data_tiled(len, k, rows, 6, g_tbls, data, coding, ec_encode_rows_sse);
+}
+
+static void
+ec_encode_rows_avx(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                   unsigned char **coding)
+{
         while (rows >= 6) {
                 gf_6vect_dot_prod_avx(len, k, g_tbls, data, coding);
                 g_tbls += 6 * k * 32;
@@ -230,15 +273,21 @@ ec_encode_data_avx(int len, int k, int rows, unsigned char *g_tbls, unsigned cha
 }
 
 void
-ec_encode_data_avx2(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
-                    unsigned char **coding)
+ec_encode_data_avx(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                   unsigned char **coding)
 {
-
-        if (len < 32) {
+        if (len < 16) {
                 ec_encode_data_base(len, k, rows, g_tbls, data, coding);
                 return;
         }
 
+        ec_encode_data_tiled(len, k, rows, 6, g_tbls, data, coding, ec_encode_rows_avx);
+}
+
+static void
+ec_encode_rows_avx2(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                    unsigned char **coding)
+{
         while (rows >= 6) {
                 gf_6vect_dot_prod_avx2(len, k, g_tbls, data, coding);
                 g_tbls += 6 * k * 32;
@@ -266,6 +315,18 @@ ec_encode_data_avx2(int len, int k, int rows, unsigned char *g_tbls, unsigned ch
         }
 }
 
+void
+ec_encode_data_avx2(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                    unsigned char **coding)
+{
+        if (len < 32) {
+                ec_encode_data_base(len, k, rows, g_tbls, data, coding);
+                return;
+        }
+
+        ec_encode_data_tiled(len, k, rows, 6, g_tbls, data, coding, ec_encode_rows_avx2);
+}
+
 extern int
 gf_vect_dot_prod_avx512(int len, int k, unsigned char *g_tbls, unsigned char **data,
                         unsigned char *dest);
@@ -303,16 +364,10 @@ extern void
 gf_6vect_mad_avx512(int len, int vec, int vec_i, unsigned char *gftbls, unsigned char *src,
                     unsigned char **dest);
 
-void
-ec_encode_data_avx512(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+static void
+ec_encode_rows_avx512(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
                       unsigned char **coding)
 {
-
-        if (len < 64) {
-                ec_encode_data_base(len, k, rows, g_tbls, data, coding);
-                return;
-        }
-
         while (rows >= 6) {
                 gf_6vect_dot_prod_avx512(len, k, g_tbls, data, coding);
                 g_tbls += 6 * k * 32;
@@ -340,6 +395,18 @@ ec_encode_data_avx512(int len, int k, int rows, unsigned char *g_tbls, unsigned
         }
 }
 
+void
+ec_encode_data_avx512(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                      unsigned char **coding)
+{
+        if (len < 64) {
+                ec_encode_data_base(len, k, rows, g_tbls, data, coding);
+                return;
+        }
+
+        ec_encode_data_tiled(len, k, rows, 6, g_tbls, data, coding, ec_encode_rows_avx512);
+}
+
 void
 ec_encode_data_update_avx512(int len, int k, int rows, int vec_i, unsigned char *g_tbls,
                              unsigned char *data, unsigned char **coding)
@@ -463,11 +530,81 @@ ec_init_tables_gfni(int k, int rows, unsigned char *a, unsigned char *g_tbls)
         }
 }
 
-void
-ec_encode_data_avx512_gfni(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
-                           unsigned char **coding)
+/*
+ * Dot products of 7 and 8 rows, so wide parity layouts read each source once
+ * per 8 rows instead of once per 6. Each 64-byte column of the k sources is
+ * loaded once and multiplied into every row by an affine transform with the
+ * 8x8 bit matrix held in the first 8 bytes of its 32-byte table entry.
+ */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define EC_GFNI_WIDE_ROWS 8
+#define EC_GFNI_TARGET    __attribute__((target("avx512f,avx512bw,gfni")))
+
+EC_GFNI_TARGET static inline __attribute__((always_inline)) void
+gf_nvect_dot_prod_avx512_gfni(int len, int k, unsigned char *g_tbls, unsigned char **data,
+                              unsigned char **coding, const int rows)
+{
+        __m512i p[EC_GFNI_WIDE_ROWS], x, m;
+        __mmask64 mask = ~(__mmask64) 0;
+        uint64_t mat;
+        int i, j, r;
+
+        for (i = 0; i < len; i += 64) {
+                if (len - i < 64)
+                        mask = ((__mmask64) 1 << (len - i)) - 1;
+
+                for (r = 0; r < rows; r++)
+                        p[r] = _mm512_setzero_si512();
+
+                for (j = 0; j < k; j++) {
+                        x = _mm512_maskz_loadu_epi8(mask, data[j] + i);
+                        for (r = 0; r < rows; r++) {
+                                memcpy(&mat, &g_tbls[(r * k + j) * 32], sizeof(mat));
+                                m = _mm512_set1_epi64(mat);
+                                p[r] = _mm512_xor_si512(p[r],
+                                                        _mm512_gf2p8affine_epi64_epi8(x, m, 0));
+                        }
+                }
+
+                for (r = 0; r < rows; r++)
+                        _mm512_mask_storeu_epi8(coding[r] + i, mask, p[r]);
+        }
+}
+
+EC_GFNI_TARGET static void
+gf_7vect_dot_prod_avx512_gfni(int len, int k, unsigned char *g_tbls, unsigned char **data,
+                              unsigned char **coding)
+{
+        gf_nvect_dot_prod_avx512_gfni(len, k, g_tbls, data, coding, 7);
+}
+
+EC_GFNI_TARGET static void
+gf_8vect_dot_prod_avx512_gfni(int len, int k, unsigned char *g_tbls, unsigned char **data,
+                              unsigned char **coding)
 {
+        gf_nvect_dot_prod_avx512_gfni(len, k, g_tbls, data, coding, 8);
+}
+#else
+#define EC_GFNI_WIDE_ROWS 6
+#endif
 
+static void
+ec_encode_rows_avx512_gfni(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                           unsigned char **coding)
+{
+#if EC_GFNI_WIDE_ROWS == 8
+        while (rows >= 8) {
+                gf_8vect_dot_prod_avx512_gfni(len, k, g_tbls, data, coding);
+                g_tbls += 8 * k * 32;
+                coding += 8;
+                rows -= 8;
+        }
+        if (rows == 7) {
+                gf_7vect_dot_prod_avx512_gfni(len, k, g_tbls, data, coding);
+                return;
+        }
+#endif
         while (rows >= 6) {
                 gf_6vect_dot_prod_avx512_gfni(len, k, g_tbls, data, coding);
                 g_tbls += 6 * k * 32;
@@ -497,7 +634,15 @@ ec_encode_data_avx512_gfni(int len, int k, int rows, unsigned char *g_tbls, unsi
 }
 
 void
-ec_encode_data_avx2_gfni(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+ec_encode_data_avx512_gfni(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                           unsigned char **coding)
+{
+        ec_encode_data_tiled(len, k, rows, EC_GFNI_WIDE_ROWS, g_tbls, data, coding,
+                             ec_encode_rows_avx512_gfni);
+}
+
+static void
+ec_encode_rows_avx2_gfni(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
                          unsigned char **coding)
 {
         while (rows >= 3) {
@@ -519,6 +664,13 @@ ec_encode_data_avx2_gfni(int len, int k, int rows, unsigned char *g_tbls, unsign
         }
 }
 
+void
+ec_encode_data_avx2_gfni(int len, int k, int rows, unsigned char *g_tbls, unsigned char **data,
+                         unsigned char **coding)
+{
+        ec_encode_data_tiled(len, k, rows, 3, g_tbls, data, coding, ec_encode_rows_avx2_gfni);
+}
+
 void
 ec_encode_data_update_avx512_gfni(int len, int k, int rows, int vec_i, unsigned char *g_tbls,
                                   unsigned char *data, unsigned char **coding)
@@ -0,0 +1,206 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "erasure_code.h"
+#include "test.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED 11
+#endif
+
+#define TEST_LEN     1024
+#define MMAX         64
+#define KMAX         32
+#define PATTERNS     8
+#define DECODE_LOOPS 64
+
+typedef unsigned char u8;
+
+// Pick nerrs distinct erased fragments in random order
+static void
+rand_erasures(u8 *erasure_list, int nerrs, int m)
+{
+        u8 used[MMAX];
+        int i, e;
+
+        memset(used, 0, sizeof(used));
+        for (i = 0; i < nerrs; i++) {
+                do
+                        e = rand() % m;
+                while (used[e]);
+                used[e] = 1;
+                erasure_list[i] = e;
+        }
+}
+
+static int
+check_recovery(int k, u8 *erasure_list, int nerrs, u8 **frags, u8 **recover)
+{
+        int i;
+
+        for (i = 0; i < nerrs; i++)
+                if (memcmp(recover[i], frags[erasure_list[i]], TEST_LEN)) {
+                        printf("Fail recovery of frag %d with k=%d nerrs=%d\n", erasure_list[i],
+                               k, nerrs);
+                        return 1;
+                }
+        return 0;
+}
+
+static int
+test_code(int k, int p, int entries)
+{
+        u8 *frags[MMAX], *frag_ptrs[MMAX], *recover[MMAX];
+        u8 patterns[PATTERNS][MMAX];
+        int pattern_errs[PATTERNS];
+        u8 encode_matrix[MMAX * KMAX], decode_matrix[MMAX * KMAX];
+        u8 decode_index[KMAX], g_tbls[KMAX * MMAX * 32];
+        struct ec_decode_cache *cache;
+        int i, j, n, m = k + p, fail = 0;
+
+        for (i = 0; i < m; i++) {
+                frags[i] = malloc(TEST_LEN);
+                recover[i] = malloc(TEST_LEN);
+                if (frags[i] == NULL || recover[i] == NULL) {
+                        printf("alloc error: Fail\n");
+                        return 1;
+                }
+                for (j = 0; j < TEST_LEN; j++)
+                        frags[i][j] = rand();
+        }
+
+        gf_gen_cauchy1_matrix(encode_matrix, m, k);
+        ec_init_tables(k, p, &encode_matrix[k * k], g_tbls);
+        ec_encode_data(TEST_LEN, k, p, g_tbls, frags, &frags[k]);
+
+        cache = ec_decode_cache_create(k, m, encode_matrix, entries);
+        if (cache == NULL) {
+                printf("Fail to create cache k=%d p=%d\n", k, p);
+                return 1;
+        }
+        // The cache keeps its own copy of the encode matrix
+        memset(encode_matrix, 0, m * k);
+
+        for (i = 0; i < PATTERNS; i++) {
+                pattern_errs[i] = 1 + rand() % p;
+                rand_erasures(patterns[i], pattern_errs[i], m);
+        }
+
+        // Repeat a few patterns so both hits and evictions are exercised
+        for (n = 0; n < DECODE_LOOPS; n++) {
+                int pattern = rand() % PATTERNS;
+                u8 *erasure_list = patterns[pattern];
+                int nerrs = pattern_errs[pattern];
+
+                // Erased fragments must not be read
+                memcpy(frag_ptrs, frags, sizeof(frags));
+                for (i = 0; i < nerrs; i++)
+                        frag_ptrs[erasure_list[i]] = NULL;
+                for (i = 0; i < nerrs; i++)
+                        memset(recover[i], 0, TEST_LEN);
+
+                if (ec_decode_data(cache, TEST_LEN, erasure_list, nerrs, frag_ptrs, recover)) {
+                        printf("Fail ec_decode_data k=%d p=%d nerrs=%d\n", k, p, nerrs);
+                        fail++;
+                        continue;
+                }
+                fail += check_recovery(k, erasure_list, nerrs, frags, recover);
+        }
+
+        // Compare with decoding through ec_gen_decode_matrix() directly
+        gf_gen_cauchy1_matrix(encode_matrix, m, k);
+        if (ec_gen_decode_matrix(k, m, encode_matrix, patterns[0], pattern_errs[0], decode_matrix,
+                                 decode_index)) {
+                printf("Fail ec_gen_decode_matrix k=%d p=%d\n", k, p);
+                fail++;
+        } else {
+                for (i = 0; i < k; i++)
+                        frag_ptrs[i] = frags[decode_index[i]];
+                ec_init_tables(k, pattern_errs[0], decode_matrix, g_tbls);
+                ec_encode_data(TEST_LEN, k, pattern_errs[0], g_tbls, frag_ptrs, recover);
+                fail += check_recovery(k, patterns[0], pattern_errs[0], frags, recover);
+        }
+
+        // Invalid erasure lists
+        patterns[1][0] = m;
+        if (ec_decode_data(cache, TEST_LEN, patterns[1], 1, frags, recover) == 0) {
+                printf("Fail to reject erasure out of range\n");
+                fail++;
+        }
+        patterns[1][0] = patterns[1][1] = 0;
+        if (p > 1 && ec_decode_data(cache, TEST_LEN, patterns[1], 2, frags, recover) == 0) {
+                printf("Fail to reject duplicate erasure\n");
+                fail++;
+        }
+        if (ec_decode_data(cache, TEST_LEN, patterns[1], p + 1, frags, recover) == 0) {
+                printf("Fail to reject too many erasures\n");
+                fail++;
+        }
+
+        ec_decode_cache_free(cache);
+        for (i = 0; i < m; i++) {
+                free(frags[i]);
+                free(recover[i]);
+        }
+        return fail;
+}
+
+int
+main(int argc, char *argv[])
+{
+        int i, fail = 0;
+
+        printf("ec_decode_data: ");
+        srand(TEST_SEED);
+
+        fail += test_code(10, 4, 16);
+        fail += test_code(4, 2, 1);
+        fail += test_code(1, 1, 4);
+
+        for (i = 0; i < 16; i++) {
+                int k = 1 + rand() % KMAX;
+                int p = 1 + rand() % (MMAX - KMAX);
+
+                fail += test_code(k, p, 1 + rand() % PATTERNS);
+#ifdef TEST_VERBOSE
+                putchar('.');
+#endif
+        }
+
+        if (ec_decode_cache_create(4, 4, NULL, 1) != NULL) {
+                printf("Fail to reject invalid code\n");
+                fail++;
+        }
+
+        printf(" %s\n", fail ? "Fail" : "Pass");
+        return fail;
+}
@@ -0,0 +1,179 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "erasure_code.h"
+#include "test.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED 11
+#endif
+
+#define MAX_LEN (1024 * 1024 + 4321)
+#define KMAX    12
+#define PMAX    6
+
+typedef unsigned char u8;
+
+int
+main(int argc, char *argv[])
+{
+        u8 *frags[KMAX + PMAX], *ref[PMAX], *recover[PMAX];
+        u8 encode_matrix[(KMAX + PMAX) * KMAX], g_tbls[KMAX * PMAX * 32];
+        u8 erasure_list[PMAX];
+        int lens[] = { 100, 64 * 1024, 200 * 1024 + 7, 1024 * 1024, MAX_LEN };
+        int threads[] = { 1, 2, 3, 4, 8, 17 };
+        int i, j, l, t, k = KMAX, p = PMAX, m = KMAX + PMAX, fail = 0;
+        struct ec_decode_cache *cache;
+        struct ec_thread_pool *pool;
+
+        printf("ec_encode_data_mt: ");
+        srand(TEST_SEED);
+
+        for (i = 0; i < m; i++) {
+                frags[i] = malloc(MAX_LEN);
+                if (frags[i] == NULL) {
+                        printf("alloc error: Fail\n");
+                        return -1;
+                }
+                for (j = 0; j < MAX_LEN; j++)
+                        frags[i][j] = rand();
+        }
+        for (i = 0; i < p; i++) {
+                ref[i] = malloc(MAX_LEN);
+                recover[i] = malloc(MAX_LEN);
+                if (ref[i] == NULL || recover[i] == NULL) {
+                        printf("alloc error: Fail\n");
+                        return -1;
+                }
+        }
+
+        gf_gen_cauchy1_matrix(encode_matrix, m, k);
+        ec_init_tables(k, p, &encode_matrix[k * k], g_tbls);
+
+        for (l = 0; l < (int) (sizeof(lens) / sizeof(lens[0])); l++) {
+                ec_encode_data(lens[l], k, p, g_tbls, frags, ref);
+
+                for (t = 0; t < (int) (sizeof(threads) / sizeof(threads[0])); t++) {
+                        for (i = 0; i < p; i++)
+                                memset(frags[k + i], 0, lens[l]);
+                        ec_encode_data_mt(lens[l], k, p, g_tbls, frags, &frags[k], threads[t]);
+                        for (i = 0; i < p; i++)
+                                if (memcmp(frags[k + i], ref[i], lens[l])) {
+                                        printf("Fail encode len=%d threads=%d\n", lens[l],
+                                               threads[t]);
+                                        fail++;
+                                        break;
+                                }
+                }
+        }
+
+        // One pool per thread count reused for every length
+        for (t = 0; t < (int) (sizeof(threads) / sizeof(threads[0])); t++) {
+                pool = ec_thread_pool_create(threads[t]);
+                if (pool == NULL) {
+                        printf("Fail to create pool\n");
+                        return -1;
+                }
+                for (l = 0; l < (int) (sizeof(lens) / sizeof(lens[0])); l++) {
+                        ec_encode_data(lens[l], k, p, g_tbls, frags, ref);
+                        for (i = 0; i < p; i++)
+                                memset(frags[k + i], 0, lens[l]);
+                        ec_encode_data_pool(lens[l], k, p, g_tbls, frags, &frags[k], pool);
+                        for (i = 0; i < p; i++)
+                                if (memcmp(frags[k + i], ref[i], lens[l])) {
+                                        printf("Fail pool encode len=%d threads=%d\n", lens[l],
+                                               threads[t]);
+                                        fail++;
+                                        break;
+                                }
+                }
+                ec_thread_pool_free(pool);
+        }
+
+        // Frags now hold a valid encode of MAX_LEN
+        cache = ec_decode_cache_create(k, m, encode_matrix, 4);
+        if (cache == NULL) {
+                printf("Fail to create cache\n");
+                return -1;
+        }
+        for (t = 0; t < (int) (sizeof(threads) / sizeof(threads[0])); t++) {
+                int nerrs = 1 + rand() % p;
+
+                for (i = 0; i < nerrs; i++) {
+                        erasure_list[i] = rand() % m;
+                        for (j = 0; j < i; j++)
+                                if (erasure_list[j] == erasure_list[i])
+                                        break;
+                        if (j < i)
+                                i--;
+                }
+                if (ec_decode_data_mt(cache, MAX_LEN, erasure_list, nerrs, frags, recover,
+                                      threads[t])) {
+                        printf("Fail ec_decode_data_mt threads=%d\n", threads[t]);
+                        fail++;
+                        continue;
+                }
+                for (i = 0; i < nerrs; i++)
+                        if (memcmp(recover[i], frags[erasure_list[i]], MAX_LEN)) {
+                                printf("Fail decode frag %d threads=%d\n", erasure_list[i],
+                                       threads[t]);
+                                fail++;
+                        }
+
+                pool = ec_thread_pool_create(threads[t]);
+                for (i = 0; i < nerrs; i++)
+                        memset(recover[i], 0, MAX_LEN);
+                if (ec_decode_data_pool(cache, MAX_LEN, erasure_list, nerrs, frags, recover,
+                                        pool)) {
+                        printf("Fail ec_decode_data_pool threads=%d\n", threads[t]);
+                        fail++;
+                }
+                for (i = 0; i < nerrs; i++)
+                        if (memcmp(recover[i], frags[erasure_list[i]], MAX_LEN)) {
+                                printf("Fail pool decode frag %d threads=%d\n",
+                                       erasure_list[i], threads[t]);
+                                fail++;
+                        }
+                ec_thread_pool_free(pool);
+        }
+        ec_decode_cache_free(cache);
+
+        for (i = 0; i < m; i++)
+                free(frags[i]);
+        for (i = 0; i < p; i++) {
+                free(ref[i]);
+                free(recover[i]);
+        }
+
+        printf("%s\n", fail ? "Fail" : "Pass");
+        return fail;
+}
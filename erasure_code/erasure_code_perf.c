@@ -119,7 +119,8 @@ usage(const char *app_name)
                 "  -e <val>  Number of simulated buffers with errors (cannot be higher than p or "
                 "k)\n"
                 "  -s <val>  Size of each buffer in bytes. Can use K (1024 bytes), M (1024 KB), G "
-                "(1024 MB) suffixes)\n",
+                "(1024 MB) suffixes)\n"
+                "  -t <val>  Also run multi-threaded encode and decode from 1 to val threads\n",
                 app_name);
 }
 
@@ -167,6 +168,89 @@ ec_decode_perf(int m, int k, u8 *a, u8 *g_tbls, u8 **buffs, u8 *src_in_err, u8 *
         return 0;
 }
 
+void
+ec_encode_mt_perf(int m, int k, u8 *g_tbls, u8 **buffs, struct perf *start, int test_len,
+                  int num_threads)
+{
+        BENCHMARK(start, BENCHMARK_TIME,
+                  ec_encode_data_mt(test_len, k, m - k, g_tbls, buffs, &buffs[k], num_threads));
+}
+
+void
+ec_encode_pool_perf(int m, int k, u8 *g_tbls, u8 **buffs, struct perf *start, int test_len,
+                    struct ec_thread_pool *pool)
+{
+        BENCHMARK(start, BENCHMARK_TIME,
+                  ec_encode_data_pool(test_len, k, m - k, g_tbls, buffs, &buffs[k], pool));
+}
+
+int
+ec_decode_mt_perf(struct ec_decode_cache *cache, u8 **buffs, u8 *src_err_list, int nerrs,
+                  u8 **temp_buffs, struct perf *start, int test_len, int num_threads)
+{
+        if (ec_decode_data_mt(cache, test_len, src_err_list, nerrs, buffs, temp_buffs,
+                              num_threads))
+                return BAD_MATRIX;
+
+        BENCHMARK(start, BENCHMARK_TIME,
+                  ec_decode_data_mt(cache, test_len, src_err_list, nerrs, buffs, temp_buffs,
+                                    num_threads));
+        return 0;
+}
+
+// Report encode and decode scaling for 1, 2, 4 ... max_threads threads
+int
+ec_mt_perf(int m, int k, u8 *a, u8 *g_tbls, u8 **buffs, u8 *src_err_list, int nerrs,
+           u8 **temp_buffs, int test_len, int max_threads)
+{
+        struct ec_decode_cache *cache;
+        struct ec_thread_pool *pool;
+        struct perf start;
+        int i, t;
+
+        cache = ec_decode_cache_create(k, m, a, 1);
+        if (cache == NULL)
+                return BAD_MATRIX;
+
+        ec_init_tables(k, m - k, &a[k * k], g_tbls);
+        for (t = 1;; t *= 2) {
+                if (t > max_threads)
+                        t = max_threads;
+
+                ec_encode_mt_perf(m, k, g_tbls, buffs, &start, test_len, t);
+                printf("erasure_code_encode_mt" TEST_TYPE_STR "_%d: ", t);
+                perf_print(start, (double) (test_len) * (m));
+
+                pool = ec_thread_pool_create(t);
+                if (pool != NULL) {
+                        ec_encode_pool_perf(m, k, g_tbls, buffs, &start, test_len, pool);
+                        printf("erasure_code_encode_pool" TEST_TYPE_STR "_%d: ", t);
+                        perf_print(start, (double) (test_len) * (m));
+                        ec_thread_pool_free(pool);
+                }
+
+                if (ec_decode_mt_perf(cache, buffs, src_err_list, nerrs, temp_buffs, &start,
+                                      test_len, t)) {
+                        ec_decode_cache_free(cache);
+                        return BAD_MATRIX;
+                }
+                for (i = 0; i < nerrs; i++)
+                        if (memcmp(temp_buffs[i], buffs[src_err_list[i]], test_len)) {
+                                printf("Fail multi-threaded error recovery (%d, %d, %d) - ", m,
+                                       k, nerrs);
+                                ec_decode_cache_free(cache);
+                                return -1;
+                        }
+                printf("erasure_code_decode_mt" TEST_TYPE_STR "_%d: ", t);
+                perf_print(start, (double) (test_len) * (k + nerrs));
+
+                if (t == max_threads)
+                        break;
+        }
+        ec_decode_cache_free(cache);
+        return 0;
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -179,6 +263,7 @@ main(int argc, char *argv[])
         u8 src_err_list[TEST_SOURCES];
         struct perf start;
         int test_len = 0;
+        int max_threads = 0;
 
         /* Set default parameters */
         k = 8;
@@ -195,6 +280,8 @@ main(int argc, char *argv[])
                         nerrs = atoi(argv[++i]);
                 } else if (strcmp(argv[i], "-s") == 0) {
                         test_len = (int) parse_size_value(argv[++i]);
+                } else if (strcmp(argv[i], "-t") == 0) {
+                        max_threads = atoi(argv[++i]);
                 } else if (strcmp(argv[i], "-h") == 0) {
                         usage(argv[0]);
                         return 0;
@@ -323,6 +410,17 @@ main(int argc, char *argv[])
         printf("erasure_code_decode" TEST_TYPE_STR ": ");
         perf_print(start, (double) (test_len) * (k + nerrs));
 
+        if (max_threads > 0) {
+                check = ec_mt_perf(m, k, a, g_tbls, buffs, src_err_list, nerrs, temp_buffs,
+                                   test_len, max_threads);
+                if (check == BAD_MATRIX)
+                        printf("BAD MATRIX\n");
+                if (check != 0) {
+                        ret = check;
+                        goto exit;
+                }
+        }
+
         printf("done all: Pass\n");
 
         ret = 0;
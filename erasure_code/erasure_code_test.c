@@ -47,6 +47,11 @@
 #define MMAX TEST_SOURCES
 #define KMAX TEST_SOURCES
 
+// Long enough for ec_encode_data() to split len into tiles, with an odd tail
+#define LONG_TEST_LEN  (64 * 1024 + 32)
+#define LONG_TEST_ROWS 15
+#define LONG_TEST_KMAX 32
+
 #define EFENCE_TEST_MIN_SIZE 16
 #define EFENCE_TEST_MAX_SIZE EFENCE_TEST_MIN_SIZE + 0x100
 
@@ -107,6 +112,69 @@ dump_u8xu8(unsigned char *s, int k, int m)
         printf("\n");
 }
 
+// Check ec_encode_data() against ec_encode_data_base() over rows that use the
+// widest dot product kernels on long, tiled lengths
+static int
+long_encode_test(void)
+{
+        unsigned char *data[LONG_TEST_KMAX], *coding[LONG_TEST_ROWS], *ref[LONG_TEST_ROWS];
+        unsigned char *a, *g_tbls, *g_tbls_base;
+        const int ks[] = { 16, LONG_TEST_KMAX }, rs[] = { 7, 8, LONG_TEST_ROWS };
+        int i, j, ki, ri, k, rows, ret = -1;
+
+        memset(data, 0, sizeof(data));
+        memset(coding, 0, sizeof(coding));
+        memset(ref, 0, sizeof(ref));
+        a = malloc(LONG_TEST_ROWS * LONG_TEST_KMAX);
+        g_tbls = malloc(LONG_TEST_ROWS * LONG_TEST_KMAX * 32);
+        g_tbls_base = malloc(LONG_TEST_ROWS * LONG_TEST_KMAX * 32);
+        if (a == NULL || g_tbls == NULL || g_tbls_base == NULL)
+                goto exit;
+        for (i = 0; i < LONG_TEST_KMAX; i++)
+                if (posix_memalign((void **) &data[i], 64, LONG_TEST_LEN))
+                        goto exit;
+        for (i = 0; i < LONG_TEST_ROWS; i++)
+                if (posix_memalign((void **) &coding[i], 64, LONG_TEST_LEN) ||
+                    posix_memalign((void **) &ref[i], 64, LONG_TEST_LEN))
+                        goto exit;
+
+        for (i = 0; i < LONG_TEST_KMAX; i++)
+                for (j = 0; j < LONG_TEST_LEN; j++)
+                        data[i][j] = rand();
+
+        for (ki = 0; ki < (int) (sizeof(ks) / sizeof(ks[0])); ki++) {
+                k = ks[ki];
+                for (ri = 0; ri < (int) (sizeof(rs) / sizeof(rs[0])); ri++) {
+                        rows = rs[ri];
+                        for (i = 0; i < rows * k; i++)
+                                a[i] = rand();
+                        ec_init_tables(k, rows, a, g_tbls);
+                        ec_init_tables_base(k, rows, a, g_tbls_base);
+                        ec_encode_data(LONG_TEST_LEN, k, rows, g_tbls, data, coding);
+                        ec_encode_data_base(LONG_TEST_LEN, k, rows, g_tbls_base, data, ref);
+                        for (i = 0; i < rows; i++)
+                                if (memcmp(coding[i], ref[i], LONG_TEST_LEN)) {
+                                        printf("Fail long encode k=%d rows=%d row %d\n", k, rows,
+                                               i);
+                                        goto exit;
+                                }
+                }
+        }
+        ret = 0;
+
+exit:
+        for (i = 0; i < LONG_TEST_KMAX; i++)
+                aligned_free(data[i]);
+        for (i = 0; i < LONG_TEST_ROWS; i++) {
+                aligned_free(coding[i]);
+                aligned_free(ref[i]);
+        }
+        free(a);
+        free(g_tbls);
+        free(g_tbls_base);
+        return ret;
+}
+
 // Generate Random errors
 static void
 gen_err_list(unsigned char *src_err_list, unsigned char *src_in_err, int *pnerrs, int *pnsrcerrs,
@@ -789,6 +857,9 @@ main(int argc, char *argv[])
 #endif
         }
 
+        if (long_encode_test() != 0)
+                goto exit;
+
         printf("done EC tests: Pass\n");
         re = 0;
 
@@ -161,6 +161,7 @@ start_struct isal_zstream
 	field _flush,	2,	2
 	field _gzip_flag,	2,	2
 	field _hist_bits,	2,	2
+	field _strategy,	2,	2
 	field _internal_state,	_isal_zstate_size,	_isal_zstate_align
 end_struct isal_zstream
 
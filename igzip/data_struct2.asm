@@ -207,6 +207,7 @@ FIELD	_end_of_stream,	2,	2
 FIELD   _flush,		2,	2
 FIELD	_gzip_flag,	2,	2
 FIELD	_hist_bits,	2,	2
+FIELD	_strategy,	2,	2
 FIELD	_internal_state,	_isal_zstate_size,	_isal_zstate_align
 
 %assign _isal_zstream_size	_FIELD_OFFSET
@@ -20,19 +20,24 @@ encode_deflate_icf_base(struct deflate_icf *next_in, struct deflate_icf *end_in,
                         struct hufftables_icf *hufftables)
 {
         struct huff_code lsym, dsym;
+        struct BitBuf2 out;
 
-        while (next_in < end_in && !is_full(bb)) {
+        /* Work on a local copy, the output stores could otherwise alias bb */
+        out = *bb;
+
+        while (next_in < end_in && !is_full(&out)) {
                 lsym = hufftables->lit_len_table[next_in->lit_len];
                 dsym = hufftables->dist_lit_table[next_in->lit_dist];
 
                 // insert ll code, dist_code, and extra_bits
-                write_bits_unsafe(bb, lsym.code_and_extra, lsym.length);
-                write_bits_unsafe(bb, dsym.code, dsym.length);
-                write_bits_unsafe(bb, next_in->dist_extra, dsym.extra_bit_count);
-                flush_bits(bb);
+                write_bits_unsafe(&out, lsym.code_and_extra, lsym.length);
+                write_bits_unsafe(&out, dsym.code, dsym.length);
+                write_bits_unsafe(&out, next_in->dist_extra, dsym.extra_bit_count);
+                flush_bits(&out);
 
                 next_in++;
         }
 
+        *bb = out;
         return next_in;
 }
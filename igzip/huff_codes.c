@@ -1648,3 +1648,37 @@ create_hufftables_icf(struct BitBuf2 *bb, struct hufftables_icf *hufftables,
         expand_hufftables_icf(hufftables);
         return compressed_len;
 }
+
+uint64_t
+create_static_hufftables_icf(struct BitBuf2 *bb, struct hufftables_icf *hufftables,
+                             struct isal_mod_hist *hist, uint32_t end_of_block)
+{
+        uint32_t i;
+        uint64_t compressed_len = 3; /* The static header size */
+        uint32_t *ll_hist = hist->ll_hist;
+        uint32_t *d_hist = hist->d_hist;
+        struct huff_code *static_ll_codes = static_hufftables.lit_len_table;
+        struct huff_code *static_d_codes = static_hufftables.dist_table;
+
+        flatten_ll(hist->ll_hist);
+
+        // make sure EOB is present
+        if (ll_hist[256] == 0)
+                ll_hist[256] = 1;
+
+        for (i = 0; i <= 256; i++)
+                compressed_len += static_ll_codes[i].length * ll_hist[i];
+
+        for (; i < LIT_LEN; i++)
+                compressed_len +=
+                        (static_ll_codes[i].length + len_code_extra_bits[i - 257]) * ll_hist[i];
+
+        for (i = 0; i < DIST_LEN; i++)
+                compressed_len += (static_d_codes[i].length + dist_code_extra_bits[i]) * d_hist[i];
+
+        memcpy(hufftables, &static_hufftables, sizeof(struct hufftables_icf));
+        write_bits(bb, 0x2 | (end_of_block ? 1 : 0), 3);
+
+        expand_hufftables_icf(hufftables);
+        return compressed_len;
+}
@@ -86,6 +86,7 @@
 #define LVL1_HASH_MASK (IGZIP_LVL1_HASH_SIZE - 1)
 #define LVL2_HASH_MASK (IGZIP_LVL2_HASH_SIZE - 1)
 #define LVL3_HASH_MASK (IGZIP_LVL3_HASH_SIZE - 1)
+#define LVL4_HASH_MASK (IGZIP_LVL4_HASH_SIZE - 1)
 #define SHORTEST_MATCH 4
 
 #define LENGTH_BITS          5
@@ -183,4 +184,20 @@ uint64_t
 create_hufftables_icf(struct BitBuf2 *bb, struct hufftables_icf *hufftables,
                       struct isal_mod_hist *hist, uint32_t end_of_block);
 
+/**
+ * @brief Selects the fixed huffman code of the deflate standard to decompress
+ * the intermediate compression format and writes the matching block header.
+ *
+ * @param bb: bitbuf structure where the block header is written
+ * @param hufftables: output huffman code representation
+ * @param hist: histogram of the block used to compute its encoded length
+ * @param end_of_block: flag whether this is the final huffman code
+ *
+ * @returns Returns the length in bits of the block with histogram hist encoded
+ * with the fixed huffman code
+ */
+uint64_t
+create_static_hufftables_icf(struct BitBuf2 *bb, struct hufftables_icf *hufftables,
+                             struct isal_mod_hist *hist, uint32_t end_of_block);
+
 #endif
@@ -230,6 +230,9 @@ flush_icf_block(struct isal_zstream *stream)
 static int
 check_level_req(struct isal_zstream *stream)
 {
+        if (stream->strategy > ISAL_FIXED)
+                return INVALID_PARAM;
+
         if (stream->level == 0)
                 return 0;
 
@@ -237,6 +240,10 @@ check_level_req(struct isal_zstream *stream)
                 return ISAL_INVALID_LEVEL_BUF;
 
         switch (stream->level) {
+        case 4:
+                if (stream->level_buf_size < ISAL_DEF_LVL4_MIN)
+                        return ISAL_INVALID_LEVEL;
+                break;
         case 3:
                 if (stream->level_buf_size < ISAL_DEF_LVL3_MIN)
                         return ISAL_INVALID_LEVEL;
@@ -294,6 +301,7 @@ static int
 init_lvlX_buf(struct isal_zstream *stream)
 {
         switch (stream->level) {
+        case 4:
         case 3:
                 return init_hash_map_buf(stream);
         case 2:
@@ -343,6 +351,7 @@ are_buffers_empty(struct isal_zstream *stream)
 {
 
         switch (stream->level) {
+        case 4:
         case 3:
                 return are_buffers_empty_hash_map(stream);
         case 2:
@@ -403,8 +412,12 @@ create_icf_block_hdr(struct isal_zstream *stream, uint8_t *start_in)
                 buffer_header = 1;
         }
 
-        bit_count = create_hufftables_icf(write_buf, &level_buf->encode_tables, &level_buf->hist,
-                                          state->has_eob_hdr);
+        if (stream->strategy == ISAL_FIXED)
+                bit_count = create_static_hufftables_icf(write_buf, &level_buf->encode_tables,
+                                                         &level_buf->hist, state->has_eob_hdr);
+        else
+                bit_count = create_hufftables_icf(write_buf, &level_buf->encode_tables,
+                                                  &level_buf->hist, state->has_eob_hdr);
 
         /* Assumes that type 0 block has size less than 4G */
         block_start_offset = (stream->total_in - state->block_next);
@@ -475,7 +488,14 @@ isal_deflate_pass(struct isal_zstream *stream)
 static void
 isal_deflate_icf_finish(struct isal_zstream *stream)
 {
+        /* The strategy bodies need no look ahead and always consume all input */
+        if (stream->strategy == ISAL_HUFFMAN_ONLY || stream->strategy == ISAL_RLE) {
+                isal_deflate_icf_body(stream);
+                return;
+        }
+
         switch (stream->level) {
+        case 4:
         case 3:
                 isal_deflate_icf_finish_lvl3(stream);
                 break;
@@ -733,8 +753,9 @@ isal_deflate_int_stateless(struct isal_zstream *stream)
                 if (write_stream_header_stateless(stream))
                         return STATELESS_OVERFLOW;
 
-        if (stream->avail_in >= 8 && (load_native_u64(stream->next_in) == 0 ||
-                                      load_native_u64(stream->next_in) == ~(uint64_t) 0)) {
+        if (stream->avail_in >= 8 && stream->strategy != ISAL_HUFFMAN_ONLY &&
+            (load_native_u64(stream->next_in) == 0 ||
+             load_native_u64(stream->next_in) == ~(uint64_t) 0)) {
                 repeat_length = detect_repeated_char_length(stream->next_in, stream->avail_in);
 
                 if (stream->avail_in == repeat_length || repeat_length >= MIN_REPEAT_LEN)
@@ -886,6 +907,9 @@ reset_match_history(struct isal_zstream *stream)
         hash_table_size = 2 * (state->hash_mask + 1);
 
         switch (stream->level) {
+        case 4:
+                hash_table = level_buf->lvl4.hash_table;
+                break;
         case 3:
                 hash_table = level_buf->lvl3.hash_table;
                 break;
@@ -953,6 +977,9 @@ static void inline set_hash_mask(struct isal_zstream *stream)
         struct isal_zstate *state = &stream->internal_state;
 
         switch (stream->level) {
+        case 4:
+                state->hash_mask = LVL4_HASH_MASK;
+                break;
         case 3:
                 state->hash_mask = LVL3_HASH_MASK;
                 break;
@@ -982,6 +1009,7 @@ isal_deflate_init(struct isal_zstream *stream)
         stream->flush = NO_FLUSH;
         stream->gzip_flag = 0;
         stream->hist_bits = 0;
+        stream->strategy = ISAL_DEFAULT_STRATEGY;
 
         state->block_next = 0;
         state->block_end = 0;
@@ -1214,6 +1242,7 @@ isal_deflate_stateless_init(struct isal_zstream *stream)
         stream->flush = NO_FLUSH;
         stream->gzip_flag = 0;
         stream->hist_bits = 0;
+        stream->strategy = ISAL_DEFAULT_STRATEGY;
         stream->internal_state.has_wrap_hdr = 0;
         stream->internal_state.state = ZSTATE_NEW_HDR;
         return;
@@ -1228,6 +1257,11 @@ isal_deflate_hash(struct isal_zstream *stream, uint8_t *dict, uint32_t dict_len)
         uint32_t hash_mask = stream->internal_state.hash_mask;
 
         switch (stream->level) {
+        case 4:
+                memset(level_buf->lvl4.hash_table, -1, sizeof(level_buf->lvl4.hash_table));
+                isal_deflate_hash_lvl3(level_buf->lvl4.hash_table, hash_mask, stream->total_in,
+                                       dict, dict_len);
+                break;
         case 3:
                 memset(level_buf->lvl3.hash_table, -1, sizeof(level_buf->lvl3.hash_table));
                 isal_deflate_hash_lvl3(level_buf->lvl3.hash_table, hash_mask, stream->total_in,
@@ -1271,6 +1305,10 @@ isal_deflate_process_dict(struct isal_zstream *stream, struct isal_dict *dict, u
         memset(dict->hashtable, -1, sizeof(dict->hashtable));
 
         switch (stream->level) {
+        case 4:
+                dict->hash_size = IGZIP_LVL4_HASH_SIZE;
+                isal_deflate_hash_lvl3(dict->hashtable, LVL4_HASH_MASK, 0, dict_data, dict_len);
+                break;
         case 3:
                 dict->hash_size = IGZIP_LVL3_HASH_SIZE;
                 isal_deflate_hash_lvl3(dict->hashtable, LVL3_HASH_MASK, 0, dict_data, dict_len);
@@ -1314,6 +1352,10 @@ isal_deflate_reset_dict(struct isal_zstream *stream, struct isal_dict *dict)
         state->has_hist = IGZIP_DICT_HASH_SET;
 
         switch (stream->level) {
+        case 4:
+                memcpy(level_buf->lvl4.hash_table, dict->hashtable,
+                       sizeof(level_buf->lvl4.hash_table));
+                break;
         case 3:
                 memcpy(level_buf->lvl3.hash_table, dict->hashtable,
                        sizeof(level_buf->lvl3.hash_table));
@@ -1690,7 +1732,7 @@ isal_deflate(struct isal_zstream *stream)
         }
 
         /* Buffer input data if it is necessary for continued execution */
-        if (stream->avail_in > 0 && (stream->avail_out > 0 || stream->level == 3)) {
+        if (stream->avail_in > 0 && (stream->avail_out > 0 || stream->level >= 3)) {
                 /* Determine how much data to buffer */
                 future_size = sizeof(state->buffer) - state->b_bytes_valid;
                 if (stream->avail_in < future_size)
@@ -1731,8 +1773,10 @@ _zlib_header_in_buffer(struct isal_zstream *stream, uint8_t *buffer)
                 info = 0; // For low window sizes ensure correct cmf flag.
         if (stream->level == 0)
                 level = 0; // Fastest algorithm
-        else
+        else if (stream->level < 4)
                 level = 1; // ISA-L levels 1-3 are fast algorithms.
+        else
+                level = 3; // Level 4 is the slowest, best ratio algorithm.
 
         cmf = DEFLATE_METHOD | (info << 4);
         flg = (level << 6) | dict_flag;
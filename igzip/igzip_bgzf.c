@@ -0,0 +1,541 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_THREADS
+#include <pthread.h>
+#endif
+
+#include "igzip_lib.h"
+#include "unaligned.h"
+
+#define BGZF_TRAILER_LEN    8
+#define BGZF_INIT_ENTRIES   64
+#define BGZF_BSIZE_OFFSET   16
+#define BGZF_GZI_HDR_SIZE   8
+#define BGZF_GZI_ENTRY_SIZE 16
+
+/* gzip header with FEXTRA set and a single "BC" subfield, the member size
+ * minus one is stored in the last two bytes */
+static const uint8_t bgzf_hdr[ISAL_BGZF_HDR_SIZE] = { 0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00,
+                                                      0x00, 0x00, 0x00, 0xff, 0x06, 0x00,
+                                                      0x42, 0x43, 0x02, 0x00, 0x00, 0x00 };
+
+static const uint8_t bgzf_eof[ISAL_BGZF_EOF_SIZE] = {
+        0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00, 0x42, 0x43,
+        0x02, 0x00, 0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint32_t bgzf_level_buf_size[ISAL_DEF_MAX_LEVEL + 1] = {
+        ISAL_DEF_LVL0_DEFAULT,
+        ISAL_DEF_LVL1_DEFAULT,
+        ISAL_DEF_LVL2_DEFAULT,
+        ISAL_DEF_LVL3_DEFAULT,
+        ISAL_DEF_LVL4_DEFAULT,
+};
+
+struct isal_bgzf_entry {
+        uint64_t comp;   /* Offset of a member in the file */
+        uint64_t uncomp; /* Offset of its data in the uncompressed file */
+};
+
+struct isal_bgzf_index {
+        uint64_t count;
+        uint64_t size;
+        struct isal_bgzf_entry *entries;
+
+        /* End of the file written so far by isal_bgzf_compress() */
+        uint64_t comp_size;
+        uint64_t uncomp_size;
+};
+
+struct bgzf_block {
+        uint32_t len;
+        int ret;
+};
+
+struct bgzf_job {
+        struct isal_zstream *stream; /* Caller's stream, read only while jobs run */
+        uint8_t *in;
+        uint32_t in_len;
+        uint8_t *out; /* Block i is compressed at out + i * ISAL_BGZF_MAX_BLOCK */
+        uint32_t num_blocks;
+        struct bgzf_block *blocks;
+        uint32_t next_block;
+#ifdef HAVE_THREADS
+        pthread_mutex_t mutex;
+#endif
+};
+
+struct isal_bgzf_index *
+isal_bgzf_index_create(void)
+{
+        return calloc(1, sizeof(struct isal_bgzf_index));
+}
+
+void
+isal_bgzf_index_free(struct isal_bgzf_index *index)
+{
+        if (index == NULL)
+                return;
+
+        free(index->entries);
+        free(index);
+}
+
+/* Makes room for n more entries */
+static int
+bgzf_index_reserve(struct isal_bgzf_index *index, uint64_t n)
+{
+        struct isal_bgzf_entry *entries;
+        uint64_t size = index->size ? index->size : BGZF_INIT_ENTRIES;
+
+        if (index->count + n <= index->size)
+                return 0;
+
+        while (size < index->count + n)
+                size *= 2;
+
+        entries = realloc(index->entries, size * sizeof(*entries));
+        if (entries == NULL)
+                return ISAL_INVALID_STATE;
+
+        index->entries = entries;
+        index->size = size;
+        return 0;
+}
+
+static void
+bgzf_index_add(struct isal_bgzf_index *index, uint64_t comp, uint64_t uncomp)
+{
+        index->entries[index->count].comp = comp;
+        index->entries[index->count].uncomp = uncomp;
+        index->count++;
+}
+
+static int
+bgzf_get_block(struct bgzf_job *job, uint32_t *block)
+{
+        int ret = 0;
+
+#ifdef HAVE_THREADS
+        pthread_mutex_lock(&job->mutex);
+#endif
+        if (job->next_block < job->num_blocks) {
+                *block = job->next_block++;
+                ret = 1;
+        }
+#ifdef HAVE_THREADS
+        pthread_mutex_unlock(&job->mutex);
+#endif
+        return ret;
+}
+
+static int
+bgzf_deflate_block(struct bgzf_job *job, struct isal_zstream *s, uint8_t *level_buf,
+                   uint32_t block)
+{
+        uint8_t *out = job->out + (uint64_t) block * ISAL_BGZF_MAX_BLOCK;
+        uint32_t start = block * ISAL_BGZF_BLOCK_INPUT;
+        uint32_t len = job->in_len - start;
+        int ret;
+
+        if (len > ISAL_BGZF_BLOCK_INPUT)
+                len = ISAL_BGZF_BLOCK_INPUT;
+
+        isal_deflate_stateless_init(s);
+        s->level = job->stream->level;
+        s->level_buf = level_buf;
+        s->level_buf_size = bgzf_level_buf_size[s->level];
+        s->hist_bits = job->stream->hist_bits;
+        s->strategy = job->stream->strategy;
+        s->gzip_flag = IGZIP_GZIP_NO_HDR;
+        s->end_of_stream = 1;
+
+        if (job->stream->hufftables != NULL)
+                s->hufftables = job->stream->hufftables;
+
+        /* A stored member of ISAL_BGZF_BLOCK_INPUT bytes always fits */
+        s->next_in = job->in + start;
+        s->avail_in = len;
+        s->next_out = out + ISAL_BGZF_HDR_SIZE;
+        s->avail_out = ISAL_BGZF_MAX_BLOCK - ISAL_BGZF_HDR_SIZE;
+
+        ret = isal_deflate_stateless(s);
+        if (ret != COMP_OK)
+                return ret;
+
+        memcpy(out, bgzf_hdr, ISAL_BGZF_HDR_SIZE);
+        job->blocks[block].len = ISAL_BGZF_HDR_SIZE + s->total_out;
+        store_le_u16(out + BGZF_BSIZE_OFFSET, job->blocks[block].len - 1);
+
+        return COMP_OK;
+}
+
+static void *
+bgzf_worker(void *arg)
+{
+        struct bgzf_job *job = (struct bgzf_job *) arg;
+        struct isal_zstream *s;
+        uint8_t *level_buf = NULL;
+        uint32_t block;
+
+        s = malloc(sizeof(*s));
+        if (job->stream->level > 0)
+                level_buf = malloc(bgzf_level_buf_size[job->stream->level]);
+
+        while (bgzf_get_block(job, &block)) {
+                if (s == NULL || (job->stream->level > 0 && level_buf == NULL))
+                        job->blocks[block].ret = ISAL_INVALID_LEVEL_BUF;
+                else
+                        job->blocks[block].ret = bgzf_deflate_block(job, s, level_buf, block);
+        }
+
+        free(level_buf);
+        free(s);
+        return NULL;
+}
+
+int
+isal_bgzf_compress(struct isal_zstream *stream, uint32_t num_threads,
+                   struct isal_bgzf_index *index)
+{
+        struct bgzf_job job;
+        uint64_t total, bound;
+        uint32_t i, eof_len, block_in;
+        uint8_t *out, *tmp = NULL;
+        int ret = COMP_OK;
+#ifdef HAVE_THREADS
+        pthread_t *threads = NULL;
+        uint32_t started = 0;
+#endif
+
+        if (stream->level > ISAL_DEF_MAX_LEVEL)
+                return ISAL_INVALID_LEVEL;
+
+        if (stream->strategy > ISAL_FIXED)
+                return INVALID_PARAM;
+
+        if (num_threads == 0)
+                num_threads = 1;
+
+        eof_len = stream->end_of_stream ? ISAL_BGZF_EOF_SIZE : 0;
+        bound = ISAL_BGZF_BOUND(stream->avail_in) - ISAL_BGZF_EOF_SIZE + eof_len;
+
+        job.stream = stream;
+        job.in = stream->next_in;
+        job.in_len = stream->avail_in;
+        job.num_blocks = (job.in_len + ISAL_BGZF_BLOCK_INPUT - 1) / ISAL_BGZF_BLOCK_INPUT;
+        job.next_block = 0;
+
+        /* Compress in place when the output is large enough, as blocks only move down */
+        job.out = stream->next_out;
+        if (stream->avail_out < bound && job.num_blocks > 0) {
+                tmp = malloc((uint64_t) job.num_blocks * ISAL_BGZF_MAX_BLOCK);
+                if (tmp == NULL)
+                        return ISAL_INVALID_LEVEL_BUF;
+                job.out = tmp;
+        }
+
+        job.blocks = calloc(job.num_blocks + 1, sizeof(*job.blocks));
+        if (job.blocks == NULL || (index != NULL && bgzf_index_reserve(index, job.num_blocks))) {
+                ret = ISAL_INVALID_LEVEL_BUF;
+                goto end;
+        }
+
+        if (num_threads > job.num_blocks)
+                num_threads = job.num_blocks;
+
+#ifdef HAVE_THREADS
+        pthread_mutex_init(&job.mutex, NULL);
+        if (num_threads > 1)
+                threads = malloc((num_threads - 1) * sizeof(*threads));
+        if (threads != NULL)
+                for (started = 0; started < num_threads - 1; started++)
+                        if (pthread_create(&threads[started], NULL, bgzf_worker, &job))
+                                break;
+#endif
+
+        bgzf_worker(&job);
+
+#ifdef HAVE_THREADS
+        for (i = 0; i < started; i++)
+                pthread_join(threads[i], NULL);
+        free(threads);
+        pthread_mutex_destroy(&job.mutex);
+#endif
+
+        total = eof_len;
+        for (i = 0; i < job.num_blocks; i++) {
+                if (job.blocks[i].ret != COMP_OK && ret == COMP_OK)
+                        ret = job.blocks[i].ret;
+                total += job.blocks[i].len;
+        }
+
+        if (ret == COMP_OK && total > stream->avail_out)
+                ret = STATELESS_OVERFLOW;
+
+        if (ret != COMP_OK)
+                goto end;
+
+        out = stream->next_out;
+        for (i = 0; i < job.num_blocks; i++) {
+                memmove(out, job.out + (uint64_t) i * ISAL_BGZF_MAX_BLOCK, job.blocks[i].len);
+                out += job.blocks[i].len;
+
+                if (index == NULL)
+                        continue;
+
+                /* As in a .gzi file the first member is implied */
+                if (index->comp_size > 0)
+                        bgzf_index_add(index, index->comp_size, index->uncomp_size);
+                block_in = job.in_len - i * ISAL_BGZF_BLOCK_INPUT;
+                index->comp_size += job.blocks[i].len;
+                index->uncomp_size += block_in < ISAL_BGZF_BLOCK_INPUT ? block_in
+                                                                       : ISAL_BGZF_BLOCK_INPUT;
+        }
+
+        memcpy(out, bgzf_eof, eof_len);
+        out += eof_len;
+        if (index != NULL)
+                index->comp_size += eof_len;
+
+        stream->next_in += job.in_len;
+        stream->avail_in = 0;
+        stream->total_in += job.in_len;
+        stream->next_out = out;
+        stream->avail_out -= total;
+        stream->total_out += total;
+        if (stream->end_of_stream)
+                stream->internal_state.state = ZSTATE_END;
+
+end:
+        free(tmp);
+        free(job.blocks);
+        return ret;
+}
+
+/* Checks the member at in and returns its size in *len */
+static int
+bgzf_member_len(const uint8_t *in, uint64_t avail, uint32_t *len)
+{
+        uint8_t *buf = (uint8_t *) in;
+
+        if (avail < ISAL_BGZF_HDR_SIZE)
+                return ISAL_END_INPUT;
+
+        if (memcmp(buf, bgzf_hdr, 4) != 0 || memcmp(buf + 10, bgzf_hdr + 10, 6) != 0)
+                return ISAL_INVALID_WRAPPER;
+
+        *len = load_le_u16(buf + BGZF_BSIZE_OFFSET) + 1;
+        if (*len < ISAL_BGZF_HDR_SIZE + BGZF_TRAILER_LEN)
+                return ISAL_INVALID_WRAPPER;
+
+        if (*len > avail)
+                return ISAL_END_INPUT;
+
+        if (load_le_u32(buf + *len - 4) > ISAL_BGZF_MAX_BLOCK)
+                return ISAL_INVALID_WRAPPER;
+
+        return ISAL_DECOMP_OK;
+}
+
+int
+isal_bgzf_index_build(const uint8_t *in, uint64_t in_len, struct isal_bgzf_index *index)
+{
+        uint64_t pos = 0, uncomp = 0;
+        uint32_t len, isize;
+        int ret;
+
+        index->count = 0;
+        index->comp_size = 0;
+        index->uncomp_size = 0;
+
+        while (pos < in_len) {
+                ret = bgzf_member_len(in + pos, in_len - pos, &len);
+                if (ret != ISAL_DECOMP_OK)
+                        return ret;
+
+                isize = load_le_u32((uint8_t *) in + pos + len - 4);
+                if (isize > 0 && pos > 0) {
+                        if (bgzf_index_reserve(index, 1))
+                                return ISAL_INVALID_STATE;
+                        bgzf_index_add(index, pos, uncomp);
+                }
+
+                pos += len;
+                uncomp += isize;
+        }
+
+        index->comp_size = pos;
+        index->uncomp_size = uncomp;
+        return ISAL_DECOMP_OK;
+}
+
+/* Decompresses a member of isize bytes into out */
+static int
+bgzf_inflate_member(const uint8_t *in, uint32_t len, uint8_t *out, uint32_t isize)
+{
+        struct inflate_state state;
+
+        isal_inflate_init(&state);
+        state.next_in = (uint8_t *) in + ISAL_BGZF_HDR_SIZE;
+        state.avail_in = len - ISAL_BGZF_HDR_SIZE;
+        state.next_out = out;
+        state.avail_out = isize;
+        state.crc_flag = ISAL_GZIP_NO_HDR_VER;
+
+        return isal_inflate_stateless(&state);
+}
+
+int
+isal_bgzf_read_at(const struct isal_bgzf_index *index, const uint8_t *in, uint64_t in_len,
+                  uint64_t offset, uint8_t *out, uint64_t *len)
+{
+        uint64_t comp = 0, uncomp = 0, done = 0, skip, n;
+        uint64_t lo = 0, hi = index->count, mid;
+        uint8_t *scratch = NULL;
+        uint32_t member_len, isize;
+        int ret = ISAL_DECOMP_OK;
+
+        /* Last member starting at or before offset */
+        while (lo < hi) {
+                mid = lo + (hi - lo) / 2;
+                if (index->entries[mid].uncomp <= offset)
+                        lo = mid + 1;
+                else
+                        hi = mid;
+        }
+        if (lo > 0) {
+                comp = index->entries[lo - 1].comp;
+                uncomp = index->entries[lo - 1].uncomp;
+        }
+
+        while (done < *len && comp < in_len) {
+                ret = bgzf_member_len(in + comp, in_len - comp, &member_len);
+                if (ret != ISAL_DECOMP_OK)
+                        break;
+
+                isize = load_le_u32((uint8_t *) in + comp + member_len - 4);
+                if (offset < uncomp + isize) {
+                        skip = offset - uncomp;
+                        n = isize - skip;
+                        if (n > *len - done)
+                                n = *len - done;
+
+                        if (skip == 0 && n == isize) {
+                                ret = bgzf_inflate_member(in + comp, member_len, out + done,
+                                                          isize);
+                        } else {
+                                /* Member only partly in the range */
+                                if (scratch == NULL)
+                                        scratch = malloc(ISAL_BGZF_MAX_BLOCK);
+                                if (scratch == NULL) {
+                                        ret = ISAL_INVALID_STATE;
+                                        break;
+                                }
+                                ret = bgzf_inflate_member(in + comp, member_len, scratch, isize);
+                                memcpy(out + done, scratch + skip, n);
+                        }
+                        if (ret != ISAL_DECOMP_OK)
+                                break;
+
+                        done += n;
+                        offset += n;
+                }
+
+                comp += member_len;
+                uncomp += isize;
+        }
+
+        free(scratch);
+        *len = done;
+        return ret;
+}
+
+uint64_t
+isal_bgzf_index_size(const struct isal_bgzf_index *index)
+{
+        return BGZF_GZI_HDR_SIZE + index->count * BGZF_GZI_ENTRY_SIZE;
+}
+
+int
+isal_bgzf_index_save(const struct isal_bgzf_index *index, uint8_t *buf, uint64_t *len)
+{
+        uint64_t i, pos = BGZF_GZI_HDR_SIZE;
+
+        if (*len < isal_bgzf_index_size(index))
+                return ISAL_OUT_OVERFLOW;
+
+        store_le_u64(buf, index->count);
+        for (i = 0; i < index->count; i++) {
+                store_le_u64(buf + pos, index->entries[i].comp);
+                store_le_u64(buf + pos + 8, index->entries[i].uncomp);
+                pos += BGZF_GZI_ENTRY_SIZE;
+        }
+
+        *len = pos;
+        return ISAL_DECOMP_OK;
+}
+
+struct isal_bgzf_index *
+isal_bgzf_index_load(const uint8_t *data, uint64_t len)
+{
+        uint8_t *buf = (uint8_t *) data;
+        struct isal_bgzf_index *index;
+        struct isal_bgzf_entry *e;
+        uint64_t i, count, pos = BGZF_GZI_HDR_SIZE;
+
+        if (len < BGZF_GZI_HDR_SIZE)
+                return NULL;
+
+        count = load_le_u64(buf);
+        if (count > (len - BGZF_GZI_HDR_SIZE) / BGZF_GZI_ENTRY_SIZE)
+                return NULL;
+
+        index = isal_bgzf_index_create();
+        if (index == NULL || bgzf_index_reserve(index, count))
+                goto fail;
+
+        for (i = 0; i < count; i++) {
+                bgzf_index_add(index, load_le_u64(buf + pos), load_le_u64(buf + pos + 8));
+                pos += BGZF_GZI_ENTRY_SIZE;
+
+                e = &index->entries[i];
+                if (e->comp == 0 || (i > 0 && (e->comp <= e[-1].comp || e->uncomp < e[-1].uncomp)))
+                        goto fail;
+        }
+
+        return index;
+
+fail:
+        isal_bgzf_index_free(index);
+        return NULL;
+}
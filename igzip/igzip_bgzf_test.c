@@ -0,0 +1,333 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define MAX_TEST_SIZE (8 * ISAL_BGZF_BLOCK_INPUT + 4321)
+#define PATTERN_SIZE  (48 * 1024)
+#define MAX_THREADS   4
+#define READS         64
+
+static const uint32_t test_sizes[] = { 0, 1, 1000, ISAL_BGZF_BLOCK_INPUT, 3 * ISAL_BGZF_BLOCK_INPUT,
+                                       MAX_TEST_SIZE };
+
+/* Writes a file with one call, or two when split is set, into comp */
+static int
+compress_bgzf(uint8_t *in, uint32_t in_len, uint8_t *comp, uint32_t comp_size, int level,
+              uint32_t threads, int split, struct isal_bgzf_index *index, uint32_t *comp_len)
+{
+        struct isal_zstream stream;
+        uint32_t first = split ? (in_len / 2) / ISAL_BGZF_BLOCK_INPUT * ISAL_BGZF_BLOCK_INPUT : 0;
+        int ret;
+
+        isal_deflate_stateless_init(&stream);
+        stream.next_out = comp;
+        stream.avail_out = comp_size;
+        stream.level = level;
+
+        if (split) {
+                stream.next_in = in;
+                stream.avail_in = first;
+                ret = isal_bgzf_compress(&stream, threads, index);
+                if (ret != COMP_OK)
+                        return ret;
+        }
+
+        stream.next_in = in + first;
+        stream.avail_in = in_len - first;
+        stream.end_of_stream = 1;
+        ret = isal_bgzf_compress(&stream, threads, index);
+        *comp_len = stream.total_out;
+
+        if (ret == COMP_OK && (stream.total_in != in_len || stream.avail_in != 0)) {
+                printf("input not consumed\n");
+                return 1;
+        }
+        return ret;
+}
+
+/* Checks the member sizes, the BC subfields and the end of file marker */
+static int
+check_members(uint8_t *comp, uint32_t comp_len, uint32_t in_len)
+{
+        uint32_t pos = 0, len = 0, members = 0;
+        uint64_t isize = 0;
+
+        while (pos < comp_len) {
+                if (comp_len - pos < ISAL_BGZF_HDR_SIZE || comp[pos] != 0x1f ||
+                    comp[pos + 1] != 0x8b || comp[pos + 3] != 0x04 || comp[pos + 12] != 'B' ||
+                    comp[pos + 13] != 'C' || comp[pos + 14] != 2) {
+                        printf("bad member header at %u\n", pos);
+                        return 1;
+                }
+
+                len = (comp[pos + 16] | comp[pos + 17] << 8) + 1;
+                if (len > ISAL_BGZF_MAX_BLOCK || len > comp_len - pos) {
+                        printf("bad member size %u at %u\n", len, pos);
+                        return 1;
+                }
+
+                isize += comp[pos + len - 4] | comp[pos + len - 3] << 8 |
+                         comp[pos + len - 2] << 16 | (uint32_t) comp[pos + len - 1] << 24;
+                pos += len;
+                members++;
+        }
+
+        if (isize != in_len || len != ISAL_BGZF_EOF_SIZE ||
+            members != (in_len + ISAL_BGZF_BLOCK_INPUT - 1) / ISAL_BGZF_BLOCK_INPUT + 1) {
+                printf("bad members: count=%u isize=%lu\n", members, (unsigned long) isize);
+                return 1;
+        }
+        return 0;
+}
+
+static int
+check_index(struct isal_bgzf_index *written, uint8_t *comp, uint32_t comp_len)
+{
+        struct isal_bgzf_index *built, *loaded;
+        uint8_t *buf_w, *buf_b;
+        uint64_t len_w, len_b;
+        int ret, fail = 0;
+
+        built = isal_bgzf_index_create();
+        ret = isal_bgzf_index_build(comp, comp_len, built);
+        if (ret != ISAL_DECOMP_OK) {
+                printf("index build returned %d\n", ret);
+                isal_bgzf_index_free(built);
+                return 1;
+        }
+
+        len_w = isal_bgzf_index_size(written);
+        len_b = isal_bgzf_index_size(built);
+        buf_w = malloc(len_w);
+        buf_b = malloc(len_b);
+        if (buf_w == NULL || buf_b == NULL)
+                fail = 1;
+        else if (isal_bgzf_index_save(written, buf_w, &len_w) ||
+                 isal_bgzf_index_save(built, buf_b, &len_b) || len_w != len_b ||
+                 memcmp(buf_w, buf_b, len_w)) {
+                printf("built index differs from the written one\n");
+                fail = 1;
+        } else {
+                loaded = isal_bgzf_index_load(buf_w, len_w);
+                len_b = isal_bgzf_index_size(built);
+                if (loaded == NULL || isal_bgzf_index_save(loaded, buf_b, &len_b) ||
+                    len_b != len_w || memcmp(buf_w, buf_b, len_w)) {
+                        printf("index load mismatch\n");
+                        fail = 1;
+                }
+                isal_bgzf_index_free(loaded);
+        }
+
+        free(buf_w);
+        free(buf_b);
+        isal_bgzf_index_free(built);
+        return fail;
+}
+
+static int
+check_reads(struct isal_bgzf_index *index, uint8_t *in, uint32_t in_len, uint8_t *comp,
+            uint32_t comp_len, uint8_t *out)
+{
+        uint64_t offset, len, expect;
+        int i, ret;
+
+        for (i = 0; i < READS; i++) {
+                if (i == 0) {
+                        offset = 0;
+                        len = in_len + 100;
+                } else {
+                        offset = rand() % (in_len + 10);
+                        len = rand() % (i & 1 ? 2 * ISAL_BGZF_BLOCK_INPUT : 300);
+                }
+                expect = offset >= in_len ? 0 : in_len - offset;
+                if (expect > len)
+                        expect = len;
+
+                ret = isal_bgzf_read_at(index, comp, comp_len, offset, out, &len);
+                if (ret != ISAL_DECOMP_OK || len != expect ||
+                    (len > 0 && memcmp(out, in + offset, len))) {
+                        printf("read at %lu returned %d len=%lu expected %lu\n",
+                               (unsigned long) offset, ret, (unsigned long) len,
+                               (unsigned long) expect);
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+static int
+test_file(uint8_t *in, uint32_t in_len, uint8_t *comp, uint8_t *out, int level, uint32_t threads,
+          int split, int tight)
+{
+        struct isal_bgzf_index *index;
+        uint32_t comp_size = ISAL_BGZF_BOUND(in_len), comp_len;
+        int ret, fail = 0;
+
+        /* A tight output buffer makes the members go through a temporary buffer */
+        if (tight)
+                comp_size = in_len + in_len / 8 + 1024;
+
+        index = isal_bgzf_index_create();
+        if (index == NULL)
+                return 1;
+
+        ret = compress_bgzf(in, in_len, comp, comp_size, level, threads, split, index, &comp_len);
+        if (ret != COMP_OK) {
+                printf("bgzf compress returned %d\n", ret);
+                fail = 1;
+        }
+
+        if (!fail)
+                fail = check_members(comp, comp_len, in_len);
+        if (!fail)
+                fail = check_index(index, comp, comp_len);
+        if (!fail)
+                fail = check_reads(index, in, in_len, comp, comp_len, out);
+
+        isal_bgzf_index_free(index);
+        return fail;
+}
+
+static int
+test_errors(uint8_t *in, uint8_t *comp, uint8_t *out)
+{
+        struct isal_bgzf_index *index;
+        struct isal_zstream stream;
+        uint32_t comp_len;
+        uint64_t len;
+        int ret, fail = 0;
+
+        index = isal_bgzf_index_create();
+        compress_bgzf(in, 3 * ISAL_BGZF_BLOCK_INPUT, comp, ISAL_BGZF_BOUND(MAX_TEST_SIZE), 1, 1,
+                      0, index, &comp_len);
+
+        /* Truncated file */
+        if (isal_bgzf_index_build(comp, comp_len - 1, index) != ISAL_END_INPUT) {
+                printf("truncated file not detected\n");
+                fail++;
+        }
+
+        /* Corrupt member data */
+        comp[comp_len / 2] ^= 0x55;
+        isal_bgzf_index_build(comp, comp_len, index);
+        len = 3 * ISAL_BGZF_BLOCK_INPUT;
+        ret = isal_bgzf_read_at(index, comp, comp_len, 0, out, &len);
+        if (ret == ISAL_DECOMP_OK) {
+                printf("corrupt member not detected\n");
+                fail++;
+        }
+        comp[comp_len / 2] ^= 0x55;
+
+        /* Not BGZF */
+        comp[13] = 'D';
+        if (isal_bgzf_index_build(comp, comp_len, index) != ISAL_INVALID_WRAPPER) {
+                printf("bad header not detected\n");
+                fail++;
+        }
+        comp[13] = 'C';
+
+        /* Output buffer too small */
+        isal_deflate_stateless_init(&stream);
+        stream.next_in = in;
+        stream.avail_in = MAX_TEST_SIZE;
+        stream.next_out = comp;
+        stream.avail_out = 1024;
+        stream.level = 1;
+        if (isal_bgzf_compress(&stream, MAX_THREADS, NULL) != STATELESS_OVERFLOW) {
+                printf("overflow not detected\n");
+                fail++;
+        }
+
+        stream.avail_out = ISAL_BGZF_BOUND(MAX_TEST_SIZE);
+        stream.level = ISAL_DEF_MAX_LEVEL + 1;
+        if (isal_bgzf_compress(&stream, MAX_THREADS, NULL) != ISAL_INVALID_LEVEL) {
+                printf("invalid level not detected\n");
+                fail++;
+        }
+
+        isal_bgzf_index_free(index);
+        return fail;
+}
+
+int
+main(int argc, char *argv[])
+{
+        uint8_t *in, *comp, *out;
+        uint32_t s, threads;
+        int level, split, random, fail = 0;
+
+        printf("igzip_bgzf_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        in = malloc(MAX_TEST_SIZE);
+        comp = malloc(ISAL_BGZF_BOUND(MAX_TEST_SIZE));
+        out = malloc(MAX_TEST_SIZE + 100);
+        if (in == NULL || comp == NULL || out == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+
+        for (random = 0; random <= 1; random++) {
+                // Compressible data with some long range repeats, or random data
+                make_test_data(in, MAX_TEST_SIZE, random ? 0 : PATTERN_SIZE, 255);
+                for (level = ISAL_DEF_MIN_LEVEL; level <= ISAL_DEF_MAX_LEVEL; level++) {
+                        for (s = 0; s < sizeof(test_sizes) / sizeof(test_sizes[0]); s++) {
+                                for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+                                        split = threads == 2;
+                                        fail += test_file(in, test_sizes[s], comp, out, level,
+                                                          threads, split, !random && threads == 4);
+                                        if (fail) {
+                                                printf("Fail level=%d size=%u threads=%u "
+                                                       "random=%d\n",
+                                                       level, test_sizes[s], threads, random);
+                                                goto exit;
+                                        }
+                                }
+                        }
+                        printf(".");
+                        fflush(0);
+                }
+        }
+
+        fail += test_errors(in, comp, out);
+
+exit:
+        printf("\nigzip_bgzf_test: %s\n", fail ? "Fail" : "Pass");
+        free(in);
+        free(comp);
+        free(out);
+        return fail;
+}
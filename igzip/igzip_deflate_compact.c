@@ -0,0 +1,285 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "igzip_lib.h"
+#include "igzip_level_buf_structs.h"
+#include "bitbuf2.h"
+#include "huff_codes.h"
+
+extern void
+isal_deflate_hash_lvl0(uint16_t *, uint32_t, uint32_t, uint8_t *, uint32_t);
+extern void
+isal_deflate_hash_lvl1(uint16_t *, uint32_t, uint32_t, uint8_t *, uint32_t);
+extern void
+isal_deflate_hash_lvl2(uint16_t *, uint32_t, uint32_t, uint8_t *, uint32_t);
+extern void
+isal_deflate_hash_lvl3(uint16_t *, uint32_t, uint32_t, uint8_t *, uint32_t);
+
+/* The parts of isal_zstream a stream needs between calls. window holds the last win_len bytes of
+ * history, which are rehashed on load. */
+struct isal_deflate_compact {
+        uint64_t bits;
+        uint32_t bit_count;
+        uint32_t total_in;
+        uint32_t total_out;
+        struct isal_hufftables *hufftables;
+        uint32_t level;
+        uint16_t gzip_flag;
+        uint16_t hist_bits;
+        uint16_t strategy;
+        uint32_t total_in_start;
+        uint32_t block_next;
+        uint32_t block_end;
+        uint32_t zstate;
+        uint32_t crc;
+        uint8_t has_wrap_hdr;
+        uint8_t has_eob_hdr;
+        uint8_t has_eob;
+        uint8_t tmp_out_buff[16];
+        uint32_t tmp_out_start;
+        uint32_t tmp_out_end;
+        uint32_t win_len;
+        uint32_t size;
+        uint8_t window[];
+};
+
+/* Returns 1 if nothing but the bit buffer, counters and history is needed to continue */
+static int
+compact_stream_at_boundary(struct isal_zstream *stream)
+{
+        struct isal_zstate *state = &stream->internal_state;
+        struct level_buf *level_buf = (struct level_buf *) stream->level_buf;
+
+        switch (state->state) {
+        case ZSTATE_NEW_HDR:
+        case ZSTATE_TMP_NEW_HDR:
+        case ZSTATE_END:
+        case ZSTATE_TMP_END:
+                break;
+        default:
+                return 0;
+        }
+
+        if (state->b_bytes_valid != state->b_bytes_processed || state->count != 0)
+                return 0;
+
+        if (stream->level >= 3 && state->has_level_buf_init &&
+            level_buf->hash_map.matches_next < level_buf->hash_map.matches_end)
+                return 0;
+
+        return 1;
+}
+
+static int
+compact_check_level_buf(struct isal_zstream *stream, uint32_t level)
+{
+        uint32_t min_size[] = { 0, ISAL_DEF_LVL1_MIN, ISAL_DEF_LVL2_MIN, ISAL_DEF_LVL3_MIN,
+                                ISAL_DEF_LVL4_MIN };
+
+        if (level == 0)
+                return COMP_OK;
+        if (level > ISAL_DEF_MAX_LEVEL)
+                return ISAL_INVALID_LEVEL;
+        if (stream->level_buf == NULL)
+                return ISAL_INVALID_LEVEL_BUF;
+        if (stream->level_buf_size < min_size[level])
+                return ISAL_INVALID_LEVEL;
+
+        return COMP_OK;
+}
+
+/* Hashes the history into the scratch hash table. Like reset_match_history() the entries not
+ * set by the history point at its start, so no match candidate reaches before the window. */
+static void
+compact_rehash(struct isal_zstream *stream)
+{
+        struct isal_zstate *state = &stream->internal_state;
+        struct level_buf *level_buf = (struct level_buf *) stream->level_buf;
+        uint16_t *hash_table, start = (uint16_t) (stream->total_in - state->b_bytes_processed);
+        uint32_t hash_mask, i;
+
+        switch (stream->level) {
+        case 4:
+                hash_table = level_buf->lvl4.hash_table;
+                hash_mask = LVL4_HASH_MASK;
+                break;
+        case 3:
+                hash_table = level_buf->lvl3.hash_table;
+                hash_mask = LVL3_HASH_MASK;
+                break;
+        case 2:
+                hash_table = level_buf->lvl2.hash_table;
+                hash_mask = LVL2_HASH_MASK;
+                break;
+        case 1:
+                hash_table = level_buf->lvl1.hash_table;
+                hash_mask = LVL1_HASH_MASK;
+                break;
+        default:
+                hash_table = state->head;
+                hash_mask = LVL0_HASH_MASK;
+        }
+
+        for (i = 0; i <= hash_mask; i++)
+                hash_table[i] = start;
+
+        switch (stream->level) {
+        case 4:
+        case 3:
+                isal_deflate_hash_lvl3(hash_table, hash_mask, stream->total_in, state->buffer,
+                                       state->b_bytes_processed);
+                break;
+        case 2:
+                isal_deflate_hash_lvl2(hash_table, hash_mask, stream->total_in, state->buffer,
+                                       state->b_bytes_processed);
+                break;
+        case 1:
+                isal_deflate_hash_lvl1(hash_table, hash_mask, stream->total_in, state->buffer,
+                                       state->b_bytes_processed);
+                break;
+        default:
+                isal_deflate_hash_lvl0(hash_table, hash_mask, stream->total_in, state->buffer,
+                                       state->b_bytes_processed);
+        }
+
+        state->has_hist = IGZIP_DICT_HASH_SET;
+}
+
+int
+isal_deflate_compact_save(struct isal_zstream *stream, struct isal_deflate_compact **compact)
+{
+        struct isal_zstate *state = &stream->internal_state;
+        struct isal_deflate_compact *c;
+        uint32_t hist = IGZIP_HIST_SIZE, win_len = 0, size;
+
+        if (!compact_stream_at_boundary(stream))
+                return ISAL_INVALID_STATE;
+
+        if (state->has_hist != IGZIP_NO_HIST && state->state != ZSTATE_END &&
+            state->state != ZSTATE_TMP_END) {
+                if (stream->hist_bits && stream->hist_bits < ISAL_DEF_MAX_HIST_BITS &&
+                    (1 << stream->hist_bits) < hist)
+                        hist = 1 << stream->hist_bits;
+                win_len = state->b_bytes_processed;
+                if (win_len > hist)
+                        win_len = hist;
+        }
+
+        size = sizeof(*c) + win_len;
+        c = realloc(*compact, size);
+        if (c == NULL)
+                return ISAL_INVALID_STATE;
+        *compact = c;
+
+        c->bits = state->bitbuf.m_bits;
+        c->bit_count = state->bitbuf.m_bit_count;
+        c->total_in = stream->total_in;
+        c->total_out = stream->total_out;
+        c->hufftables = stream->hufftables;
+        c->level = stream->level;
+        c->gzip_flag = stream->gzip_flag;
+        c->hist_bits = stream->hist_bits;
+        c->strategy = stream->strategy;
+        c->total_in_start = state->total_in_start;
+        c->block_next = state->block_next;
+        c->block_end = state->block_end;
+        c->zstate = state->state;
+        c->crc = state->crc;
+        c->has_wrap_hdr = state->has_wrap_hdr;
+        c->has_eob_hdr = state->has_eob_hdr;
+        c->has_eob = state->has_eob;
+        memcpy(c->tmp_out_buff, state->tmp_out_buff, sizeof(c->tmp_out_buff));
+        c->tmp_out_start = state->tmp_out_start;
+        c->tmp_out_end = state->tmp_out_end;
+        c->win_len = win_len;
+        c->size = size;
+        memcpy(c->window, &state->buffer[state->b_bytes_processed - win_len], win_len);
+
+        return COMP_OK;
+}
+
+int
+isal_deflate_compact_load(struct isal_zstream *stream, const struct isal_deflate_compact *c)
+{
+        struct isal_zstate *state = &stream->internal_state;
+        int ret;
+
+        ret = compact_check_level_buf(stream, c->level);
+        if (ret)
+                return ret;
+
+        stream->total_in = c->total_in;
+        stream->total_out = c->total_out;
+        stream->hufftables = c->hufftables;
+        stream->level = c->level;
+        stream->gzip_flag = c->gzip_flag;
+        stream->hist_bits = c->hist_bits;
+        stream->strategy = c->strategy;
+
+        init(&state->bitbuf);
+        state->bitbuf.m_bits = c->bits;
+        state->bitbuf.m_bit_count = c->bit_count;
+        state->total_in_start = c->total_in_start;
+        state->block_next = c->block_next;
+        state->block_end = c->block_end;
+        state->state = (enum isal_zstate_state) c->zstate;
+        state->crc = c->crc;
+        state->has_wrap_hdr = c->has_wrap_hdr;
+        state->has_eob_hdr = c->has_eob_hdr;
+        state->has_eob = c->has_eob;
+        state->has_level_buf_init = 0;
+        state->count = 0;
+        memcpy(state->tmp_out_buff, c->tmp_out_buff, sizeof(state->tmp_out_buff));
+        state->tmp_out_start = c->tmp_out_start;
+        state->tmp_out_end = c->tmp_out_end;
+
+        memcpy(state->buffer, c->window, c->win_len);
+        state->b_bytes_valid = c->win_len;
+        state->b_bytes_processed = c->win_len;
+        state->has_hist = IGZIP_NO_HIST;
+        if (c->win_len)
+                compact_rehash(stream);
+
+        return COMP_OK;
+}
+
+uint32_t
+isal_deflate_compact_size(const struct isal_deflate_compact *compact)
+{
+        return compact->size;
+}
+
+void
+isal_deflate_compact_free(struct isal_deflate_compact *compact)
+{
+        free(compact);
+}
@@ -0,0 +1,219 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define NUM_STREAMS  8
+#define NUM_MSGS     40
+#define MAX_MSG_SIZE (6 * 1024)
+#define TEST_SIZE    (NUM_MSGS * MAX_MSG_SIZE)
+#define COMP_SIZE    (2 * TEST_SIZE + 1024)
+
+struct test_stream {
+        uint8_t *in;
+        uint8_t *comp;
+        uint32_t in_len;
+        uint32_t comp_len;
+        uint32_t msg;
+        uint32_t last_msg_len;
+        uint32_t level;
+        uint16_t gzip_flag;
+        uint16_t hist_bits;
+        struct isal_deflate_compact *compact;
+};
+
+// Appends a message to a stream, half of them repeat the previous message
+static uint32_t
+make_msg(struct test_stream *s, uint32_t *repeat)
+{
+        uint32_t len = 1 + rand() % MAX_MSG_SIZE, i;
+        uint8_t *msg = s->in + s->in_len;
+
+        *repeat = s->last_msg_len >= 1024 && (rand() & 1);
+        if (*repeat) {
+                len = s->last_msg_len;
+                memcpy(msg, msg - len, len);
+        } else
+                for (i = 0; i < len; i++)
+                        msg[i] = 'a' + rand() % 8;
+
+        s->last_msg_len = len;
+        return len;
+}
+
+// Compresses one message of a stream, paging it in and out of the shared stream
+static int
+step(struct isal_zstream *stream, struct test_stream *s)
+{
+        uint32_t msg_len, repeat, out_start = s->comp_len;
+        int ret;
+
+        if (s->compact == NULL) {
+                isal_deflate_init(stream);
+                stream->level = s->level;
+                stream->gzip_flag = s->gzip_flag;
+                stream->hist_bits = s->hist_bits;
+        }
+        stream->level_buf = test_level_buf();
+        stream->level_buf_size = TEST_LEVEL_BUF_SIZE;
+        if (s->compact != NULL && isal_deflate_compact_load(stream, s->compact) != COMP_OK) {
+                printf("compact load failed\n");
+                return 1;
+        }
+
+        msg_len = make_msg(s, &repeat);
+        stream->next_in = s->in + s->in_len;
+        stream->avail_in = msg_len;
+        stream->next_out = s->comp + s->comp_len;
+        stream->avail_out = COMP_SIZE - s->comp_len;
+        stream->end_of_stream = (s->msg == NUM_MSGS - 1);
+        stream->flush = (s->msg % 8 == 7) ? FULL_FLUSH : SYNC_FLUSH;
+
+        ret = isal_deflate(stream);
+        if (ret != COMP_OK || stream->avail_in != 0) {
+                printf("deflate returned %d\n", ret);
+                return 1;
+        }
+
+        s->in_len += msg_len;
+        s->comp_len = stream->total_out;
+
+        // A repeated message must be coded as a match into the saved history, unless the
+        // previous message ended with a FULL_FLUSH
+        if (repeat && s->hist_bits == 0 && s->msg % 8 != 0 &&
+            s->comp_len - out_start > msg_len / 4) {
+                printf("repeated message of %d bytes took %d bytes\n", msg_len,
+                       s->comp_len - out_start);
+                return 1;
+        }
+        s->msg++;
+
+        if (isal_deflate_compact_save(stream, &s->compact) != COMP_OK) {
+                printf("compact save failed\n");
+                return 1;
+        }
+
+        return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+        struct test_stream streams[NUM_STREAMS];
+        struct isal_zstream stream;
+        struct isal_deflate_compact *compact = NULL;
+        uint16_t gzip_flags[] = { IGZIP_GZIP, IGZIP_ZLIB, IGZIP_DEFLATE };
+        uint32_t i, msg, max_size = 0;
+        uint8_t in[1024], *out;
+        int fail = 0;
+
+        printf("igzip_deflate_compact_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        out = malloc(TEST_SIZE);
+        if (out == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+
+        for (i = 0; i < NUM_STREAMS; i++) {
+                struct test_stream *s = &streams[i];
+
+                memset(s, 0, sizeof(*s));
+                s->in = malloc(TEST_SIZE);
+                s->comp = malloc(COMP_SIZE);
+                if (s->in == NULL || s->comp == NULL) {
+                        printf("alloc error: Fail\n");
+                        return -1;
+                }
+                s->level = i % (ISAL_DEF_MAX_LEVEL + 1);
+                s->gzip_flag = gzip_flags[i % 3];
+                s->hist_bits = (i == NUM_STREAMS - 1) ? 12 : 0;
+        }
+
+        // Interleave all streams through the one isal_zstream and level_buf
+        for (msg = 0; msg < NUM_MSGS; msg++) {
+                for (i = 0; i < NUM_STREAMS; i++) {
+                        fail += step(&stream, &streams[i]);
+                        if (fail) {
+                                printf("Fail stream %d msg %d\n", i, msg);
+                                goto exit;
+                        }
+                        if (isal_deflate_compact_size(streams[i].compact) > max_size)
+                                max_size = isal_deflate_compact_size(streams[i].compact);
+                }
+        }
+
+        for (i = 0; i < NUM_STREAMS; i++) {
+                if (test_inflate_check(streams[i].in, streams[i].in_len, streams[i].comp,
+                                       streams[i].comp_len, out, TEST_SIZE, streams[i].gzip_flag,
+                                       streams[i].hist_bits)) {
+                        printf("Fail stream %d: data mismatch\n", i);
+                        fail++;
+                        goto exit;
+                }
+        }
+
+        if (max_size > ISAL_DEF_HIST_SIZE + 256) {
+                printf("Fail compact size %d\n", max_size);
+                fail++;
+                goto exit;
+        }
+        printf("largest compact stream %d bytes\n", max_size);
+
+        // A stream in the middle of a block can not be saved
+        memset(in, 'a', sizeof(in));
+        isal_deflate_init(&stream);
+        stream.next_in = in;
+        stream.avail_in = sizeof(in);
+        stream.next_out = out;
+        stream.avail_out = TEST_SIZE;
+        if (isal_deflate(&stream) != COMP_OK ||
+            isal_deflate_compact_save(&stream, &compact) != ISAL_INVALID_STATE) {
+                printf("Fail save of a stream inside a block\n");
+                fail++;
+        }
+
+exit:
+        printf("igzip_deflate_compact_test: %s\n", fail ? "Fail" : "Pass");
+        for (i = 0; i < NUM_STREAMS; i++) {
+                free(streams[i].in);
+                free(streams[i].comp);
+                isal_deflate_compact_free(streams[i].compact);
+        }
+        isal_deflate_compact_free(compact);
+        free(out);
+        return fail;
+}
@@ -0,0 +1,336 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_THREADS
+#include <pthread.h>
+#endif
+
+#include "igzip_lib.h"
+#include "crc.h"
+#include "igzip_wrapper.h"
+#include "unaligned.h"
+
+#define PAR_MIN_CHUNK_SIZE (256 * IGZIP_K)
+#define PAR_MAX_CHUNK_SIZE (4 * IGZIP_K * IGZIP_K)
+#define PAR_OUT_SLACK      (4 * IGZIP_K)
+
+static const uint32_t par_level_buf_size[ISAL_DEF_MAX_LEVEL + 1] = {
+        ISAL_DEF_LVL0_DEFAULT,
+        ISAL_DEF_LVL1_DEFAULT,
+        ISAL_DEF_LVL2_DEFAULT,
+        ISAL_DEF_LVL3_DEFAULT,
+        ISAL_DEF_LVL4_DEFAULT,
+};
+
+struct par_chunk {
+        uint8_t *out;
+        uint32_t out_size;
+        uint32_t out_len;
+        int ret;
+};
+
+struct par_job {
+        struct isal_zstream *stream; /* Caller's stream, read only while jobs run */
+        uint8_t *in;
+        uint32_t in_len;
+        uint32_t chunk_size;
+        uint32_t num_chunks;
+        struct par_chunk *chunks;
+        uint32_t next_chunk;
+#ifdef HAVE_THREADS
+        pthread_mutex_t mutex;
+#endif
+};
+
+static int
+par_get_chunk(struct par_job *job, uint32_t *chunk)
+{
+        int ret = 0;
+
+#ifdef HAVE_THREADS
+        pthread_mutex_lock(&job->mutex);
+#endif
+        if (job->next_chunk < job->num_chunks) {
+                *chunk = job->next_chunk++;
+                ret = 1;
+        }
+#ifdef HAVE_THREADS
+        pthread_mutex_unlock(&job->mutex);
+#endif
+        return ret;
+}
+
+/* Wrapper for a chunk: only the first chunk carries the stream header and
+ * only the last one carries the trailer, which is patched after the join */
+static uint16_t
+par_chunk_gzip_flag(struct isal_zstream *stream, uint32_t chunk, uint32_t num_chunks)
+{
+        uint16_t flag = stream->gzip_flag;
+        int first = (chunk == 0), last = (chunk == num_chunks - 1);
+
+        if (first && stream->internal_state.has_wrap_hdr) {
+                if (flag == IGZIP_GZIP)
+                        flag = IGZIP_GZIP_NO_HDR;
+                else if (flag == IGZIP_ZLIB)
+                        flag = IGZIP_ZLIB_NO_HDR;
+        }
+
+        if (first && last)
+                return flag;
+
+        switch (flag) {
+        case IGZIP_GZIP:
+        case IGZIP_GZIP_NO_HDR:
+                if (last)
+                        return IGZIP_GZIP_NO_HDR;
+                return first ? flag : IGZIP_DEFLATE;
+        case IGZIP_ZLIB:
+        case IGZIP_ZLIB_NO_HDR:
+                if (last)
+                        return IGZIP_ZLIB_NO_HDR;
+                return first ? flag : IGZIP_DEFLATE;
+        default:
+                return IGZIP_DEFLATE;
+        }
+}
+
+static int
+par_deflate_chunk(struct par_job *job, struct isal_zstream *s, uint8_t *level_buf, uint32_t chunk)
+{
+        struct par_chunk *c = &job->chunks[chunk];
+        uint32_t start = chunk * job->chunk_size;
+        uint32_t len = job->in_len - start;
+        int last = (chunk == job->num_chunks - 1);
+        int ret;
+        uint8_t *tmp;
+
+        if (len > job->chunk_size)
+                len = job->chunk_size;
+
+        isal_deflate_init(s);
+        s->level = job->stream->level;
+        s->level_buf = level_buf;
+        s->level_buf_size = par_level_buf_size[s->level];
+        s->hist_bits = job->stream->hist_bits;
+        s->strategy = job->stream->strategy;
+        s->gzip_flag = par_chunk_gzip_flag(job->stream, chunk, job->num_chunks);
+        s->flush = last ? NO_FLUSH : SYNC_FLUSH;
+        s->end_of_stream = last;
+
+        if (job->stream->hufftables != NULL)
+                s->hufftables = job->stream->hufftables;
+
+        /* Prime the window with the tail of the previous chunk */
+        if (start > 0) {
+                ret = isal_deflate_set_dict(s, job->in + start - ISAL_DEF_HIST_SIZE,
+                                            ISAL_DEF_HIST_SIZE);
+                if (ret != COMP_OK)
+                        return ret;
+        }
+
+        c->out_size = len + len / 16 + PAR_OUT_SLACK;
+        c->out = malloc(c->out_size);
+        if (c->out == NULL)
+                return ISAL_INVALID_LEVEL_BUF;
+
+        s->next_in = job->in + start;
+        s->avail_in = len;
+        s->next_out = c->out;
+        s->avail_out = c->out_size;
+
+        do {
+                ret = isal_deflate(s);
+                if (ret != COMP_OK)
+                        return ret;
+
+                if (last ? s->internal_state.state == ZSTATE_END : s->avail_out != 0)
+                        break;
+
+                /* Incompressible chunk, grow the output and continue */
+                tmp = realloc(c->out, 2 * c->out_size);
+                if (tmp == NULL)
+                        return ISAL_INVALID_LEVEL_BUF;
+                c->out = tmp;
+                s->next_out = c->out + s->total_out;
+                s->avail_out = 2 * c->out_size - s->total_out;
+                c->out_size *= 2;
+        } while (1);
+
+        c->out_len = s->total_out;
+        return COMP_OK;
+}
+
+static void *
+par_worker(void *arg)
+{
+        struct par_job *job = (struct par_job *) arg;
+        struct isal_zstream *s;
+        uint8_t *level_buf = NULL;
+        uint32_t chunk;
+
+        s = malloc(sizeof(*s));
+        if (job->stream->level > 0)
+                level_buf = malloc(par_level_buf_size[job->stream->level]);
+
+        while (par_get_chunk(job, &chunk)) {
+                if (s == NULL || (job->stream->level > 0 && level_buf == NULL))
+                        job->chunks[chunk].ret = ISAL_INVALID_LEVEL_BUF;
+                else
+                        job->chunks[chunk].ret = par_deflate_chunk(job, s, level_buf, chunk);
+        }
+
+        free(level_buf);
+        free(s);
+        return NULL;
+}
+
+static uint32_t
+par_checksum(struct isal_zstream *stream, uint8_t *in, uint32_t len)
+{
+        switch (stream->gzip_flag) {
+        case IGZIP_GZIP:
+        case IGZIP_GZIP_NO_HDR:
+                return crc32_gzip_refl(0, in, len);
+        case IGZIP_ZLIB:
+        case IGZIP_ZLIB_NO_HDR:
+                return isal_adler32(1, in, len);
+        default:
+                return 0;
+        }
+}
+
+int
+isal_deflate_parallel(struct isal_zstream *stream, uint32_t num_threads)
+{
+        struct par_job job;
+        uint32_t i, total, checksum;
+        uint8_t *out;
+        int ret = COMP_OK;
+#ifdef HAVE_THREADS
+        pthread_t *threads = NULL;
+        uint32_t started = 0;
+#endif
+
+        if (stream->level > ISAL_DEF_MAX_LEVEL)
+                return ISAL_INVALID_LEVEL;
+
+        if (stream->strategy > ISAL_FIXED)
+                return INVALID_PARAM;
+
+        if (num_threads == 0)
+                num_threads = 1;
+
+        job.stream = stream;
+        job.in = stream->next_in;
+        job.in_len = stream->avail_in;
+        job.chunk_size = (stream->avail_in + num_threads - 1) / num_threads;
+        if (job.chunk_size < PAR_MIN_CHUNK_SIZE)
+                job.chunk_size = PAR_MIN_CHUNK_SIZE;
+        if (job.chunk_size > PAR_MAX_CHUNK_SIZE)
+                job.chunk_size = PAR_MAX_CHUNK_SIZE;
+        job.num_chunks = (job.in_len + job.chunk_size - 1) / job.chunk_size;
+        if (job.num_chunks == 0)
+                job.num_chunks = 1;
+        job.next_chunk = 0;
+
+        job.chunks = calloc(job.num_chunks, sizeof(*job.chunks));
+        if (job.chunks == NULL)
+                return ISAL_INVALID_LEVEL_BUF;
+
+        if (num_threads > job.num_chunks)
+                num_threads = job.num_chunks;
+
+#ifdef HAVE_THREADS
+        pthread_mutex_init(&job.mutex, NULL);
+        if (num_threads > 1)
+                threads = malloc((num_threads - 1) * sizeof(*threads));
+        if (threads != NULL)
+                for (started = 0; started < num_threads - 1; started++)
+                        if (pthread_create(&threads[started], NULL, par_worker, &job))
+                                break;
+#endif
+
+        /* The trailer checksum overlaps with the workers compressing */
+        checksum = par_checksum(stream, job.in, job.in_len);
+        par_worker(&job);
+
+#ifdef HAVE_THREADS
+        for (i = 0; i < started; i++)
+                pthread_join(threads[i], NULL);
+        free(threads);
+        pthread_mutex_destroy(&job.mutex);
+#endif
+
+        total = 0;
+        for (i = 0; i < job.num_chunks; i++) {
+                if (job.chunks[i].ret != COMP_OK && ret == COMP_OK)
+                        ret = job.chunks[i].ret;
+                total += job.chunks[i].out_len;
+        }
+
+        if (ret == COMP_OK && total > stream->avail_out)
+                ret = STATELESS_OVERFLOW;
+
+        if (ret == COMP_OK) {
+                out = stream->next_out;
+                for (i = 0; i < job.num_chunks; i++) {
+                        memcpy(out, job.chunks[i].out, job.chunks[i].out_len);
+                        out += job.chunks[i].out_len;
+                }
+
+                switch (stream->gzip_flag) {
+                case IGZIP_GZIP:
+                case IGZIP_GZIP_NO_HDR:
+                        store_le_u32(out - GZIP_TRAILER_LEN, checksum);
+                        store_le_u32(out - GZIP_TRAILER_LEN + 4, stream->total_in + job.in_len);
+                        break;
+                case IGZIP_ZLIB:
+                case IGZIP_ZLIB_NO_HDR:
+                        store_be_u32(out - ZLIB_TRAILER_LEN, checksum);
+                        break;
+                }
+
+                stream->next_in += job.in_len;
+                stream->avail_in = 0;
+                stream->total_in += job.in_len;
+                stream->next_out = out;
+                stream->avail_out -= total;
+                stream->total_out += total;
+                stream->internal_state.has_wrap_hdr = 1;
+                stream->internal_state.state = ZSTATE_END;
+        }
+
+        for (i = 0; i < job.num_chunks; i++)
+                free(job.chunks[i].out);
+        free(job.chunks);
+
+        return ret;
+}
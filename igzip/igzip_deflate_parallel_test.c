@@ -0,0 +1,141 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define MAX_TEST_SIZE (1536 * 1024 + 123)
+#define PATTERN_SIZE  (48 * 1024)
+#define MAX_THREADS   4
+
+static const uint32_t test_sizes[] = { 0, 1, 1000, 300 * 1024 + 7, MAX_TEST_SIZE };
+static const uint16_t test_flags[] = { IGZIP_DEFLATE, IGZIP_GZIP, IGZIP_ZLIB, IGZIP_GZIP_NO_HDR };
+
+static int
+compress_parallel(uint8_t *in, uint32_t in_len, uint8_t *comp, uint32_t comp_size, int level,
+                  uint16_t gzip_flag, uint32_t threads, uint32_t *comp_len)
+{
+        struct isal_zstream stream;
+        int ret;
+
+        isal_deflate_stateless_init(&stream);
+        stream.next_in = in;
+        stream.avail_in = in_len;
+        stream.next_out = comp;
+        stream.avail_out = comp_size;
+        stream.level = level;
+        stream.gzip_flag = gzip_flag;
+
+        ret = isal_deflate_parallel(&stream, threads);
+        *comp_len = stream.total_out;
+        return ret;
+}
+
+int
+main(int argc, char *argv[])
+{
+        uint8_t *in, *comp, *out;
+        uint32_t comp_size = 2 * MAX_TEST_SIZE, comp_len, single_len;
+        uint32_t s, f, threads;
+        int level, ret, fail = 0;
+
+        printf("igzip_deflate_parallel_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        in = malloc(MAX_TEST_SIZE);
+        comp = malloc(comp_size);
+        out = malloc(MAX_TEST_SIZE);
+        if (in == NULL || comp == NULL || out == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+
+        make_test_data(in, MAX_TEST_SIZE, PATTERN_SIZE, 255);
+
+        for (level = ISAL_DEF_MIN_LEVEL; level <= ISAL_DEF_MAX_LEVEL; level++) {
+                for (s = 0; s < sizeof(test_sizes) / sizeof(test_sizes[0]); s++) {
+                        for (f = 0; f < sizeof(test_flags) / sizeof(test_flags[0]); f++) {
+                                for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+                                        ret = compress_parallel(in, test_sizes[s], comp, comp_size,
+                                                                level, test_flags[f], threads,
+                                                                &comp_len);
+                                        if (ret != COMP_OK) {
+                                                printf("deflate returned %d\n", ret);
+                                                fail++;
+                                        } else
+                                                fail += test_inflate_check(
+                                                        in, test_sizes[s], comp, comp_len, out,
+                                                        MAX_TEST_SIZE, test_flags[f], 0);
+                                        if (fail) {
+                                                printf("Fail level=%d size=%u flag=%d threads=%u\n",
+                                                       level, test_sizes[s], test_flags[f],
+                                                       threads);
+                                                goto exit;
+                                        }
+                                }
+                        }
+                }
+                printf(".");
+                fflush(0);
+        }
+
+        /* Chunks primed with history should compress close to a single stream */
+        for (level = ISAL_DEF_MIN_LEVEL; level <= ISAL_DEF_MAX_LEVEL; level++) {
+                single_len = test_compress(in, MAX_TEST_SIZE, comp, comp_size, level,
+                                           IGZIP_DEFLATE);
+                compress_parallel(in, MAX_TEST_SIZE, comp, comp_size, level, IGZIP_DEFLATE,
+                                  MAX_THREADS, &comp_len);
+                if (single_len == 0 || comp_len > single_len + single_len / 8) {
+                        printf("Fail ratio level=%d single=%u parallel=%u\n", level, single_len,
+                               comp_len);
+                        fail++;
+                        goto exit;
+                }
+        }
+
+        /* Output buffer too small */
+        ret = compress_parallel(in, MAX_TEST_SIZE, comp, 1024, 1, IGZIP_GZIP, MAX_THREADS,
+                                &comp_len);
+        if (ret != STATELESS_OVERFLOW) {
+                printf("Fail overflow not detected\n");
+                fail++;
+        }
+
+exit:
+        printf("\nigzip_deflate_parallel_test: %s\n", fail ? "Fail" : "Pass");
+        free(in);
+        free(comp);
+        free(out);
+        return fail;
+}
@@ -101,7 +101,8 @@ usage(void)
                         "  -i <time> time in seconds to benchmark (at least 0)\n"
                         "  -o <file> output file for compressed data\n"
                         "  -d <file> dictionary file used by compression\n"
-                        "  -w <size> log base 2 size of history window, between 8 and 15\n");
+                        "  -w <size> log base 2 size of history window, between 8 and 15\n"
+                        "  -s <type> deflate strategy, 0 default, 1 huffman only, 2 rle, 3 fixed\n");
 
         exit(1);
 }
@@ -109,8 +110,8 @@ usage(void)
 void
 deflate_perf(struct isal_zstream *stream, uint8_t *inbuf, size_t infile_size, size_t inbuf_size,
              uint8_t *outbuf, size_t outbuf_size, int level, uint8_t *level_buf, int level_size,
-             uint32_t hist_bits, uint8_t *dictbuf, size_t dictfile_size, struct isal_dict *dict_str,
-             struct isal_hufftables *hufftables_custom)
+             uint32_t hist_bits, uint32_t strategy, uint8_t *dictbuf, size_t dictfile_size,
+             struct isal_dict *dict_str, struct isal_hufftables *hufftables_custom)
 {
         int avail_in;
         isal_deflate_init(stream);
@@ -130,6 +131,7 @@ deflate_perf(struct isal_zstream *stream, uint8_t *inbuf, size_t infile_size, si
         if (hufftables_custom != NULL)
                 stream->hufftables = hufftables_custom;
         stream->hist_bits = hist_bits;
+        stream->strategy = strategy;
         avail_in = infile_size;
 
         while (avail_in > 0) {
@@ -158,9 +160,10 @@ main(int argc, char *argv[])
         int level = 0, level_size = 0;
         char *in_file_name = NULL, *out_file_name = NULL, *dict_file_name = NULL;
         uint32_t hist_bits = 0;
+        uint32_t strategy = ISAL_DEFAULT_STRATEGY;
         struct isal_zstream stream;
 
-        while ((c = getopt(argc, argv, "h0123456789i:b:o:d:w:")) != -1) {
+        while ((c = getopt(argc, argv, "h0123456789i:b:o:d:w:s:")) != -1) {
                 if (c >= '0' && c <= '9') {
                         if (c > '0' + ISAL_DEF_MAX_LEVEL)
                                 usage();
@@ -191,6 +194,11 @@ main(int argc, char *argv[])
                         if (hist_bits > 15 || hist_bits < 8)
                                 usage();
                         break;
+                case 's':
+                        strategy = atoi(optarg);
+                        if (strategy > ISAL_FIXED)
+                                usage();
+                        break;
                 case 'h':
                 default:
                         usage();
@@ -310,12 +318,12 @@ main(int argc, char *argv[])
         if (time > 0) {
                 BENCHMARK(&start, time,
                           deflate_perf(&stream, inbuf, infile_size, inbuf_size, outbuf, outbuf_size,
-                                       level, level_buf, level_size, hist_bits, dictbuf,
+                                       level, level_buf, level_size, hist_bits, strategy, dictbuf,
                                        dictfile_size, &dict_str, NULL));
         } else {
                 deflate_perf(&stream, inbuf, infile_size, inbuf_size, outbuf, outbuf_size, level,
-                             level_buf, level_size, hist_bits, dictbuf, dictfile_size, &dict_str,
-                             NULL);
+                             level_buf, level_size, hist_bits, strategy, dictbuf, dictfile_size,
+                             &dict_str, NULL);
         }
         if (stream.avail_in != 0) {
                 fprintf(stderr, "Could not compress all of inbuf\n");
@@ -332,8 +340,8 @@ main(int argc, char *argv[])
                 isal_create_hufftables(&hufftables_custom, &histogram);
 
                 deflate_perf(&stream, inbuf, infile_size, inbuf_size, outbuf, outbuf_size, level,
-                             level_buf, level_size, hist_bits, dictbuf, dictfile_size, &dict_str,
-                             &hufftables_custom);
+                             level_buf, level_size, hist_bits, strategy, dictbuf, dictfile_size,
+                             &dict_str, &hufftables_custom);
 
                 printf(" ratio_custom=%3.1f%%", 100.0 * stream.total_out / infile_size);
         }
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "igzip_lib.h"
 #include "huffman.h"
 #include "encode_df.h"
@@ -230,6 +231,191 @@ compress_icf_map_g(struct isal_zstream *stream, struct deflate_icf *matches_next
         return matches_next;
 }
 
+/*
+*************************************************************
+* Optimal parse of provided match lookup table
+************************************************************
+*/
+/* Costs are in 1/16 of a bit */
+#define OPT_COST_SHIFT 4
+#define OPT_MAX_CODE   15
+/* From a match at least this long only the full length is tried */
+#define OPT_LONG_MATCH 64
+
+struct opt_costs {
+        uint32_t lit[ISAL_DEF_LIT_SYMBOLS];
+        uint32_t len[ISAL_DEF_MAX_MATCH + 1];
+        uint32_t dist[ISAL_DEF_DIST_SYMBOLS];
+};
+
+/* log2(x) in 1/16 of a bit for x > 0 */
+static inline uint32_t
+opt_log2(uint32_t x)
+{
+        static const uint8_t frac[16] = { 0, 1, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 15 };
+        uint32_t msb = bsr(x) - 1;
+        uint32_t m = (msb >= 4) ? x >> (msb - 4) : x << (4 - msb);
+
+        return (msb << OPT_COST_SHIFT) + frac[m & 0xf];
+}
+
+/* Estimated code length of a symbol seen count times out of total */
+static inline uint32_t
+opt_sym_cost(uint32_t count, uint32_t total_log2)
+{
+        uint32_t cost = total_log2 - opt_log2(count);
+
+        if (cost < (1 << OPT_COST_SHIFT))
+                cost = 1 << OPT_COST_SHIFT;
+        if (cost > (OPT_MAX_CODE << OPT_COST_SHIFT))
+                cost = OPT_MAX_CODE << OPT_COST_SHIFT;
+        return cost;
+}
+
+/* Length symbol index (0 to 28) and extra bits of a match length */
+static inline uint32_t
+opt_len_sym(uint32_t len, uint32_t *extra_bits)
+{
+        uint32_t n = len - ISAL_DEF_MIN_MATCH, extra;
+
+        *extra_bits = 0;
+        if (len == ISAL_DEF_MAX_MATCH)
+                return 28;
+        if (n < 8)
+                return n;
+
+        extra = bsr(n) - 3;
+        *extra_bits = extra;
+        return 4 * extra + 4 + ((n >> extra) & 3);
+}
+
+/* Prices symbols from the histogram of the block so far. Every symbol gets one extra count so
+ * that a new block starts from flat costs. */
+static void
+opt_set_costs(struct opt_costs *costs, struct isal_mod_hist *hist)
+{
+        uint32_t len_count[29], total = 0, total_log2, i, sym, extra;
+
+        memset(len_count, 0, sizeof(len_count));
+        for (i = ISAL_DEF_MIN_MATCH; i <= ISAL_DEF_MAX_MATCH; i++)
+                len_count[opt_len_sym(i, &extra)] += hist->ll_hist[i + LEN_OFFSET];
+
+        for (i = 0; i < ISAL_DEF_LIT_SYMBOLS; i++)
+                total += hist->ll_hist[i] + 1;
+        for (i = 0; i < 29; i++)
+                total += len_count[i] + 1;
+        total_log2 = opt_log2(total);
+
+        for (i = 0; i < ISAL_DEF_LIT_SYMBOLS; i++)
+                costs->lit[i] = opt_sym_cost(hist->ll_hist[i] + 1, total_log2);
+        for (i = ISAL_DEF_MIN_MATCH; i <= ISAL_DEF_MAX_MATCH; i++) {
+                sym = opt_len_sym(i, &extra);
+                costs->len[i] = opt_sym_cost(len_count[sym] + 1, total_log2) +
+                                (extra << OPT_COST_SHIFT);
+        }
+
+        total = 0;
+        for (i = 0; i < ISAL_DEF_DIST_SYMBOLS; i++)
+                total += hist->d_hist[i] + 1;
+        total_log2 = opt_log2(total);
+
+        for (i = 0; i < ISAL_DEF_DIST_SYMBOLS; i++) {
+                extra = (i < 4) ? 0 : (i >> 1) - 1;
+                costs->dist[i] = opt_sym_cost(hist->d_hist[i] + 1, total_log2) +
+                                 (extra << OPT_COST_SHIFT);
+        }
+}
+
+/* Parses the map from matches_next to matches_end with the least estimated cost. Each position
+ * may be coded as a literal or as its match cut to any length. Never passes matches_end. */
+static struct deflate_icf *
+compress_icf_map_opt(struct isal_zstream *stream, struct deflate_icf *matches_next,
+                     struct deflate_icf *matches_end)
+{
+        struct isal_zstate *state = &stream->internal_state;
+        struct level_buf *level_buf = (struct level_buf *) stream->level_buf;
+        struct deflate_icf *icf_buf_end =
+                level_buf->icf_buf_next + level_buf->icf_buf_avail_out / sizeof(struct deflate_icf);
+        uint32_t n = (uint32_t) (matches_end - matches_next);
+        uint8_t *in = stream->next_in - n;
+        uint32_t price[MATCH_BUF_SIZE + 1];
+        uint16_t step[MATCH_BUF_SIZE + 1];
+        struct opt_costs costs;
+        uint32_t i, j, len, max_len, code, lit_len, dist, extra, base, p;
+
+        if (n == 0)
+                return matches_next;
+
+        opt_set_costs(&costs, &level_buf->hist);
+
+        price[0] = 0;
+        for (i = 1; i <= n; i++)
+                price[i] = UINT32_MAX;
+
+        for (i = 0; i < n; i++) {
+                p = price[i] + costs.lit[in[i]];
+                if (p < price[i + 1]) {
+                        price[i + 1] = p;
+                        step[i + 1] = 1;
+                }
+
+                code = load_native_u32((uint8_t *) (matches_next + i));
+                lit_len = code & LIT_LEN_MASK;
+                if (lit_len < LEN_START)
+                        continue;
+
+                max_len = lit_len - LEN_OFFSET;
+                if (max_len > n - i)
+                        max_len = n - i;
+                if (max_len < ISAL_DEF_MIN_MATCH)
+                        continue;
+
+                dist = (code >> ICF_DIST_OFFSET) & DIST_LIT_MASK;
+                base = price[i] + costs.dist[dist];
+                len = (max_len >= OPT_LONG_MATCH) ? max_len : ISAL_DEF_MIN_MATCH;
+                for (; len <= max_len; len++) {
+                        p = base + costs.len[len];
+                        if (p < price[i + len]) {
+                                price[i + len] = p;
+                                step[i + len] = len;
+                        }
+                }
+        }
+
+        /* Walk back along the cheapest path, leaving the step to take from each position on it */
+        for (j = n; j > 0; j -= step[j])
+                price[j - step[j]] = step[j];
+
+        for (i = 0; i < n && level_buf->icf_buf_next < icf_buf_end; i += len) {
+                len = price[i];
+                if (len > 1) {
+                        code = load_native_u32((uint8_t *) (matches_next + i));
+                        dist = (code >> ICF_DIST_OFFSET) & DIST_LIT_MASK;
+                        extra = code >> (ICF_DIST_OFFSET + DIST_LIT_BIT_COUNT);
+                        write_deflate_icf(level_buf->icf_buf_next, len + LEN_OFFSET, dist, extra);
+                        level_buf->hist.ll_hist[len + LEN_OFFSET]++;
+                        level_buf->hist.d_hist[dist]++;
+                } else if (i + 1 < n && price[i + 1] == 1) {
+                        /* Two literals share one icf entry */
+                        write_deflate_icf(level_buf->icf_buf_next, in[i], in[i + 1] + LIT_START,
+                                          0);
+                        level_buf->hist.ll_hist[in[i]]++;
+                        level_buf->hist.ll_hist[in[i + 1]]++;
+                        len = 2;
+                } else {
+                        write_deflate_icf(level_buf->icf_buf_next, in[i], NULL_DIST_SYM, 0);
+                        level_buf->hist.ll_hist[in[i]]++;
+                }
+                level_buf->icf_buf_next++;
+        }
+
+        level_buf->icf_buf_avail_out =
+                (icf_buf_end - level_buf->icf_buf_next) * sizeof(struct deflate_icf);
+        state->block_end += i;
+
+        return matches_next + i;
+}
+
 /*
 *************************************************************
 * Compression functions combining different methods
@@ -330,10 +516,179 @@ icf_body_lazyhash1_fillgreedy_greedy(struct isal_zstream *stream)
         icf_body_next_state(stream);
 }
 
+void
+icf_body_hash1_fillgreedy_optimal(struct isal_zstream *stream)
+{
+        struct deflate_icf *matches_icf, *matches_next_icf, *matches_end_icf;
+        struct level_buf *level_buf = (struct level_buf *) stream->level_buf;
+        uint32_t input_size, processed;
+
+        matches_icf = level_buf->hash_map.matches;
+        matches_next_icf = level_buf->hash_map.matches_next;
+        matches_end_icf = level_buf->hash_map.matches_end;
+
+        matches_next_icf = compress_icf_map_opt(stream, matches_next_icf, matches_end_icf);
+
+        while (matches_next_icf >= matches_end_icf) {
+                input_size = MATCH_BUF_SIZE;
+                input_size = (input_size > stream->avail_in) ? stream->avail_in : input_size;
+
+                if (input_size <= ISAL_LOOK_AHEAD)
+                        break;
+
+                processed = gen_icf_map_lh1(stream, matches_icf, input_size);
+
+                set_long_icf_fg(stream->next_in, processed, input_size, matches_icf);
+
+                stream->next_in += processed;
+                stream->avail_in -= processed;
+                stream->total_in += processed;
+
+                matches_end_icf = matches_icf + processed;
+                matches_next_icf = compress_icf_map_opt(stream, matches_icf, matches_end_icf);
+        }
+
+        level_buf->hash_map.matches_next = matches_next_icf;
+        level_buf->hash_map.matches_end = matches_end_icf;
+
+        icf_body_next_state(stream);
+}
+
+/*
+*************************************************************
+* Strategy functions, these need no look ahead and consume all input
+************************************************************
+*/
+static inline void
+icf_strategy_next_state(struct isal_zstream *stream, uint8_t *next_in,
+                        struct deflate_icf *next_out, struct deflate_icf *end_out)
+{
+        struct level_buf *level_buf = (struct level_buf *) stream->level_buf;
+        struct isal_zstate *state = &stream->internal_state;
+        uint32_t processed = (uint32_t) (next_in - stream->next_in);
+
+        if (processed > 0)
+                state->has_hist = IGZIP_HIST;
+
+        stream->next_in = next_in;
+        stream->avail_in -= processed;
+        stream->total_in += processed;
+        state->block_end += processed;
+
+        level_buf->icf_buf_next = next_out;
+        level_buf->icf_buf_avail_out = (end_out - next_out) * sizeof(struct deflate_icf);
+
+        if (next_out >= end_out ||
+            (stream->avail_in == 0 && (stream->end_of_stream || stream->flush != NO_FLUSH)))
+                state->state = ZSTATE_CREATE_HDR;
+}
+
+static void
+icf_body_huffman_only(struct isal_zstream *stream)
+{
+        struct level_buf *level_buf = (struct level_buf *) stream->level_buf;
+        uint32_t *ll_hist = level_buf->hist.ll_hist;
+        uint8_t *next_in = stream->next_in;
+        uint8_t *end_in = next_in + stream->avail_in;
+        struct deflate_icf *next_out = level_buf->icf_buf_next;
+        struct deflate_icf *end_out =
+                next_out + level_buf->icf_buf_avail_out / sizeof(struct deflate_icf);
+        uint32_t lit, lit2;
+
+        /* Two literals share each icf entry */
+        while (next_in + 1 < end_in && next_out < end_out) {
+                lit = next_in[0];
+                lit2 = next_in[1];
+                ll_hist[lit]++;
+                ll_hist[lit2]++;
+                store_native_u32((uint8_t *) next_out,
+                                 ((lit2 + LIT_START) << ICF_DIST_OFFSET) | lit);
+                next_out++;
+                next_in += 2;
+        }
+
+        if (next_in < end_in && next_out < end_out) {
+                ll_hist[*next_in]++;
+                write_deflate_icf(next_out, *next_in, NULL_DIST_SYM, 0);
+                next_out++;
+                next_in++;
+        }
+
+        icf_strategy_next_state(stream, next_in, next_out, end_out);
+}
+
+static void
+icf_body_rle(struct isal_zstream *stream)
+{
+        struct level_buf *level_buf = (struct level_buf *) stream->level_buf;
+        uint32_t *ll_hist = level_buf->hist.ll_hist;
+        uint8_t *next_in = stream->next_in;
+        uint8_t *end_in = next_in + stream->avail_in;
+        struct deflate_icf *next_out = level_buf->icf_buf_next;
+        struct deflate_icf *end_out =
+                next_out + level_buf->icf_buf_avail_out / sizeof(struct deflate_icf);
+        struct deflate_icf *lit = NULL;
+        uint32_t run, code;
+
+        /* Without history the first byte cannot start a run */
+        if (stream->internal_state.has_hist == IGZIP_NO_HIST && next_in < end_in &&
+            next_out < end_out) {
+                ll_hist[*next_in]++;
+                write_deflate_icf(next_out, *next_in, NULL_DIST_SYM, 0);
+                lit = next_out;
+                next_out++;
+                next_in++;
+        }
+
+        while (next_in < end_in && next_out < end_out) {
+                if (next_in[0] == next_in[-1]) {
+                        run = compare258(next_in - 1, next_in, (uint32_t) (end_in - next_in));
+
+                        if (run >= SHORTEST_MATCH) {
+                                get_len_icf_code(run, &code);
+                                ll_hist[code]++;
+                                level_buf->hist.d_hist[0]++;
+                                write_deflate_icf(next_out, code, 0, 0);
+                                lit = NULL;
+                                next_out++;
+                                next_in += run;
+                                continue;
+                        }
+                }
+
+                /* Pair literals into one icf entry where possible */
+                ll_hist[*next_in]++;
+                if (lit != NULL) {
+                        lit->lit_dist = *next_in + LIT_START;
+                        lit = NULL;
+                } else {
+                        write_deflate_icf(next_out, *next_in, NULL_DIST_SYM, 0);
+                        lit = next_out;
+                        next_out++;
+                }
+                next_in++;
+        }
+
+        icf_strategy_next_state(stream, next_in, next_out, end_out);
+}
+
 void
 isal_deflate_icf_body(struct isal_zstream *stream)
 {
+        if (stream->strategy == ISAL_HUFFMAN_ONLY) {
+                icf_body_huffman_only(stream);
+                return;
+        }
+
+        if (stream->strategy == ISAL_RLE) {
+                icf_body_rle(stream);
+                return;
+        }
+
         switch (stream->level) {
+        case 4:
+                icf_body_hash1_fillgreedy_optimal(stream);
+                break;
         case 3:
                 isal_deflate_icf_body_lvl3(stream);
                 break;
@@ -28,6 +28,7 @@
 **********************************************************************/
 
 #include <stdint.h>
+#include <stdlib.h>
 #include "igzip_lib.h"
 #include "crc.h"
 #include "huff_codes.h"
@@ -82,6 +83,32 @@ extern struct isal_hufftables hufftables_default; /* For known header detection
 
 #define MIN_DEF_MATCH 3
 
+#define INFLATE_COPY_SIZE 16
+#define INFLATE_COPY_SLOP (2 * INFLATE_COPY_SIZE)
+
+/* The AVX-512 kernel is built from the same decode loop as the base kernel and is picked by the
+ * x86 multibinary dispatch on CPUs with the AVX512 update group. It only uses AVX512BW, which that
+ * group implies, so it does not depend on VBMI being exposed alongside it. */
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define INFLATE_AVX512
+#if defined(__GNUC__) || defined(__clang__)
+#define INFLATE_AVX512_TARGET                                                                      \
+        __attribute__((target("avx512f,avx512bw,avx512vl")))
+#define INFLATE_ALWAYS_INLINE static inline __attribute__((always_inline))
+#else
+#define INFLATE_AVX512_TARGET
+#define INFLATE_ALWAYS_INLINE static __forceinline
+#endif
+#else
+#define INFLATE_ALWAYS_INLINE static inline
+#endif
+
+/* Values of inflate_state.hdr_type */
+#define INFLATE_HDR_STATIC  1
+#define INFLATE_HDR_PREGEN  2
+#define INFLATE_HDR_DYNAMIC 3
+
 #define TRIPLE_SYM_FLAG  0
 #define DOUBLE_SYM_FLAG  TRIPLE_SYM_FLAG + 1
 #define SINGLE_SYM_FLAG  DOUBLE_SYM_FLAG + 1
@@ -131,6 +158,86 @@ static void inline byte_copy(uint8_t *dest, uint64_t lookback_distance, int repe
                 *dest++ = *src++;
 }
 
+/* Performs the same copy as byte_copy() INFLATE_COPY_SIZE bytes at a time. It may write up to
+ * INFLATE_COPY_SLOP bytes past dest + repeat_length. When the source and destination overlap the
+ * pattern is first doubled in place until one copy no longer reads bytes it writes. */
+static void inline fast_copy(uint8_t *dest, uint32_t lookback_distance, uint32_t repeat_length)
+{
+        uint8_t *src = dest - lookback_distance;
+        uint8_t *end = dest + repeat_length;
+        uint8_t tmp[INFLATE_COPY_SIZE];
+
+        while (dest - src < INFLATE_COPY_SIZE) {
+                memcpy(tmp, src, INFLATE_COPY_SIZE);
+                memcpy(dest, tmp, INFLATE_COPY_SIZE);
+                dest += dest - src;
+        }
+
+        for (; dest < end; dest += INFLATE_COPY_SIZE, src += INFLATE_COPY_SIZE)
+                memcpy(dest, src, INFLATE_COPY_SIZE);
+}
+
+#ifdef INFLATE_AVX512
+/* Mask of the first n bytes of a 64-byte vector, n <= 64 */
+INFLATE_AVX512_TARGET static inline __mmask64
+copy_mask(uint32_t n)
+{
+        return n >= 64 ? ~(__mmask64) 0 : ((__mmask64) 1 << n) - 1;
+}
+
+/* Returns v moved up by shift bytes, 0 < shift < 64, with the low bytes undefined. Whole words
+ * move with vpermw and an odd byte is taken from the neighbouring word. */
+INFLATE_AVX512_TARGET static inline __m512i
+shift_bytes_up(__m512i v, uint32_t shift)
+{
+        static const uint16_t iota[32] = { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10,
+                                           11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21,
+                                           22, 23, 24, 25, 26, 27, 28, 29, 30, 31 };
+        const __m512i idx = _mm512_sub_epi16(_mm512_loadu_si512(iota),
+                                             _mm512_set1_epi16((short) (shift / 2)));
+        __m512i w = _mm512_permutexvar_epi16(idx, v);
+
+        if (shift & 1) {
+                __m512i prev = _mm512_permutexvar_epi16(
+                        _mm512_sub_epi16(idx, _mm512_set1_epi16(1)), v);
+
+                w = _mm512_or_si512(_mm512_slli_epi16(w, 8), _mm512_srli_epi16(prev, 8));
+        }
+        return w;
+}
+
+/* Performs the same copy as byte_copy() 64 bytes at a time without writing past dest +
+ * repeat_length. When the source and destination overlap the lookback_distance byte pattern is
+ * first doubled in a register until it fills a vector, then stored at steps that keep its
+ * phase. */
+INFLATE_AVX512_TARGET static inline void
+avx512_copy(uint8_t *dest, uint32_t lookback_distance, uint32_t repeat_length)
+{
+        const uint8_t *src = dest - lookback_distance;
+        __m512i pattern;
+        uint32_t step, len;
+
+        if (lookback_distance >= 64) {
+                for (; repeat_length > 64; repeat_length -= 64, src += 64, dest += 64)
+                        _mm512_storeu_si512(dest, _mm512_loadu_si512(src));
+                _mm512_mask_storeu_epi8(
+                        dest, copy_mask(repeat_length),
+                        _mm512_maskz_loadu_epi8(copy_mask(repeat_length), src));
+                return;
+        }
+
+        pattern = _mm512_maskz_loadu_epi8(copy_mask(lookback_distance), src);
+        for (len = lookback_distance; len < 64; len *= 2)
+                pattern = _mm512_mask_mov_epi8(pattern, ~copy_mask(len),
+                                               shift_bytes_up(pattern, len));
+
+        step = 64 - 64 % lookback_distance;
+        for (; repeat_length > 64; repeat_length -= step, dest += step)
+                _mm512_storeu_si512(dest, pattern);
+        _mm512_mask_storeu_epi8(dest, copy_mask(repeat_length), pattern);
+}
+#endif
+
 static void
 update_checksum(struct inflate_state *state, uint8_t *start_in, uint64_t length)
 {
@@ -935,6 +1042,7 @@ setup_pregen_header(struct inflate_state *state)
         memcpy(&state->lit_huff_code, &pregen_lit_huff_code, sizeof(pregen_lit_huff_code));
         memcpy(&state->dist_huff_code, &pregen_dist_huff_code, sizeof(pregen_dist_huff_code));
         state->block_state = ISAL_BLOCK_CODED;
+        state->hdr_type = INFLATE_HDR_PREGEN;
 #endif // ISAL_STATIC_INFLATE_TABLE
         return 0;
 }
@@ -999,6 +1107,7 @@ static int inline setup_static_header(struct inflate_state *state)
                                     max_dist);
 #endif
         state->block_state = ISAL_BLOCK_CODED;
+        state->hdr_type = INFLATE_HDR_STATIC;
 
         return 0;
 }
@@ -1164,6 +1273,132 @@ static uint16_t inline decode_next_header(struct inflate_state *state,
         }
 }
 
+#define HDR_CACHE_MAX_ENTRIES 4096
+
+/* Decode tables built from one dynamic header. The code lengths are compared in full on lookup,
+ * the hash only selects the slot. */
+struct inflate_hdr_cache_entry {
+        uint32_t valid;
+        uint32_t hash;
+        uint32_t multisym;
+        uint32_t max_dist;
+        uint8_t lengths[LIT_LEN + DIST_LEN];
+        struct inflate_huff_code_large lit_huff_code;
+        struct inflate_huff_code_small dist_huff_code;
+};
+
+struct isal_inflate_hdr_cache {
+        uint32_t entries;
+        struct inflate_hdr_cache_entry entry[];
+};
+
+struct isal_inflate_hdr_cache *
+isal_inflate_hdr_cache_create(uint32_t entries)
+{
+        struct isal_inflate_hdr_cache *cache;
+
+        if (entries == 0 || entries > HDR_CACHE_MAX_ENTRIES)
+                return NULL;
+
+        cache = calloc(1, sizeof(*cache) + entries * sizeof(cache->entry[0]));
+        if (cache != NULL)
+                cache->entries = entries;
+
+        return cache;
+}
+
+void
+isal_inflate_hdr_cache_free(struct isal_inflate_hdr_cache *cache)
+{
+        free(cache);
+}
+
+/* Returns the cache slot for a header and whether it already holds its tables */
+static struct inflate_hdr_cache_entry *
+hdr_cache_lookup(struct isal_inflate_hdr_cache *cache, uint8_t *lengths, uint32_t multisym,
+                 uint32_t max_dist, int *hit)
+{
+        struct inflate_hdr_cache_entry *entry;
+        uint32_t i, hash = 2166136261u;
+
+        for (i = 0; i < LIT_LEN + DIST_LEN; i++)
+                hash = (hash ^ lengths[i]) * 16777619u;
+        hash = (hash ^ multisym) * 16777619u;
+        hash = (hash ^ max_dist) * 16777619u;
+
+        entry = &cache->entry[hash % cache->entries];
+        *hit = entry->valid && entry->hash == hash && entry->multisym == multisym &&
+               entry->max_dist == max_dist &&
+               !memcmp(entry->lengths, lengths, sizeof(entry->lengths));
+
+        if (!*hit) {
+                entry->valid = 0;
+                entry->hash = hash;
+        }
+
+        return entry;
+}
+
+/* Builds the decode tables of a dynamic header from its code lengths in lit_and_dist_huff and
+ * state->hdr_lengths, and the counts of each length */
+static int
+setup_dynamic_tables(struct inflate_state *state, struct huff_code *lit_and_dist_huff,
+                     uint16_t *lit_count, uint16_t *lit_expand_count, uint16_t *dist_count,
+                     uint32_t multisym)
+{
+        uint32_t max_dist = DIST_LEN;
+        struct inflate_hdr_cache_entry *cache_entry = NULL;
+        int cache_hit;
+        uint32_t code_list[LIT_LEN_ELEMS +
+                           2]; /* The +2 is for the extra codes in the static header */
+
+        if (state->hist_bits && state->hist_bits < 15)
+                max_dist = 2 * state->hist_bits;
+
+        if (state->hdr_cache != NULL) {
+                cache_entry = hdr_cache_lookup(state->hdr_cache, state->hdr_lengths, multisym,
+                                               max_dist, &cache_hit);
+                if (cache_hit) {
+                        memcpy(&state->lit_huff_code, &cache_entry->lit_huff_code,
+                               sizeof(state->lit_huff_code));
+                        memcpy(&state->dist_huff_code, &cache_entry->dist_huff_code,
+                               sizeof(state->dist_huff_code));
+                        state->block_state = ISAL_BLOCK_CODED;
+                        state->hdr_type = INFLATE_HDR_DYNAMIC;
+                        return 0;
+                }
+        }
+
+        if (set_codes(&lit_and_dist_huff[LIT_LEN], DIST_LEN, dist_count))
+                return ISAL_INVALID_BLOCK;
+
+        make_inflate_huff_code_dist(&state->dist_huff_code, &lit_and_dist_huff[LIT_LEN], DIST_LEN,
+                                    dist_count, max_dist);
+
+        if (set_and_expand_lit_len_huffcode(lit_and_dist_huff, LIT_LEN, lit_count, lit_expand_count,
+                                            code_list))
+                return ISAL_INVALID_BLOCK;
+
+        make_inflate_huff_code_lit_len(&state->lit_huff_code, lit_and_dist_huff, LIT_LEN_ELEMS,
+                                       lit_count, code_list, multisym);
+
+        if (cache_entry != NULL) {
+                memcpy(cache_entry->lengths, state->hdr_lengths, sizeof(cache_entry->lengths));
+                memcpy(&cache_entry->lit_huff_code, &state->lit_huff_code,
+                       sizeof(state->lit_huff_code));
+                memcpy(&cache_entry->dist_huff_code, &state->dist_huff_code,
+                       sizeof(state->dist_huff_code));
+                cache_entry->multisym = multisym;
+                cache_entry->max_dist = max_dist;
+                cache_entry->valid = 1;
+        }
+
+        state->block_state = ISAL_BLOCK_CODED;
+        state->hdr_type = INFLATE_HDR_DYNAMIC;
+
+        return 0;
+}
+
 /* Reads data from the in_buffer and sets the huff code corresponding to that
  * data */
 static int inline setup_dynamic_header(struct inflate_state *state)
@@ -1178,13 +1413,11 @@ static int inline setup_dynamic_header(struct inflate_state *state)
                 dist_count[16];
         uint16_t *count;
         uint16_t symbol;
-        uint32_t multisym = DEFAULT_SYM_FLAG, length, max_dist = DIST_LEN;
+        uint32_t multisym = DEFAULT_SYM_FLAG, length;
         struct huff_code *code;
         uint64_t flag = 0;
 
         int extra_count;
-        uint32_t code_list[LIT_LEN_ELEMS +
-                           2]; /* The +2 is for the extra codes in the static header */
 
         /* This order is defined in RFC 1951 page 13 */
         const uint8_t code_length_order[CODE_LEN_CODES] = { 0x10, 0x11, 0x12, 0x00, 0x08,
@@ -1372,25 +1605,66 @@ static int inline setup_dynamic_header(struct inflate_state *state)
         if (state->read_in_length < 0)
                 return ISAL_END_INPUT;
 
-        if (set_codes(&lit_and_dist_huff[LIT_LEN], DIST_LEN, dist_count))
-                return ISAL_INVALID_BLOCK;
+        for (i = 0; i < LIT_LEN + DIST_LEN; i++)
+                state->hdr_lengths[i] = lit_and_dist_huff[i].length;
 
-        if (state->hist_bits && state->hist_bits < 15)
-                max_dist = 2 * state->hist_bits;
+        return setup_dynamic_tables(state, lit_and_dist_huff, lit_count, lit_expand_count,
+                                    dist_count, multisym);
+}
 
-        make_inflate_huff_code_dist(&state->dist_huff_code, &lit_and_dist_huff[LIT_LEN], DIST_LEN,
-                                    dist_count, max_dist);
+/* Rebuilds the decode tables of the current block from hdr_type and hdr_lengths, for a state
+ * restored without its tables. block_state is left as it was. */
+int
+inflate_restore_tables(struct inflate_state *state)
+{
+        struct huff_code lit_and_dist_huff[LIT_LEN_ELEMS];
+        uint16_t lit_count[MAX_LIT_LEN_COUNT], lit_expand_count[MAX_LIT_LEN_COUNT],
+                dist_count[16];
+        enum isal_block_state block_state = state->block_state;
+        uint32_t i, length, extra_count;
+        int ret;
 
-        if (set_and_expand_lit_len_huffcode(lit_and_dist_huff, LIT_LEN, lit_count, lit_expand_count,
-                                            code_list))
-                return ISAL_INVALID_BLOCK;
+        switch (state->hdr_type) {
+        case INFLATE_HDR_STATIC:
+                ret = setup_static_header(state);
+                break;
+        case INFLATE_HDR_PREGEN:
+                ret = setup_pregen_header(state);
+                break;
+        case INFLATE_HDR_DYNAMIC:
+                memset(lit_count, 0, sizeof(lit_count));
+                memset(lit_expand_count, 0, sizeof(lit_expand_count));
+                memset(dist_count, 0, sizeof(dist_count));
+                memset(lit_and_dist_huff, 0, sizeof(lit_and_dist_huff));
+
+                /* Same counts as setup_dynamic_header() makes while reading the header */
+                for (i = 0; i < LIT_LEN; i++) {
+                        length = state->hdr_lengths[i];
+                        write_huff_code(&lit_and_dist_huff[i], 0, length);
+                        lit_count[length]++;
+                        if (length == 0 || i < 264)
+                                continue;
 
-        make_inflate_huff_code_lit_len(&state->lit_huff_code, lit_and_dist_huff, LIT_LEN_ELEMS,
-                                       lit_count, code_list, multisym);
+                        extra_count = rfc_lookup_table.len_extra_bit_count[i - LIT_TABLE_SIZE];
+                        lit_expand_count[length]--;
+                        lit_expand_count[length + extra_count] += (1 << extra_count);
+                }
 
-        state->block_state = ISAL_BLOCK_CODED;
+                for (; i < LIT_LEN + DIST_LEN; i++) {
+                        length = state->hdr_lengths[i];
+                        write_huff_code(&lit_and_dist_huff[i], 0, length);
+                        dist_count[length]++;
+                }
 
-        return 0;
+                ret = setup_dynamic_tables(state, lit_and_dist_huff, lit_count, lit_expand_count,
+                                           dist_count, DEFAULT_SYM_FLAG);
+                break;
+        default:
+                ret = ISAL_INVALID_BLOCK;
+        }
+
+        state->block_state = block_state;
+        return ret;
 }
 
 /* Reads in the header pointed to by in_stream and sets up state to reflect that
@@ -1566,9 +1840,30 @@ static int inline decode_literal_block(struct inflate_state *state)
         return 0;
 }
 
-/* Decodes the next block if it was encoded using a huffman code */
-int
-decode_huffman_code_block_stateless_base(struct inflate_state *state, uint8_t *start_out)
+/* Writes out a match of repeat_length bytes from lookback_distance back, with avail_out bytes of
+ * room in the output */
+INFLATE_ALWAYS_INLINE void
+copy_match(uint8_t *dest, uint32_t lookback_distance, uint32_t repeat_length, uint32_t avail_out,
+           const int avx512)
+{
+#ifdef INFLATE_AVX512
+        if (avx512) {
+                avx512_copy(dest, lookback_distance, repeat_length);
+                return;
+        }
+#endif
+        if (avail_out >= repeat_length + INFLATE_COPY_SLOP)
+                fast_copy(dest, lookback_distance, repeat_length);
+        else if (lookback_distance > repeat_length)
+                memcpy(dest, dest - lookback_distance, repeat_length);
+        else
+                byte_copy(dest, lookback_distance, repeat_length);
+}
+
+/* Decodes the next block if it was encoded using a huffman code. Inlined into each kernel with
+ * avx512 constant, which selects how matches are copied. */
+INFLATE_ALWAYS_INLINE int
+decode_huffman_code_block(struct inflate_state *state, uint8_t *start_out, const int avx512)
 {
         uint16_t next_lit;
         uint32_t next_dist;
@@ -1692,11 +1987,8 @@ decode_huffman_code_block_stateless_base(struct inflate_state *state, uint8_t *s
                                         repeat_length = state->avail_out;
                                 }
 
-                                if (look_back_dist > repeat_length)
-                                        memcpy(state->next_out, state->next_out - look_back_dist,
-                                               repeat_length);
-                                else
-                                        byte_copy(state->next_out, look_back_dist, repeat_length);
+                                copy_match(state->next_out, look_back_dist, repeat_length,
+                                           state->avail_out, avx512);
 
                                 state->next_out += repeat_length;
                                 state->avail_out -= repeat_length;
@@ -1716,6 +2008,111 @@ decode_huffman_code_block_stateless_base(struct inflate_state *state, uint8_t *s
         return 0;
 }
 
+int
+decode_huffman_code_block_stateless_base(struct inflate_state *state, uint8_t *start_out)
+{
+        return decode_huffman_code_block(state, start_out, 0);
+}
+
+#ifdef INFLATE_AVX512
+INFLATE_AVX512_TARGET int
+decode_huffman_code_block_stateless_10(struct inflate_state *state, uint8_t *start_out)
+{
+        return decode_huffman_code_block(state, start_out, 1);
+}
+#endif
+
+/* Reads the next block header; used by the parallel decoder to probe block boundaries */
+int
+inflate_read_header(struct inflate_state *state)
+{
+        return read_header(state);
+}
+
+/* Decodes the next huffman coded block into 16 bit symbols for the parallel decoder. Values
+ * below 256 are literals. Bytes copied from before the start of out, which is unknown when the
+ * block is decoded, are written as 256 + the index into the IGZIP_HIST_SIZE byte window that
+ * precedes out. Returns ISAL_OUT_OVERFLOW when out_size symbols are not enough, in which case
+ * the caller restores the input state and decodes the block again into a larger buffer. */
+int
+decode_huffman_code_block_markers(struct inflate_state *state, uint16_t *out, uint32_t *out_len,
+                                  uint32_t out_size)
+{
+        uint16_t next_lit;
+        uint32_t next_dist;
+        uint32_t repeat_length;
+        uint32_t look_back_dist;
+        uint32_t next_lits, sym_count;
+        uint32_t pos = *out_len;
+        uint32_t i;
+        struct rfc1951_tables *rfc = &rfc_lookup_table;
+
+        while (state->block_state == ISAL_BLOCK_CODED) {
+                inflate_in_load(state, 0);
+                decode_next_lit_len(&next_lits, &sym_count, state, &state->lit_huff_code);
+
+                if (sym_count == 0)
+                        return ISAL_INVALID_SYMBOL;
+
+                if (state->read_in_length < 0)
+                        return ISAL_END_INPUT;
+
+                while (sym_count > 0) {
+                        next_lit = next_lits & 0xffff;
+                        if (next_lit < 256 || sym_count > 1) {
+                                if (pos >= out_size)
+                                        return ISAL_OUT_OVERFLOW;
+
+                                out[pos++] = (uint8_t) next_lit;
+
+                        } else if (next_lit == 256) {
+                                state->block_state =
+                                        state->bfinal ? ISAL_BLOCK_INPUT_DONE : ISAL_BLOCK_NEW_HDR;
+
+                        } else if (next_lit <= MAX_LIT_LEN_SYM) {
+                                repeat_length = next_lit - 254;
+                                next_dist = decode_next_dist(state, &state->dist_huff_code);
+
+                                if (state->read_in_length < 0)
+                                        return ISAL_END_INPUT;
+
+                                if (next_dist >= DIST_LEN)
+                                        return ISAL_INVALID_SYMBOL;
+
+                                look_back_dist = (uint32_t) (rfc->dist_start[next_dist] +
+                                                             inflate_in_read_bits(
+                                                                     state,
+                                                                     rfc->dist_extra_bit_count
+                                                                             [next_dist]));
+
+                                if (state->read_in_length < 0)
+                                        return ISAL_END_INPUT;
+
+                                if (look_back_dist > pos + IGZIP_HIST_SIZE)
+                                        return ISAL_INVALID_LOOKBACK;
+
+                                if (out_size - pos < repeat_length)
+                                        return ISAL_OUT_OVERFLOW;
+
+                                for (i = 0; i < repeat_length; i++, pos++) {
+                                        if (look_back_dist > pos)
+                                                out[pos] = 256 + IGZIP_HIST_SIZE -
+                                                           (look_back_dist - pos);
+                                        else
+                                                out[pos] = out[pos - look_back_dist];
+                                }
+                        } else
+                                return ISAL_INVALID_SYMBOL;
+
+                        next_lits >>= 8;
+                        sym_count--;
+                }
+        }
+
+        *out_len = pos;
+        return 0;
+}
+
 void
 isal_inflate_init(struct inflate_state *state)
 {
@@ -1742,6 +2139,7 @@ isal_inflate_init(struct inflate_state *state)
         state->tmp_in_size = 0;
         state->tmp_out_processed = 0;
         state->tmp_out_valid = 0;
+        state->hdr_cache = NULL;
 }
 
 void
@@ -1763,6 +2161,7 @@ isal_inflate_reset(struct inflate_state *state)
         state->tmp_in_size = 0;
         state->tmp_out_processed = 0;
         state->tmp_out_valid = 0;
+        state->hdr_cache = NULL;
 }
 
 static inline uint32_t
@@ -2142,6 +2541,39 @@ isal_inflate_set_dict(struct inflate_state *state, uint8_t *dict, uint32_t dict_
         return COMP_OK;
 }
 
+/* Computes the checksum of the stateless output at start_out, unless crc_done says state->crc
+ * already holds it, and checks it against the trailer when crc_flag asks for that. */
+int
+inflate_stateless_checksum(struct inflate_state *state, uint8_t *start_out, int crc_done)
+{
+        int ret = 0;
+
+        if (!state->crc_flag)
+                return 0;
+
+        if (!crc_done)
+                update_checksum(state, start_out, state->next_out - start_out);
+
+        switch (state->crc_flag) {
+        case ISAL_ZLIB:
+        case ISAL_ZLIB_NO_HDR_VER:
+                finalize_adler32(state);
+                ret = check_zlib_checksum(state);
+                break;
+
+        case ISAL_ZLIB_NO_HDR:
+                finalize_adler32(state);
+                break;
+
+        case ISAL_GZIP:
+        case ISAL_GZIP_NO_HDR_VER:
+                ret = check_gzip_checksum(state);
+                break;
+        }
+
+        return ret;
+}
+
 int
 isal_inflate_stateless(struct inflate_state *state)
 {
@@ -2157,6 +2589,9 @@ isal_inflate_stateless(struct inflate_state *state)
         state->total_out = 0;
         state->hist_bits = 0;
         state->tmp_in_size = 0;
+        state->write_overflow_lits = 0;
+        state->write_overflow_len = 0;
+        state->hdr_cache = NULL;
 
         if (state->crc_flag == IGZIP_GZIP) {
                 struct isal_gzip_header gz_hdr;
@@ -2201,39 +2636,27 @@ isal_inflate_stateless(struct inflate_state *state)
         state->read_in_length = 0;
         state->read_in = 0;
 
-        if (!ret && state->crc_flag) {
-                update_checksum(state, start_out, state->next_out - start_out);
-                switch (state->crc_flag) {
-                case ISAL_ZLIB:
-                case ISAL_ZLIB_NO_HDR_VER:
-                        finalize_adler32(state);
-                        ret = check_zlib_checksum(state);
-                        break;
-
-                case ISAL_ZLIB_NO_HDR:
-                        finalize_adler32(state);
-                        break;
-
-                case ISAL_GZIP:
-                case ISAL_GZIP_NO_HDR_VER:
-                        ret = check_gzip_checksum(state);
-                        break;
-                }
-        }
+        if (!ret)
+                ret = inflate_stateless_checksum(state, start_out, 0);
 
         return ret;
 }
 
+/* Body of isal_inflate(). With stop_at_block set it also returns, setting *stopped, at the first
+ * block boundary reached after decoding some output, so the caller can checkpoint the stream. */
 int
-isal_inflate(struct inflate_state *state)
+inflate_stateful(struct inflate_state *state, int stop_at_block, int *stopped)
 {
 
         uint8_t *start_out = state->next_out;
+        uint8_t *block_start_out;
         uint32_t avail_out = state->avail_out;
         uint32_t copy_size = 0;
         int32_t shift_size = 0;
         int ret = 0;
 
+        *stopped = 0;
+
         if (!state->wrapper_flag && state->crc_flag == IGZIP_GZIP) {
                 struct isal_gzip_header gz_hdr;
 
@@ -2285,7 +2708,14 @@ isal_inflate(struct inflate_state *state)
                                 state->avail_out = 0;
 
                         /* Decode into internal buffer until exit */
+                        block_start_out = state->next_out;
                         while (state->block_state != ISAL_BLOCK_INPUT_DONE) {
+                                if (stop_at_block && state->block_state == ISAL_BLOCK_NEW_HDR &&
+                                    state->next_out != block_start_out) {
+                                        *stopped = 1;
+                                        break;
+                                }
+
                                 if (state->block_state == ISAL_BLOCK_NEW_HDR ||
                                     state->block_state == ISAL_BLOCK_HDR) {
                                         ret = read_header_stateful(state);
@@ -2354,8 +2784,15 @@ isal_inflate(struct inflate_state *state)
 
                 /* If all data from tmp_out buffer has been processed, start
                  * decompressing into the out buffer */
-                if (state->tmp_out_processed == state->tmp_out_valid) {
+                if (state->tmp_out_processed == state->tmp_out_valid && !*stopped) {
+                        block_start_out = state->next_out;
                         while (state->block_state != ISAL_BLOCK_INPUT_DONE) {
+                                if (stop_at_block && state->block_state == ISAL_BLOCK_NEW_HDR &&
+                                    state->next_out != block_start_out) {
+                                        *stopped = 1;
+                                        break;
+                                }
+
                                 if (state->block_state == ISAL_BLOCK_NEW_HDR ||
                                     state->block_state == ISAL_BLOCK_HDR) {
                                         ret = read_header_stateful(state);
@@ -2454,3 +2891,51 @@ isal_inflate(struct inflate_state *state)
 
         return (ret > 0) ? ISAL_DECOMP_OK : ret;
 }
+
+int
+isal_inflate(struct inflate_state *state)
+{
+        int stopped;
+
+        return inflate_stateful(state, 0, &stopped);
+}
+
+int
+isal_inflate_verify(struct inflate_state *state)
+{
+        uint8_t *next_out = state->next_out;
+        uint32_t avail_out = state->avail_out;
+        uint32_t avail_in, new_out;
+        int stopped, ret;
+
+        /* With no output space everything is decoded into tmp_out_buffer. New bytes are
+         * checksummed there and dropped, keeping only the history window. */
+        do {
+                avail_in = state->avail_in;
+                state->next_out = state->tmp_out_buffer;
+                state->avail_out = 0;
+
+                ret = inflate_stateful(state, 0, &stopped);
+
+                new_out = state->tmp_out_valid - state->tmp_out_processed;
+                if (state->crc_flag)
+                        update_checksum(state, &state->tmp_out_buffer[state->tmp_out_processed],
+                                        new_out);
+                state->tmp_out_processed = state->tmp_out_valid;
+                state->total_out += new_out;
+
+                if (state->tmp_out_valid > ISAL_DEF_HIST_SIZE) {
+                        memmove(state->tmp_out_buffer,
+                                &state->tmp_out_buffer[state->tmp_out_valid - ISAL_DEF_HIST_SIZE],
+                                ISAL_DEF_HIST_SIZE);
+                        state->tmp_out_valid = ISAL_DEF_HIST_SIZE;
+                        state->tmp_out_processed = ISAL_DEF_HIST_SIZE;
+                }
+        } while (ret == ISAL_DECOMP_OK && state->block_state != ISAL_BLOCK_FINISH &&
+                 (new_out > 0 || state->avail_in != avail_in));
+
+        state->next_out = next_out;
+        state->avail_out = avail_out;
+
+        return ret;
+}
@@ -0,0 +1,229 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "igzip_lib.h"
+
+extern int
+inflate_restore_tables(struct inflate_state *state);
+
+/* The parts of inflate_state a stream needs between calls. data holds, in order, hdr_lengths
+ * when block_state is ISAL_BLOCK_CODED, tmp_in_size bytes of tmp_in_buffer and stored_len bytes
+ * of window. A window with stored_len < win_len is deflate compressed. */
+struct isal_inflate_compact {
+        uint64_t read_in;
+        int32_t read_in_length;
+        uint32_t total_out;
+        uint32_t block_state;
+        uint32_t dict_length;
+        uint32_t bfinal;
+        uint32_t crc_flag;
+        uint32_t crc;
+        uint32_t hist_bits;
+        int32_t type0_block_len; /* Also holds count and dict_id, which share it */
+        int32_t write_overflow_lits;
+        int32_t write_overflow_len;
+        int32_t copy_overflow_length;
+        int32_t copy_overflow_distance;
+        int16_t wrapper_flag;
+        int16_t tmp_in_size;
+        uint32_t hdr_type;
+        uint32_t pending; /* Bytes at the end of the window not returned to the caller yet */
+        uint32_t win_len;
+        uint32_t stored_len;
+        uint32_t size;
+        uint8_t data[];
+};
+
+/* Compresses a window into out, returns the compressed size or 0 if it would not be smaller */
+static uint32_t
+compact_deflate_window(uint8_t *window, uint32_t win_len, uint8_t *out)
+{
+        struct isal_zstream stream;
+
+        isal_deflate_stateless_init(&stream);
+        stream.next_in = window;
+        stream.avail_in = win_len;
+        stream.next_out = out;
+        stream.avail_out = win_len - 1;
+        stream.level = 0;
+        stream.gzip_flag = IGZIP_DEFLATE;
+        stream.end_of_stream = 1;
+
+        if (win_len < 2 || isal_deflate_stateless(&stream) != COMP_OK)
+                return 0;
+
+        return stream.total_out;
+}
+
+int
+isal_inflate_compact_save(struct inflate_state *state, struct isal_inflate_compact **compact,
+                          uint32_t flags)
+{
+        struct isal_inflate_compact *c, *shrunk;
+        uint32_t hist = ISAL_DEF_HIST_SIZE, pending, win_len, lengths_len = 0, size;
+        uint8_t *window, *data;
+
+        if (state->hist_bits && state->hist_bits < 15)
+                hist = 1 << state->hist_bits;
+
+        pending = state->tmp_out_valid - state->tmp_out_processed;
+        win_len = state->tmp_out_valid;
+        if (win_len > hist + pending)
+                win_len = hist + pending;
+        window = &state->tmp_out_buffer[state->tmp_out_valid - win_len];
+
+        if (state->block_state == ISAL_BLOCK_CODED)
+                lengths_len = sizeof(state->hdr_lengths);
+
+        size = sizeof(*c) + lengths_len + state->tmp_in_size + win_len;
+        c = realloc(*compact, size);
+        if (c == NULL)
+                return ISAL_INVALID_STATE;
+        *compact = c;
+
+        c->read_in = state->read_in;
+        c->read_in_length = state->read_in_length;
+        c->total_out = state->total_out;
+        c->block_state = state->block_state;
+        c->dict_length = state->dict_length;
+        c->bfinal = state->bfinal;
+        c->crc_flag = state->crc_flag;
+        c->crc = state->crc;
+        c->hist_bits = state->hist_bits;
+        c->type0_block_len = state->type0_block_len;
+        c->write_overflow_lits = state->write_overflow_lits;
+        c->write_overflow_len = state->write_overflow_len;
+        c->copy_overflow_length = state->copy_overflow_length;
+        c->copy_overflow_distance = state->copy_overflow_distance;
+        c->wrapper_flag = state->wrapper_flag;
+        c->tmp_in_size = state->tmp_in_size;
+        c->hdr_type = state->hdr_type;
+        c->pending = pending;
+        c->win_len = win_len;
+
+        data = c->data;
+        memcpy(data, state->hdr_lengths, lengths_len);
+        data += lengths_len;
+        memcpy(data, state->tmp_in_buffer, state->tmp_in_size);
+        data += state->tmp_in_size;
+
+        c->stored_len = 0;
+        if (flags & ISAL_INFLATE_COMPACT_DEFLATE)
+                c->stored_len = compact_deflate_window(window, win_len, data);
+        if (c->stored_len == 0) {
+                c->stored_len = win_len;
+                memcpy(data, window, win_len);
+        }
+
+        c->size = size - (win_len - c->stored_len);
+        if (c->size < size) {
+                shrunk = realloc(c, c->size);
+                if (shrunk != NULL)
+                        *compact = shrunk;
+        }
+
+        return ISAL_DECOMP_OK;
+}
+
+int
+isal_inflate_compact_load(struct inflate_state *state, const struct isal_inflate_compact *c)
+{
+        struct isal_inflate_hdr_cache *hdr_cache = state->hdr_cache;
+        uint8_t *next_in = state->next_in, *next_out = state->next_out;
+        uint32_t avail_in = state->avail_in, avail_out = state->avail_out;
+        uint32_t lengths_len = 0;
+        const uint8_t *data = c->data;
+        int ret = ISAL_DECOMP_OK;
+
+        if (c->block_state == ISAL_BLOCK_CODED)
+                lengths_len = sizeof(state->hdr_lengths);
+
+        if (c->stored_len < c->win_len) {
+                /* Decode the window with state itself, its tables are rebuilt below */
+                isal_inflate_init(state);
+                state->next_in = (uint8_t *) data + lengths_len + c->tmp_in_size;
+                state->avail_in = c->stored_len;
+                state->next_out = state->tmp_out_buffer;
+                state->avail_out = c->win_len;
+
+                if (isal_inflate_stateless(state) != ISAL_DECOMP_OK ||
+                    state->total_out != c->win_len)
+                        ret = ISAL_INVALID_BLOCK;
+        } else
+                memcpy(state->tmp_out_buffer, data + lengths_len + c->tmp_in_size, c->win_len);
+
+        state->read_in = c->read_in;
+        state->read_in_length = c->read_in_length;
+        state->total_out = c->total_out;
+        state->block_state = c->block_state;
+        state->dict_length = c->dict_length;
+        state->bfinal = c->bfinal;
+        state->crc_flag = c->crc_flag;
+        state->crc = c->crc;
+        state->hist_bits = c->hist_bits;
+        state->type0_block_len = c->type0_block_len;
+        state->write_overflow_lits = c->write_overflow_lits;
+        state->write_overflow_len = c->write_overflow_len;
+        state->copy_overflow_length = c->copy_overflow_length;
+        state->copy_overflow_distance = c->copy_overflow_distance;
+        state->wrapper_flag = c->wrapper_flag;
+        state->tmp_in_size = c->tmp_in_size;
+        state->tmp_out_valid = c->win_len;
+        state->tmp_out_processed = c->win_len - c->pending;
+        state->hdr_type = c->hdr_type;
+        state->hdr_cache = hdr_cache;
+
+        memcpy(state->hdr_lengths, data, lengths_len);
+        memcpy(state->tmp_in_buffer, data + lengths_len, c->tmp_in_size);
+
+        if (ret == ISAL_DECOMP_OK && c->block_state == ISAL_BLOCK_CODED)
+                ret = inflate_restore_tables(state);
+
+        state->next_in = next_in;
+        state->avail_in = avail_in;
+        state->next_out = next_out;
+        state->avail_out = avail_out;
+
+        return ret;
+}
+
+uint32_t
+isal_inflate_compact_size(const struct isal_inflate_compact *compact)
+{
+        return compact->size;
+}
+
+void
+isal_inflate_compact_free(struct isal_inflate_compact *compact)
+{
+        free(compact);
+}
@@ -0,0 +1,216 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define NUM_STREAMS  6
+#define TEST_SIZE    (512 * 1024 + 3)
+#define PATTERN_SIZE (8 * 1024)
+#define FLUSH_SIZE   (16 * 1024 + 7)
+#define MAX_PIECE    3000
+
+struct test_stream {
+        uint8_t *in;
+        uint8_t *comp;
+        uint8_t *out;
+        uint32_t comp_len;
+        uint32_t in_pos;
+        uint32_t out_pos;
+        uint32_t crc_flag;
+        uint32_t hist_bits;
+        struct isal_inflate_compact *compact;
+};
+
+// Runs one isal_inflate() call on a stream, paging it in and out of the shared state
+static int
+step(struct inflate_state *state, struct test_stream *s, uint32_t flags)
+{
+        uint32_t in_len, out_len;
+        int ret;
+
+        if (s->compact == NULL) {
+                isal_inflate_reset(state);
+                state->crc_flag = s->crc_flag;
+                state->hist_bits = s->hist_bits;
+        } else if (isal_inflate_compact_load(state, s->compact) != ISAL_DECOMP_OK) {
+                printf("compact load failed\n");
+                return 1;
+        }
+
+        in_len = 1 + rand() % MAX_PIECE;
+        if (in_len > s->comp_len - s->in_pos)
+                in_len = s->comp_len - s->in_pos;
+        out_len = 1 + rand() % (4 * MAX_PIECE);
+        if (out_len > TEST_SIZE - s->out_pos)
+                out_len = TEST_SIZE - s->out_pos;
+
+        state->next_in = s->comp + s->in_pos;
+        state->avail_in = in_len;
+        state->next_out = s->out + s->out_pos;
+        state->avail_out = out_len;
+
+        ret = isal_inflate(state);
+        if (ret != ISAL_DECOMP_OK) {
+                printf("inflate returned %d\n", ret);
+                return 1;
+        }
+
+        s->in_pos += in_len - state->avail_in;
+        s->out_pos += out_len - state->avail_out;
+
+        if (isal_inflate_compact_save(state, &s->compact, flags) != ISAL_DECOMP_OK) {
+                printf("compact save failed\n");
+                return 1;
+        }
+
+        return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+        struct test_stream streams[NUM_STREAMS];
+        struct inflate_state *state;
+        struct isal_zstream stream;
+        struct isal_inflate_hdr_cache *cache;
+        uint16_t gzip_flags[] = { IGZIP_GZIP, IGZIP_ZLIB, IGZIP_DEFLATE };
+        uint32_t comp_size = 2 * TEST_SIZE, flags, max_size, bound, i, done;
+        int fail = 0;
+
+        printf("igzip_inflate_compact_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        state = malloc(sizeof(*state));
+        cache = isal_inflate_hdr_cache_create(4);
+        if (state == NULL || cache == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+        isal_inflate_init(state);
+
+        for (i = 0; i < NUM_STREAMS; i++) {
+                struct test_stream *s = &streams[i];
+
+                memset(s, 0, sizeof(*s));
+                s->in = malloc(TEST_SIZE);
+                s->comp = malloc(comp_size);
+                s->out = malloc(TEST_SIZE);
+                if (s->in == NULL || s->comp == NULL || s->out == NULL) {
+                        printf("alloc error: Fail\n");
+                        return -1;
+                }
+
+                make_test_data(s->in, TEST_SIZE, PATTERN_SIZE, 192);
+                s->crc_flag = gzip_flags[i % 3];
+                s->hist_bits = (i == NUM_STREAMS - 1) ? 12 : 0;
+
+                // A SYNC_FLUSH every FLUSH_SIZE bytes stops the streams in every kind of block
+                isal_deflate_init(&stream);
+                stream.level = i % 4;
+                stream.gzip_flag = s->crc_flag;
+                stream.hist_bits = s->hist_bits;
+                s->comp_len = test_deflate(&stream, s->in, TEST_SIZE, s->comp, comp_size,
+                                           FLUSH_SIZE);
+                if (s->comp_len == 0) {
+                        printf("deflate failed\n");
+                        fail++;
+                        goto exit;
+                }
+        }
+
+        // Interleave all streams through the one state until each is done
+        for (flags = 0; flags <= ISAL_INFLATE_COMPACT_DEFLATE; flags++) {
+                max_size = 0;
+                do {
+                        done = 0;
+                        for (i = 0; i < NUM_STREAMS; i++) {
+                                struct test_stream *s = &streams[i];
+
+                                if (s->compact != NULL &&
+                                    isal_inflate_compact_size(s->compact) > max_size)
+                                        max_size = isal_inflate_compact_size(s->compact);
+
+                                if (s->out_pos == TEST_SIZE && s->in_pos == s->comp_len) {
+                                        done++;
+                                        continue;
+                                }
+
+                                fail += step(state, s, flags);
+                                if (fail) {
+                                        printf("Fail stream %d flags %d\n", i, flags);
+                                        goto exit;
+                                }
+                        }
+                        state->hdr_cache = (rand() & 1) ? cache : NULL;
+                } while (done < NUM_STREAMS);
+
+                for (i = 0; i < NUM_STREAMS; i++) {
+                        struct test_stream *s = &streams[i];
+
+                        if (memcmp(s->in, s->out, TEST_SIZE)) {
+                                printf("Fail stream %d flags %d: data mismatch\n", i, flags);
+                                fail++;
+                                goto exit;
+                        }
+
+                        memset(s->out, 0, TEST_SIZE);
+                        s->in_pos = 0;
+                        s->out_pos = 0;
+                        isal_inflate_compact_free(s->compact);
+                        s->compact = NULL;
+                }
+
+                // The history and any pending output are kept whole unless deflated
+                bound = flags ? sizeof(*state) / 2 : sizeof(*state) / 4 * 3;
+                if (max_size > bound) {
+                        printf("Fail compact size %d\n", max_size);
+                        fail++;
+                        goto exit;
+                }
+                printf("flags %d: largest compact stream %d bytes\n", flags, max_size);
+        }
+
+exit:
+        printf("igzip_inflate_compact_test: %s\n", fail ? "Fail" : "Pass");
+        for (i = 0; i < NUM_STREAMS; i++) {
+                free(streams[i].in);
+                free(streams[i].comp);
+                free(streams[i].out);
+                isal_inflate_compact_free(streams[i].compact);
+        }
+        isal_inflate_hdr_cache_free(cache);
+        free(state);
+        return fail;
+}
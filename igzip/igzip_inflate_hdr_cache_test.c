@@ -0,0 +1,151 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define TEST_SIZE    (1024 * 1024 + 17)
+#define PATTERN_SIZE (4 * 1024)
+#define FLUSH_SIZE   1500
+#define OUT_PIECE    (16 * 1024 + 5)
+
+static int
+inflate_check(uint8_t *in, uint32_t in_len, uint8_t *comp, uint32_t comp_len, uint8_t *out,
+              struct isal_inflate_hdr_cache *cache)
+{
+        struct inflate_state state;
+        uint32_t out_pos = 0;
+        int ret;
+
+        isal_inflate_init(&state);
+        state.hdr_cache = cache;
+        state.crc_flag = ISAL_GZIP;
+        state.next_in = comp;
+        state.avail_in = comp_len;
+        memset(out, 0, in_len);
+
+        do {
+                state.next_out = out + out_pos;
+                state.avail_out = in_len - out_pos < OUT_PIECE ? in_len - out_pos : OUT_PIECE;
+                ret = isal_inflate(&state);
+                out_pos += state.next_out - (out + out_pos);
+        } while (ret == ISAL_DECOMP_OK && state.block_state != ISAL_BLOCK_FINISH &&
+                 out_pos < in_len);
+
+        if (ret != ISAL_DECOMP_OK) {
+                printf("inflate returned %d\n", ret);
+                return 1;
+        }
+        if (out_pos != in_len || memcmp(in, out, in_len)) {
+                printf("decompressed data mismatch\n");
+                return 1;
+        }
+        return 0;
+}
+
+int
+main(int argc, char *argv[])
+{
+        struct isal_huff_histogram histogram;
+        struct isal_hufftables hufftables;
+        struct isal_zstream stream;
+        struct isal_inflate_hdr_cache *cache[2];
+        uint8_t *in, *comp, *out;
+        uint32_t comp_size = 2 * TEST_SIZE, comp_len, c;
+        int level, custom, fail = 0;
+
+        printf("igzip_inflate_hdr_cache_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        in = malloc(TEST_SIZE);
+        comp = malloc(comp_size);
+        out = malloc(TEST_SIZE);
+        cache[0] = isal_inflate_hdr_cache_create(1);
+        cache[1] = isal_inflate_hdr_cache_create(8);
+        if (in == NULL || comp == NULL || out == NULL || cache[0] == NULL || cache[1] == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+
+        make_test_data(in, TEST_SIZE, PATTERN_SIZE, 192);
+
+        memset(&histogram, 0, sizeof(histogram));
+        isal_update_histogram(in, TEST_SIZE, &histogram);
+        isal_create_hufftables(&hufftables, &histogram);
+
+        if (isal_inflate_hdr_cache_create(0) != NULL) {
+                printf("Fail empty cache created\n");
+                fail++;
+                goto exit;
+        }
+
+        for (custom = 0; custom < 2; custom++) {
+                for (level = 0; level <= 1; level++) {
+                        // With custom hufftables every flushed block repeats the same header
+                        isal_deflate_init(&stream);
+                        stream.level = level;
+                        stream.gzip_flag = IGZIP_GZIP;
+                        if (custom)
+                                stream.hufftables = &hufftables;
+                        comp_len = test_deflate(&stream, in, TEST_SIZE, comp, comp_size,
+                                                FLUSH_SIZE);
+                        if (comp_len == 0) {
+                                printf("deflate failed\n");
+                                fail++;
+                                goto exit;
+                        }
+
+                        fail += inflate_check(in, TEST_SIZE, comp, comp_len, out, NULL);
+                        // Run twice so the second pass hits entries from the first
+                        for (c = 0; c < 4; c++)
+                                fail += inflate_check(in, TEST_SIZE, comp, comp_len, out,
+                                                      cache[c % 2]);
+                        if (fail) {
+                                printf("Fail custom=%d level=%d\n", custom, level);
+                                goto exit;
+                        }
+                        printf(".");
+                        fflush(0);
+                }
+        }
+
+exit:
+        printf("\nigzip_inflate_hdr_cache_test: %s\n", fail ? "Fail" : "Pass");
+        isal_inflate_hdr_cache_free(cache[0]);
+        isal_inflate_hdr_cache_free(cache[1]);
+        free(in);
+        free(comp);
+        free(out);
+        return fail;
+}
@@ -0,0 +1,414 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "igzip_lib.h"
+#include "unaligned.h"
+
+extern int
+inflate_stateful(struct inflate_state *state, int stop_at_block, int *stopped);
+
+#define INDEX_MAGIC       0x58495a49 /* "IZIX" */
+#define INDEX_VERSION     1
+#define INDEX_HDR_SIZE    24
+#define INDEX_POINT_SIZE  25
+#define INDEX_INIT_POINTS 16
+
+/* Serialized index, all fields little endian:
+ *   u32 magic, u32 version, u64 spacing, u32 crc_flag, u32 count
+ * followed by count points:
+ *   u64 in_bit, u64 out, u8 bits, u32 win_len, u32 stored_len, stored_len bytes of window
+ * A window with stored_len < win_len is compressed as raw deflate, otherwise it is stored as is. */
+
+struct isal_inflate_point {
+        uint64_t in_bit; /* Bit offset of a block boundary in the input */
+        uint64_t out;    /* Output offset of the same boundary */
+        uint32_t win_len;
+        uint8_t bits;    /* Unread bits of the byte holding in_bit, shifted down */
+        uint8_t *window; /* Output preceding the boundary */
+};
+
+struct isal_inflate_index {
+        uint64_t spacing;
+        uint32_t crc_flag;
+        uint32_t count;
+        uint32_t size;
+        struct isal_inflate_point *points;
+
+        /* Position of an index build in progress */
+        int started;
+        uint64_t in_total;
+        uint64_t out_total;
+        uint8_t hist[IGZIP_HIST_SIZE]; /* Ring of the last bytes written to the caller */
+};
+
+struct isal_inflate_index *
+isal_inflate_index_create(uint64_t spacing)
+{
+        struct isal_inflate_index *index;
+
+        index = calloc(1, sizeof(*index));
+        if (index == NULL)
+                return NULL;
+
+        index->spacing = spacing < IGZIP_HIST_SIZE ? IGZIP_HIST_SIZE : spacing;
+        return index;
+}
+
+void
+isal_inflate_index_free(struct isal_inflate_index *index)
+{
+        uint32_t i;
+
+        if (index == NULL)
+                return;
+
+        for (i = 0; i < index->count; i++)
+                free(index->points[i].window);
+        free(index->points);
+        free(index);
+}
+
+static void
+index_add_history(struct isal_inflate_index *index, uint8_t *buf, uint64_t len)
+{
+        uint64_t skip = len > IGZIP_HIST_SIZE ? len - IGZIP_HIST_SIZE : 0;
+        uint32_t pos = (index->out_total + skip) % IGZIP_HIST_SIZE;
+        uint32_t n = len - skip, first = IGZIP_HIST_SIZE - pos;
+
+        if (first > n)
+                first = n;
+
+        memcpy(index->hist + pos, buf + skip, first);
+        memcpy(index->hist, buf + skip + first, n - first);
+        index->out_total += len;
+}
+
+/* Copies the last len bytes written to the caller, len <= min(out_total, IGZIP_HIST_SIZE) */
+static void
+index_read_history(struct isal_inflate_index *index, uint8_t *dst, uint32_t len)
+{
+        uint32_t pos = (index->out_total - len) % IGZIP_HIST_SIZE;
+        uint32_t first = IGZIP_HIST_SIZE - pos;
+
+        if (first > len)
+                first = len;
+
+        memcpy(dst, index->hist + pos, first);
+        memcpy(dst + first, index->hist, len - first);
+}
+
+static int
+index_grow(struct isal_inflate_index *index)
+{
+        struct isal_inflate_point *points;
+        uint32_t size;
+
+        if (index->count < index->size)
+                return 0;
+
+        size = index->size ? 2 * index->size : INDEX_INIT_POINTS;
+        points = realloc(index->points, size * sizeof(*points));
+        if (points == NULL)
+                return ISAL_INVALID_STATE;
+
+        index->points = points;
+        index->size = size;
+        return 0;
+}
+
+/* Records the block boundary the state is stopped at. Output still held in the state's
+ * tmp_out_buffer has been decoded but not yet written to the caller. */
+static int
+index_add_point(struct isal_inflate_index *index, struct inflate_state *state)
+{
+        struct isal_inflate_point *p;
+        uint32_t pending = state->tmp_out_valid - state->tmp_out_processed;
+        uint64_t out = index->out_total + pending;
+        uint32_t win_len, from_pending;
+        int ret;
+
+        if (state->block_state != ISAL_BLOCK_NEW_HDR || state->tmp_in_size != 0)
+                return 0;
+
+        ret = index_grow(index);
+        if (ret)
+                return ret;
+
+        win_len = out < IGZIP_HIST_SIZE ? (uint32_t) out : IGZIP_HIST_SIZE;
+        from_pending = pending < win_len ? pending : win_len;
+
+        p = &index->points[index->count];
+        p->window = malloc(win_len);
+        if (p->window == NULL)
+                return ISAL_INVALID_STATE;
+
+        index_read_history(index, p->window, win_len - from_pending);
+        memcpy(p->window + win_len - from_pending,
+               state->tmp_out_buffer + state->tmp_out_valid - from_pending, from_pending);
+
+        p->in_bit = index->in_total * 8 - state->read_in_length;
+        p->out = out;
+        p->win_len = win_len;
+        p->bits = 0;
+        if (p->in_bit % 8)
+                p->bits = state->read_in & ((1 << (8 - p->in_bit % 8)) - 1);
+
+        index->count++;
+        return 0;
+}
+
+int
+isal_inflate_index_build(struct inflate_state *state, struct isal_inflate_index *index)
+{
+        struct isal_inflate_point *last;
+        uint8_t *next_in, *next_out;
+        uint64_t decoded, last_out;
+        int ret, stopped, stop_at_block;
+
+        if (!index->started) {
+                index->crc_flag = state->crc_flag;
+                index->started = 1;
+        }
+
+        for (;;) {
+                last = index->count ? &index->points[index->count - 1] : NULL;
+                last_out = last ? last->out : 0;
+                decoded = index->out_total + state->tmp_out_valid - state->tmp_out_processed;
+                stop_at_block = decoded - last_out >= index->spacing;
+
+                next_in = state->next_in;
+                next_out = state->next_out;
+
+                ret = inflate_stateful(state, stop_at_block, &stopped);
+
+                index->in_total += state->next_in - next_in;
+                index_add_history(index, next_out, state->next_out - next_out);
+
+                if (ret || !stopped)
+                        return ret;
+
+                ret = index_add_point(index, state);
+                if (ret)
+                        return ret;
+        }
+}
+
+int
+isal_inflate_seek(struct inflate_state *state, const struct isal_inflate_index *index,
+                  uint64_t offset, uint64_t *in_offset, uint64_t *out_offset)
+{
+        struct isal_inflate_point *p = NULL;
+        uint32_t lo = 0, hi = index->count, mid, shift;
+        int ret;
+
+        /* Last point at or before offset */
+        while (lo < hi) {
+                mid = lo + (hi - lo) / 2;
+                if (index->points[mid].out <= offset)
+                        lo = mid + 1;
+                else
+                        hi = mid;
+        }
+        if (lo > 0)
+                p = &index->points[lo - 1];
+
+        isal_inflate_reset(state);
+
+        if (p == NULL) {
+                state->crc_flag = index->crc_flag;
+                *in_offset = 0;
+                *out_offset = 0;
+                return ISAL_DECOMP_OK;
+        }
+
+        state->crc_flag = ISAL_DEFLATE;
+        ret = isal_inflate_set_dict(state, p->window, p->win_len);
+        if (ret)
+                return ret;
+
+        shift = p->in_bit % 8;
+        if (shift) {
+                state->read_in = p->bits;
+                state->read_in_length = 8 - shift;
+        }
+
+        *in_offset = (p->in_bit + 7) / 8;
+        *out_offset = p->out;
+        return ISAL_DECOMP_OK;
+}
+
+uint64_t
+isal_inflate_index_size(const struct isal_inflate_index *index)
+{
+        uint64_t size = INDEX_HDR_SIZE;
+        uint32_t i;
+
+        for (i = 0; i < index->count; i++)
+                size += INDEX_POINT_SIZE + index->points[i].win_len;
+
+        return size;
+}
+
+/* Compresses a window into out, returns the compressed size or 0 if it would not be smaller */
+static uint32_t
+index_compress_window(uint8_t *window, uint32_t win_len, uint8_t *out)
+{
+        struct isal_zstream stream;
+
+        isal_deflate_stateless_init(&stream);
+        stream.next_in = window;
+        stream.avail_in = win_len;
+        stream.next_out = out;
+        stream.avail_out = win_len - 1;
+        stream.level = 0;
+        stream.gzip_flag = IGZIP_DEFLATE;
+        stream.end_of_stream = 1;
+
+        if (win_len < 2 || isal_deflate_stateless(&stream) != COMP_OK)
+                return 0;
+
+        return stream.total_out;
+}
+
+int
+isal_inflate_index_save(const struct isal_inflate_index *index, uint8_t *buf, uint64_t *len)
+{
+        struct isal_inflate_point *p;
+        uint64_t pos = INDEX_HDR_SIZE;
+        uint32_t i, stored_len;
+
+        if (*len < isal_inflate_index_size(index))
+                return ISAL_OUT_OVERFLOW;
+
+        store_le_u32(buf, INDEX_MAGIC);
+        store_le_u32(buf + 4, INDEX_VERSION);
+        store_le_u64(buf + 8, index->spacing);
+        store_le_u32(buf + 16, index->crc_flag);
+        store_le_u32(buf + 20, index->count);
+
+        for (i = 0; i < index->count; i++) {
+                p = &index->points[i];
+                store_le_u64(buf + pos, p->in_bit);
+                store_le_u64(buf + pos + 8, p->out);
+                buf[pos + 16] = p->bits;
+                store_le_u32(buf + pos + 17, p->win_len);
+
+                stored_len = index_compress_window(p->window, p->win_len,
+                                                   buf + pos + INDEX_POINT_SIZE);
+                if (stored_len == 0) {
+                        stored_len = p->win_len;
+                        memcpy(buf + pos + INDEX_POINT_SIZE, p->window, stored_len);
+                }
+                store_le_u32(buf + pos + 21, stored_len);
+                pos += INDEX_POINT_SIZE + stored_len;
+        }
+
+        *len = pos;
+        return ISAL_DECOMP_OK;
+}
+
+static int
+index_load_window(struct isal_inflate_point *p, const uint8_t *stored, uint32_t stored_len)
+{
+        struct inflate_state state;
+
+        if (stored_len == p->win_len) {
+                memcpy(p->window, stored, stored_len);
+                return 0;
+        }
+
+        isal_inflate_init(&state);
+        state.next_in = (uint8_t *) stored;
+        state.avail_in = stored_len;
+        state.next_out = p->window;
+        state.avail_out = p->win_len;
+
+        if (isal_inflate_stateless(&state) != ISAL_DECOMP_OK || state.total_out != p->win_len)
+                return ISAL_INVALID_BLOCK;
+
+        return 0;
+}
+
+struct isal_inflate_index *
+isal_inflate_index_load(const uint8_t *data, uint64_t len)
+{
+        uint8_t *buf = (uint8_t *) data;
+        struct isal_inflate_index *index;
+        struct isal_inflate_point *p;
+        uint64_t pos = INDEX_HDR_SIZE;
+        uint32_t i, count, stored_len;
+
+        if (len < INDEX_HDR_SIZE || load_le_u32(buf) != INDEX_MAGIC ||
+            load_le_u32(buf + 4) != INDEX_VERSION)
+                return NULL;
+
+        index = isal_inflate_index_create(load_le_u64(buf + 8));
+        if (index == NULL)
+                return NULL;
+
+        index->crc_flag = load_le_u32(buf + 16);
+        index->started = 1;
+        count = load_le_u32(buf + 20);
+
+        for (i = 0; i < count; i++) {
+                if (len - pos < INDEX_POINT_SIZE || index_grow(index))
+                        goto fail;
+
+                p = &index->points[i];
+                p->in_bit = load_le_u64(buf + pos);
+                p->out = load_le_u64(buf + pos + 8);
+                p->bits = buf[pos + 16];
+                p->win_len = load_le_u32(buf + pos + 17);
+                stored_len = load_le_u32(buf + pos + 21);
+                pos += INDEX_POINT_SIZE;
+
+                if (p->win_len == 0 || p->win_len > IGZIP_HIST_SIZE || stored_len > p->win_len ||
+                    len - pos < stored_len || p->win_len > p->out ||
+                    (i > 0 && (p->out <= p[-1].out || p->in_bit <= p[-1].in_bit)))
+                        goto fail;
+
+                p->window = malloc(p->win_len);
+                if (p->window == NULL)
+                        goto fail;
+                index->count++;
+
+                if (index_load_window(p, buf + pos, stored_len))
+                        goto fail;
+                pos += stored_len;
+        }
+
+        return index;
+
+fail:
+        isal_inflate_index_free(index);
+        return NULL;
+}
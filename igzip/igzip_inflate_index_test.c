@@ -0,0 +1,221 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define TEST_SIZE    (4 * 1024 * 1024 + 77)
+#define PATTERN_SIZE (20 * 1024)
+#define SPACING      (256 * 1024)
+#define IN_PIECE     (64 * 1024 + 3)
+#define OUT_PIECE    7001
+#define READ_LEN     5000
+#define SEEK_TESTS   64
+
+static const uint16_t test_flags[] = { IGZIP_DEFLATE, IGZIP_GZIP, IGZIP_ZLIB };
+
+// Decompresses the whole stream in small pieces while building the index
+static int
+build_index(uint8_t *comp, uint32_t comp_len, uint8_t *out, uint32_t out_size, uint32_t crc_flag,
+            struct isal_inflate_index *index)
+{
+        struct inflate_state state;
+        uint32_t in_pos = 0, out_pos = 0;
+        int ret;
+
+        isal_inflate_init(&state);
+        state.crc_flag = crc_flag;
+
+        while (state.block_state != ISAL_BLOCK_FINISH) {
+                if (state.avail_in == 0 && in_pos < comp_len) {
+                        state.next_in = comp + in_pos;
+                        state.avail_in = comp_len - in_pos < IN_PIECE ? comp_len - in_pos
+                                                                       : IN_PIECE;
+                        in_pos += state.avail_in;
+                }
+                state.next_out = out + out_pos;
+                state.avail_out = out_size - out_pos < OUT_PIECE ? out_size - out_pos : OUT_PIECE;
+
+                ret = isal_inflate_index_build(&state, index);
+                if (ret)
+                        return ret;
+                if (state.next_out == out + out_pos && state.avail_in == 0 && in_pos == comp_len &&
+                    state.block_state != ISAL_BLOCK_FINISH)
+                        return ISAL_END_INPUT;
+                out_pos += state.next_out - (out + out_pos);
+        }
+
+        return out_pos == out_size ? ISAL_DECOMP_OK : ISAL_INVALID_BLOCK;
+}
+
+// Reads len bytes at offset through the index
+static int
+read_at(uint8_t *comp, uint32_t comp_len, struct isal_inflate_index *index, uint64_t offset,
+        uint8_t *buf, uint32_t len, uint64_t *restart)
+{
+        struct inflate_state state;
+        uint8_t tmp[OUT_PIECE];
+        uint64_t in_offset, out_pos;
+        uint32_t n, got = 0;
+        int ret;
+
+        ret = isal_inflate_seek(&state, index, offset, &in_offset, &out_pos);
+        if (ret)
+                return ret;
+        *restart = out_pos;
+
+        state.next_in = comp + in_offset;
+        state.avail_in = comp_len - in_offset;
+
+        while (got < len) {
+                state.next_out = tmp;
+                state.avail_out = sizeof(tmp);
+                ret = isal_inflate(&state);
+                if (ret)
+                        return ret;
+
+                for (n = 0; n < sizeof(tmp) - state.avail_out && got < len; n++, out_pos++)
+                        if (out_pos >= offset)
+                                buf[got++] = tmp[n];
+
+                if (state.block_state == ISAL_BLOCK_FINISH && got < len)
+                        return ISAL_END_INPUT;
+        }
+
+        return ISAL_DECOMP_OK;
+}
+
+int
+main(int argc, char *argv[])
+{
+        struct isal_inflate_index *index, *loaded;
+        uint8_t *in, *comp, *out, *saved, buf[READ_LEN];
+        uint32_t comp_size = TEST_SIZE + TEST_SIZE / 8, comp_len, f, i;
+        uint64_t saved_len, offset, restart;
+        int ret, fail = 0;
+
+        printf("igzip_inflate_index_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        in = malloc(TEST_SIZE);
+        comp = malloc(comp_size);
+        out = malloc(TEST_SIZE);
+        if (in == NULL || comp == NULL || out == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+
+        make_test_data(in, TEST_SIZE, PATTERN_SIZE, 192);
+
+        for (f = 0; f < sizeof(test_flags) / sizeof(test_flags[0]); f++) {
+                comp_len = test_compress(in, TEST_SIZE, comp, comp_size, 1, test_flags[f]);
+                index = isal_inflate_index_create(SPACING);
+                if (comp_len == 0 || index == NULL) {
+                        printf("setup failed\n");
+                        fail++;
+                        goto exit;
+                }
+
+                ret = build_index(comp, comp_len, out, TEST_SIZE, test_inflate_flag(test_flags[f]),
+                                  index);
+                if (ret || memcmp(in, out, TEST_SIZE)) {
+                        printf("Fail index build returned %d\n", ret);
+                        fail++;
+                        isal_inflate_index_free(index);
+                        goto exit;
+                }
+
+                saved_len = isal_inflate_index_size(index);
+                saved = malloc(saved_len);
+                if (saved == NULL || isal_inflate_index_save(index, saved, &saved_len)) {
+                        printf("Fail index save\n");
+                        fail++;
+                        free(saved);
+                        isal_inflate_index_free(index);
+                        goto exit;
+                }
+                loaded = isal_inflate_index_load(saved, saved_len);
+
+                for (i = 0; i < SEEK_TESTS && loaded != NULL && !fail; i++) {
+                        offset = (uint64_t) rand() * rand() % (TEST_SIZE - READ_LEN);
+                        if (i == 0)
+                                offset = 0;
+                        else if (i == 1)
+                                offset = TEST_SIZE - READ_LEN;
+
+                        ret = read_at(comp, comp_len, i & 1 ? loaded : index, offset, buf,
+                                      READ_LEN, &restart);
+                        if (ret || memcmp(buf, in + offset, READ_LEN)) {
+                                printf("Fail read at %lu returned %d\n", (unsigned long) offset,
+                                       ret);
+                                fail++;
+                        } else if (offset - restart > SPACING + SPACING / 2) {
+                                printf("Fail read at %lu restarted at %lu\n",
+                                       (unsigned long) offset, (unsigned long) restart);
+                                fail++;
+                        }
+                }
+
+                if (loaded == NULL) {
+                        printf("Fail index load\n");
+                        fail++;
+                }
+
+                /* Truncated or damaged indexes are rejected */
+                if (isal_inflate_index_load(saved, saved_len / 2) != NULL) {
+                        printf("Fail truncated index accepted\n");
+                        fail++;
+                }
+                saved[0] ^= 1;
+                if (isal_inflate_index_load(saved, saved_len) != NULL) {
+                        printf("Fail bad magic accepted\n");
+                        fail++;
+                }
+
+                free(saved);
+                isal_inflate_index_free(loaded);
+                isal_inflate_index_free(index);
+                if (fail)
+                        goto exit;
+                printf(".");
+                fflush(0);
+        }
+
+exit:
+        printf("\nigzip_inflate_index_test: %s\n", fail ? "Fail" : "Pass");
+        free(in);
+        free(comp);
+        free(out);
+        return fail;
+}
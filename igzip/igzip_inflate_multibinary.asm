@@ -35,6 +35,7 @@ default rel
 extern decode_huffman_code_block_stateless_base
 extern decode_huffman_code_block_stateless_01
 extern decode_huffman_code_block_stateless_04
+extern decode_huffman_code_block_stateless_10
 
 section .text
 
@@ -42,4 +43,4 @@ section .text
 
 
 mbin_interface		decode_huffman_code_block_stateless
-mbin_dispatch_init5	decode_huffman_code_block_stateless, decode_huffman_code_block_stateless_base, decode_huffman_code_block_stateless_01, decode_huffman_code_block_stateless_01, decode_huffman_code_block_stateless_04
+mbin_dispatch_init7	decode_huffman_code_block_stateless, decode_huffman_code_block_stateless_base, decode_huffman_code_block_stateless_01, decode_huffman_code_block_stateless_01, decode_huffman_code_block_stateless_04, decode_huffman_code_block_stateless_04, decode_huffman_code_block_stateless_10
@@ -0,0 +1,654 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_THREADS
+#include <pthread.h>
+#endif
+
+#include "igzip_lib.h"
+#include "crc.h"
+
+extern int
+decode_huffman_code_block_stateless(struct inflate_state *, uint8_t *start_out);
+extern int
+decode_huffman_code_block_markers(struct inflate_state *, uint16_t *out, uint32_t *out_len,
+                                  uint32_t out_size);
+extern int
+inflate_read_header(struct inflate_state *);
+extern int
+inflate_stateless_checksum(struct inflate_state *, uint8_t *start_out, int crc_done);
+
+#define IPAR_MIN_CHUNK_SIZE (1024 * IGZIP_K)
+#define IPAR_SYM_INIT_SIZE  (4 * IGZIP_HIST_SIZE)
+#define IPAR_OUT_RATIO      4
+
+/* Header bits of a non final block with dynamic huffman codes: BFINAL = 0, BTYPE = 2 */
+#define IPAR_DYN_HDR      4
+#define IPAR_DYN_HDR_BITS 3
+
+/* Output of a chunk. Until IGZIP_HIST_SIZE bytes have been decoded without a reference to the
+ * unknown window before the chunk, blocks are decoded into 16 bit symbols with window markers.
+ * After that the last IGZIP_HIST_SIZE symbols become the window at the start of buf and the rest
+ * of the chunk is decoded into buf by the regular stateless block decoder. */
+struct ipar_out {
+        uint16_t *sym;
+        uint32_t sym_len;
+        uint32_t sym_size;
+        uint32_t sym_clean; /* Index after the last window marker in sym */
+        uint8_t *buf;
+        uint32_t buf_len;
+        uint32_t buf_size;
+        uint32_t win_len; /* Leading bytes of buf that are a copy of the window */
+        int bytes;        /* Blocks are decoded into buf */
+        int grow;         /* sym and buf are owned and may be reallocated */
+};
+
+struct ipar_chunk {
+        uint64_t start_bit; /* Start of the search for the first block */
+        uint64_t limit_bit; /* Blocks starting at or past limit_bit belong to the next chunk */
+        uint64_t first_bit; /* First block found by the search */
+        uint64_t end_bit;
+        int final;
+        uint32_t crc; /* crc32 of the bytes in buf after the window */
+        struct ipar_out out;
+        int ret;
+};
+
+struct ipar_job {
+        uint8_t *in;
+        uint32_t in_len;
+        uint32_t chunk_size;
+        uint32_t num_chunks;
+        int gzip_crc;
+        struct ipar_chunk *chunks;
+        uint32_t next_chunk;
+#ifdef HAVE_THREADS
+        pthread_mutex_t mutex;
+#endif
+};
+
+static int
+ipar_get_chunk(struct ipar_job *job, uint32_t *chunk)
+{
+        int ret = 0;
+
+#ifdef HAVE_THREADS
+        pthread_mutex_lock(&job->mutex);
+#endif
+        if (job->next_chunk < job->num_chunks) {
+                *chunk = job->next_chunk++;
+                ret = 1;
+        }
+#ifdef HAVE_THREADS
+        pthread_mutex_unlock(&job->mutex);
+#endif
+        return ret;
+}
+
+static inline uint64_t
+ipar_bit_pos(struct ipar_job *job, struct inflate_state *s)
+{
+        return (uint64_t) (s->next_in - job->in) * 8 - s->read_in_length;
+}
+
+static void
+ipar_set_bit_pos(struct ipar_job *job, struct inflate_state *s, uint64_t bit)
+{
+        uint32_t byte = bit / 8, shift = bit % 8;
+
+        s->next_in = job->in + byte;
+        s->avail_in = job->in_len - byte;
+        s->read_in = 0;
+        s->read_in_length = 0;
+
+        if (shift != 0) {
+                s->read_in = job->in[byte] >> shift;
+                s->read_in_length = 8 - shift;
+                s->next_in++;
+                s->avail_in--;
+        }
+}
+
+/* Returns up to 24 bits starting at bit, bits past the end of the input read as 0 */
+static uint32_t
+ipar_peek_bits(struct ipar_job *job, uint64_t bit, uint32_t count)
+{
+        uint64_t byte = bit / 8;
+        uint32_t i, val = 0;
+
+        for (i = 0; i < 4 && byte + i < job->in_len; i++)
+                val |= (uint32_t) job->in[byte + i] << (8 * i);
+
+        return (val >> (bit % 8)) & ((1 << count) - 1);
+}
+
+/* Chunks end at the first block boundary at or past their limit that starts a non final dynamic
+ * block, which is the only kind of block the search in the next chunk looks for. */
+static int
+ipar_is_chunk_end(struct ipar_job *job, uint64_t bit, uint64_t limit)
+{
+        return bit >= limit && bit + IPAR_DYN_HDR_BITS <= (uint64_t) job->in_len * 8 &&
+               ipar_peek_bits(job, bit, IPAR_DYN_HDR_BITS) == IPAR_DYN_HDR;
+}
+
+/* Cheap filter for a dynamic block header at bit: plausible code counts and a complete code
+ * length code. Candidates that pass are checked by decoding the whole block. */
+static int
+ipar_is_candidate(struct ipar_job *job, uint64_t bit)
+{
+        uint32_t hlit, hdist, hclen, len, i;
+        uint32_t kraft = 0, codes = 0;
+
+        if (ipar_peek_bits(job, bit, IPAR_DYN_HDR_BITS) != IPAR_DYN_HDR)
+                return 0;
+
+        hlit = ipar_peek_bits(job, bit + 3, 5);
+        hdist = ipar_peek_bits(job, bit + 8, 5);
+        hclen = ipar_peek_bits(job, bit + 13, 4) + 4;
+        if (hlit > 29 || hdist > 29 || bit + 17 + 3 * hclen > (uint64_t) job->in_len * 8)
+                return 0;
+
+        for (i = 0; i < hclen; i++) {
+                len = ipar_peek_bits(job, bit + 17 + 3 * i, 3);
+                if (len != 0) {
+                        kraft += 128 >> len;
+                        codes++;
+                }
+        }
+
+        return kraft == 128 || (codes == 1 && kraft == 64);
+}
+
+/* Makes room for n more output values, growing the active buffer if it is owned */
+static int
+ipar_reserve(struct ipar_out *o, uint32_t n)
+{
+        uint64_t need, size;
+        void *tmp;
+
+        need = (uint64_t) (o->bytes ? o->buf_len : o->sym_len) + n;
+        size = o->bytes ? o->buf_size : o->sym_size;
+        if (need <= size)
+                return 0;
+
+        if (!o->grow || need > UINT32_MAX)
+                return ISAL_OUT_OVERFLOW;
+
+        size *= 2;
+        if (size < need)
+                size = need;
+        if (size > UINT32_MAX)
+                size = UINT32_MAX;
+
+        if (o->bytes) {
+                tmp = realloc(o->buf, size);
+                if (tmp == NULL)
+                        return ISAL_OUT_OVERFLOW;
+                o->buf = tmp;
+                o->buf_size = size;
+        } else {
+                tmp = realloc(o->sym, size * sizeof(*o->sym));
+                if (tmp == NULL)
+                        return ISAL_OUT_OVERFLOW;
+                o->sym = tmp;
+                o->sym_size = size;
+        }
+
+        return 0;
+}
+
+/* Moves a chunk to byte output once the last IGZIP_HIST_SIZE symbols are free of markers */
+static int
+ipar_switch_to_bytes(struct ipar_job *job, struct ipar_out *o)
+{
+        uint16_t *win = o->sym + o->sym_len - IGZIP_HIST_SIZE;
+        uint64_t size = IGZIP_HIST_SIZE + (uint64_t) IPAR_OUT_RATIO * job->chunk_size;
+        uint32_t i;
+
+        if (size > UINT32_MAX)
+                size = UINT32_MAX;
+
+        if (o->buf_size < size) {
+                free(o->buf);
+                o->buf = malloc(size);
+                o->buf_size = o->buf == NULL ? 0 : size;
+                if (o->buf == NULL)
+                        return ISAL_OUT_OVERFLOW;
+        }
+
+        for (i = 0; i < IGZIP_HIST_SIZE; i++)
+                o->buf[i] = (uint8_t) win[i];
+
+        o->win_len = IGZIP_HIST_SIZE;
+        o->buf_len = IGZIP_HIST_SIZE;
+        o->bytes = 1;
+        return 0;
+}
+
+static int
+ipar_stored_block(struct ipar_job *job, struct inflate_state *s, struct ipar_out *o)
+{
+        uint64_t start = (uint64_t) (s->next_in - job->in) - s->read_in_length / 8;
+        uint32_t len = s->type0_block_len;
+        uint8_t *src = job->in + start;
+        uint32_t i;
+        int ret;
+
+        if (start + len > job->in_len)
+                return ISAL_END_INPUT;
+
+        ret = ipar_reserve(o, len);
+        if (ret)
+                return ret;
+
+        if (o->bytes) {
+                memcpy(o->buf + o->buf_len, src, len);
+                o->buf_len += len;
+        } else {
+                for (i = 0; i < len; i++)
+                        o->sym[o->sym_len++] = src[i];
+        }
+
+        ipar_set_bit_pos(job, s, (start + len) * 8);
+        s->block_state = s->bfinal ? ISAL_BLOCK_INPUT_DONE : ISAL_BLOCK_NEW_HDR;
+        return 0;
+}
+
+/* Decodes a huffman coded block. When the output does not fit the block is decoded again from
+ * its start into a larger buffer. */
+static int
+ipar_coded_block(struct inflate_state *s, struct ipar_out *o)
+{
+        uint64_t read_in = s->read_in;
+        int32_t read_in_length = s->read_in_length;
+        uint8_t *next_in = s->next_in;
+        uint32_t avail_in = s->avail_in;
+        uint32_t len, i;
+        int ret;
+
+        for (;;) {
+                if (o->bytes) {
+                        s->next_out = o->buf + o->buf_len;
+                        s->avail_out = o->buf_size - o->buf_len;
+                        do
+                                ret = decode_huffman_code_block_stateless(s, o->buf);
+                        while (ret == 0 && s->block_state == ISAL_BLOCK_CODED);
+
+                        if (ret == 0) {
+                                o->buf_len = s->next_out - o->buf;
+                                return 0;
+                        }
+                } else {
+                        len = o->sym_len;
+                        ret = decode_huffman_code_block_markers(s, o->sym, &len, o->sym_size);
+
+                        if (ret == 0) {
+                                for (i = len; i > o->sym_len && i > o->sym_clean; i--)
+                                        if (o->sym[i - 1] >= 256) {
+                                                o->sym_clean = i;
+                                                break;
+                                        }
+                                o->sym_len = len;
+                                return 0;
+                        }
+                }
+
+                if (ret != ISAL_OUT_OVERFLOW)
+                        return ret;
+
+                ret = ipar_reserve(o, o->bytes ? o->buf_size - o->buf_len + 1
+                                               : o->sym_size - o->sym_len + 1);
+                if (ret)
+                        return ret;
+
+                s->read_in = read_in;
+                s->read_in_length = read_in_length;
+                s->next_in = next_in;
+                s->avail_in = avail_in;
+                s->block_state = ISAL_BLOCK_CODED;
+                s->write_overflow_lits = 0;
+                s->write_overflow_len = 0;
+                s->copy_overflow_length = 0;
+                s->copy_overflow_distance = 0;
+        }
+}
+
+static int
+ipar_block(struct ipar_job *job, struct inflate_state *s, struct ipar_out *o)
+{
+        int ret;
+
+        s->block_state = ISAL_BLOCK_NEW_HDR;
+        ret = inflate_read_header(s);
+        if (ret)
+                return ret;
+
+        if (s->block_state == ISAL_BLOCK_TYPE0)
+                return ipar_stored_block(job, s, o);
+
+        return ipar_coded_block(s, o);
+}
+
+/* Decodes blocks from the current position up to the end of the chunk or the final block */
+static int
+ipar_decode(struct ipar_job *job, struct inflate_state *s, struct ipar_out *o, uint64_t limit,
+            uint64_t *end_bit, int *final)
+{
+        uint64_t bit;
+        int ret;
+
+        for (;;) {
+                bit = ipar_bit_pos(job, s);
+                if (ipar_is_chunk_end(job, bit, limit)) {
+                        *end_bit = bit;
+                        *final = 0;
+                        return 0;
+                }
+
+                if (!o->bytes && o->sym_len >= (uint64_t) o->sym_clean + IGZIP_HIST_SIZE) {
+                        ret = ipar_switch_to_bytes(job, o);
+                        if (ret)
+                                return ret;
+                }
+
+                ret = ipar_block(job, s, o);
+                if (ret)
+                        return ret;
+
+                if (s->block_state == ISAL_BLOCK_INPUT_DONE) {
+                        *end_bit = ipar_bit_pos(job, s);
+                        *final = 1;
+                        return 0;
+                }
+        }
+}
+
+/* The first chunk is decoded straight into the caller's output. Every other chunk searches for
+ * its first block, which is accepted if the whole block decodes, and is kept in its own buffers
+ * until the output before it is known. */
+static void
+ipar_decode_chunk(struct ipar_job *job, struct inflate_state *s, uint32_t chunk)
+{
+        struct ipar_chunk *c = &job->chunks[chunk];
+        struct ipar_out *o = &c->out;
+        uint64_t bit = c->start_bit;
+        int ret = ISAL_INVALID_BLOCK;
+
+        isal_inflate_init(s);
+
+        if (chunk == 0) {
+                ipar_set_bit_pos(job, s, 0);
+                ret = ipar_block(job, s, o);
+        } else {
+                o->sym = malloc(IPAR_SYM_INIT_SIZE * sizeof(*o->sym));
+                if (o->sym == NULL) {
+                        c->ret = ISAL_OUT_OVERFLOW;
+                        return;
+                }
+                o->sym_size = IPAR_SYM_INIT_SIZE;
+
+                for (; bit < c->limit_bit; bit++) {
+                        if (!ipar_is_candidate(job, bit))
+                                continue;
+
+                        ipar_set_bit_pos(job, s, bit);
+                        o->sym_len = 0;
+                        o->sym_clean = 0;
+                        ret = ipar_block(job, s, o);
+                        if (ret == 0)
+                                break;
+                }
+        }
+
+        c->first_bit = bit;
+        if (ret == 0 && s->block_state == ISAL_BLOCK_INPUT_DONE) {
+                c->end_bit = ipar_bit_pos(job, s);
+                c->final = 1;
+        } else if (ret == 0)
+                ret = ipar_decode(job, s, o, c->limit_bit, &c->end_bit, &c->final);
+
+        if (ret == 0 && job->gzip_crc && o->bytes)
+                c->crc = crc32_gzip_refl(0, o->buf + o->win_len, o->buf_len - o->win_len);
+
+        c->ret = ret;
+}
+
+static void *
+ipar_worker(void *arg)
+{
+        struct ipar_job *job = (struct ipar_job *) arg;
+        struct inflate_state *s;
+        uint32_t chunk;
+
+        s = malloc(sizeof(*s));
+
+        while (ipar_get_chunk(job, &chunk)) {
+                if (s == NULL)
+                        job->chunks[chunk].ret = ISAL_OUT_OVERFLOW;
+                else
+                        ipar_decode_chunk(job, s, chunk);
+        }
+
+        free(s);
+        return NULL;
+}
+
+/* Appends a chunk decoded by a worker to the output, replacing window markers with the bytes
+ * that precede the chunk */
+static int
+ipar_emit_chunk(struct ipar_chunk *c, uint8_t *out, uint32_t *out_len, uint32_t out_size)
+{
+        struct ipar_out *o = &c->out;
+        uint32_t pos = *out_len;
+        uint32_t bytes = o->bytes ? o->buf_len - o->win_len : 0;
+        uint8_t *dst = out + pos;
+        uint32_t i, idx;
+
+        if ((uint64_t) o->sym_len + bytes > out_size - pos)
+                return ISAL_OUT_OVERFLOW;
+
+        for (i = 0; i < o->sym_len; i++) {
+                if (o->sym[i] < 256) {
+                        dst[i] = (uint8_t) o->sym[i];
+                        continue;
+                }
+
+                idx = o->sym[i] - 256;
+                if (pos + idx < IGZIP_HIST_SIZE)
+                        return ISAL_INVALID_LOOKBACK;
+                dst[i] = out[pos + idx - IGZIP_HIST_SIZE];
+        }
+
+        memcpy(dst + o->sym_len, o->buf + o->win_len, bytes);
+        *out_len = pos + o->sym_len + bytes;
+        return 0;
+}
+
+int
+isal_inflate_parallel(struct inflate_state *state, uint32_t num_threads)
+{
+        struct ipar_job job;
+        struct ipar_chunk *c;
+        struct ipar_out serial;
+        uint8_t *start_out = state->next_out;
+        uint32_t out_size = state->avail_out;
+        uint32_t i, out_len = 0, prev_len;
+        uint64_t pos = 0;
+        int final = 0, ret = 0;
+#ifdef HAVE_THREADS
+        pthread_t *threads = NULL;
+        uint32_t started = 0;
+#endif
+
+        if (num_threads <= 1 || state->avail_in < 2 * IPAR_MIN_CHUNK_SIZE)
+                return isal_inflate_stateless(state);
+
+        state->read_in = 0;
+        state->read_in_length = 0;
+        state->block_state = ISAL_BLOCK_NEW_HDR;
+        state->dict_length = 0;
+        state->bfinal = 0;
+        state->crc = 0;
+        state->total_out = 0;
+        state->hist_bits = 0;
+        state->tmp_in_size = 0;
+
+        if (state->crc_flag == IGZIP_GZIP) {
+                struct isal_gzip_header gz_hdr;
+
+                isal_gzip_header_init(&gz_hdr);
+                ret = isal_read_gzip_header(state, &gz_hdr);
+                if (ret)
+                        return ret;
+        } else if (state->crc_flag == IGZIP_ZLIB) {
+                struct isal_zlib_header z_hdr;
+
+                isal_zlib_header_init(&z_hdr);
+                ret = isal_read_zlib_header(state, &z_hdr);
+                if (ret)
+                        return ret;
+                if (z_hdr.dict_flag)
+                        return ISAL_NEED_DICT;
+        }
+
+        job.in = state->next_in - state->read_in_length / 8;
+        job.in_len = state->avail_in + state->read_in_length / 8;
+        job.chunk_size = (job.in_len + num_threads - 1) / num_threads;
+        if (job.chunk_size < IPAR_MIN_CHUNK_SIZE)
+                job.chunk_size = IPAR_MIN_CHUNK_SIZE;
+        job.num_chunks = (job.in_len + job.chunk_size - 1) / job.chunk_size;
+        if (job.num_chunks == 0)
+                job.num_chunks = 1;
+        job.next_chunk = 0;
+        job.gzip_crc = state->crc_flag == ISAL_GZIP || state->crc_flag == ISAL_GZIP_NO_HDR ||
+                       state->crc_flag == ISAL_GZIP_NO_HDR_VER;
+
+        job.chunks = calloc(job.num_chunks, sizeof(*job.chunks));
+        if (job.chunks == NULL)
+                return isal_inflate_stateless(state);
+
+        for (i = 0; i < job.num_chunks; i++) {
+                c = &job.chunks[i];
+                c->start_bit = (uint64_t) i * job.chunk_size * 8;
+                c->limit_bit = (i == job.num_chunks - 1) ? UINT64_MAX
+                                                         : (uint64_t) (i + 1) * job.chunk_size * 8;
+                c->out.grow = (i != 0);
+        }
+        c = &job.chunks[0];
+        c->out.buf = start_out;
+        c->out.buf_size = out_size;
+        c->out.bytes = 1;
+
+        if (num_threads > job.num_chunks)
+                num_threads = job.num_chunks;
+
+#ifdef HAVE_THREADS
+        pthread_mutex_init(&job.mutex, NULL);
+        if (num_threads > 1)
+                threads = malloc((num_threads - 1) * sizeof(*threads));
+        if (threads != NULL)
+                for (started = 0; started < num_threads - 1; started++)
+                        if (pthread_create(&threads[started], NULL, ipar_worker, &job))
+                                break;
+#endif
+
+        ipar_worker(&job);
+
+#ifdef HAVE_THREADS
+        for (i = 0; i < started; i++)
+                pthread_join(threads[i], NULL);
+        free(threads);
+        pthread_mutex_destroy(&job.mutex);
+#endif
+
+        /* Chunks are joined in order. A chunk is used if its search found the block the
+         * previous chunk ended on, otherwise that range is decoded again on this thread. */
+        for (i = 0; i < job.num_chunks && !final && ret == 0; i++) {
+                c = &job.chunks[i];
+                prev_len = out_len;
+
+                if (c->ret == 0 && c->first_bit == pos) {
+                        if (i == 0)
+                                out_len = c->out.buf_len;
+                        else
+                                ret = ipar_emit_chunk(c, start_out, &out_len, out_size);
+
+                        if (ret == 0 && job.gzip_crc) {
+                                state->crc = crc32_gzip_refl(state->crc, start_out + prev_len,
+                                                             c->out.sym_len);
+                                state->crc = crc32_gzip_refl_combine(
+                                        state->crc, c->crc, out_len - prev_len - c->out.sym_len);
+                        }
+
+                        pos = c->end_bit;
+                        final = c->final;
+                        continue;
+                }
+
+                memset(&serial, 0, sizeof(serial));
+                serial.buf = start_out;
+                serial.buf_len = out_len;
+                serial.buf_size = out_size;
+                serial.bytes = 1;
+
+                ipar_set_bit_pos(&job, state, pos);
+                ret = ipar_decode(&job, state, &serial, c->limit_bit, &pos, &final);
+                out_len = serial.buf_len;
+
+                if (ret == 0 && job.gzip_crc)
+                        state->crc = crc32_gzip_refl(state->crc, start_out + prev_len,
+                                                     out_len - prev_len);
+        }
+
+        for (i = 1; i < job.num_chunks; i++) {
+                free(job.chunks[i].out.sym);
+                free(job.chunks[i].out.buf);
+        }
+        free(job.chunks);
+
+        if (ret == 0 && !final)
+                ret = ISAL_END_INPUT;
+
+        if (ret == 0) {
+                pos = (pos + 7) / 8;
+                state->next_in = job.in + pos;
+                state->avail_in = job.in_len - pos;
+                state->read_in = 0;
+                state->read_in_length = 0;
+                state->next_out = start_out + out_len;
+                state->avail_out = out_size - out_len;
+                state->total_out = out_len;
+                state->block_state = ISAL_BLOCK_FINISH;
+                ret = inflate_stateless_checksum(state, start_out, job.gzip_crc);
+        }
+
+        return ret;
+}
@@ -0,0 +1,168 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define MAX_TEST_SIZE (12 * 1024 * 1024 + 321)
+#define PATTERN_SIZE  (24 * 1024)
+#define RANDOM_OFFSET (5 * 1024 * 1024)
+#define RANDOM_SIZE   (300 * 1024)
+#define MAX_THREADS   8
+
+static const uint16_t test_flags[] = { IGZIP_DEFLATE, IGZIP_GZIP, IGZIP_ZLIB };
+
+static int
+inflate(uint8_t *comp, uint32_t comp_len, uint8_t *out, uint32_t out_size, uint16_t gzip_flag,
+        uint32_t threads, uint32_t *out_len)
+{
+        struct inflate_state state;
+        int ret;
+
+        isal_inflate_init(&state);
+        state.next_in = comp;
+        state.avail_in = comp_len;
+        state.next_out = out;
+        state.avail_out = out_size;
+        state.crc_flag = test_inflate_flag(gzip_flag);
+
+        if (threads == 0)
+                ret = isal_inflate_stateless(&state);
+        else
+                ret = isal_inflate_parallel(&state, threads);
+
+        *out_len = state.total_out;
+        if (ret == ISAL_DECOMP_OK && state.avail_in != 0) {
+                printf("%u bytes of input left\n", state.avail_in);
+                return -1;
+        }
+        return ret;
+}
+
+int
+main(int argc, char *argv[])
+{
+        uint8_t *in, *comp, *out;
+        uint32_t comp_size = MAX_TEST_SIZE + MAX_TEST_SIZE / 8, comp_len, out_len;
+        uint32_t f, threads;
+        int level, ret, ref, fail = 0;
+
+        printf("igzip_inflate_parallel_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        in = malloc(MAX_TEST_SIZE);
+        comp = malloc(comp_size);
+        out = malloc(MAX_TEST_SIZE);
+        if (in == NULL || comp == NULL || out == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+
+        // Data that compresses to a few MB in many dynamic blocks, with an incompressible region
+        // in the middle that is written as stored blocks
+        make_test_data(in, MAX_TEST_SIZE, PATTERN_SIZE, 64);
+        make_test_data(in + RANDOM_OFFSET, RANDOM_SIZE, 0, 0);
+
+        for (level = ISAL_DEF_MIN_LEVEL; level <= ISAL_DEF_MAX_LEVEL; level++) {
+                for (f = 0; f < sizeof(test_flags) / sizeof(test_flags[0]); f++) {
+                        comp_len = test_compress(in, MAX_TEST_SIZE, comp, comp_size, level,
+                                                 test_flags[f]);
+                        if (comp_len == 0) {
+                                printf("deflate failed\n");
+                                fail++;
+                                goto exit;
+                        }
+
+                        for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+                                memset(out, 0, MAX_TEST_SIZE);
+                                ret = inflate(comp, comp_len, out, MAX_TEST_SIZE, test_flags[f],
+                                              threads, &out_len);
+                                if (ret != ISAL_DECOMP_OK) {
+                                        printf("inflate returned %d\n", ret);
+                                        fail++;
+                                } else if (out_len != MAX_TEST_SIZE ||
+                                           memcmp(in, out, MAX_TEST_SIZE)) {
+                                        printf("decompressed data mismatch\n");
+                                        fail++;
+                                }
+                                if (fail) {
+                                        printf("Fail level=%d flag=%d threads=%u\n", level,
+                                               test_flags[f], threads);
+                                        goto exit;
+                                }
+                        }
+                }
+                printf(".");
+                fflush(0);
+        }
+
+        /* Errors must match a single threaded decode of the same input */
+        comp_len = test_compress(in, MAX_TEST_SIZE, comp, comp_size, 1, IGZIP_GZIP);
+
+        ret = inflate(comp, comp_len, out, MAX_TEST_SIZE - 1, IGZIP_GZIP, MAX_THREADS, &out_len);
+        if (ret != ISAL_OUT_OVERFLOW) {
+                printf("Fail overflow not detected %d\n", ret);
+                fail++;
+        }
+
+        ref = inflate(comp, comp_len / 2, out, MAX_TEST_SIZE, IGZIP_GZIP, 0, &out_len);
+        ret = inflate(comp, comp_len / 2, out, MAX_TEST_SIZE, IGZIP_GZIP, MAX_THREADS, &out_len);
+        if (ret != ref || ret == ISAL_DECOMP_OK) {
+                printf("Fail truncated input returned %d, expected %d\n", ret, ref);
+                fail++;
+        }
+
+        comp[comp_len - 8] ^= 1;
+        ret = inflate(comp, comp_len, out, MAX_TEST_SIZE, IGZIP_GZIP, MAX_THREADS, &out_len);
+        if (ret != ISAL_INCORRECT_CHECKSUM) {
+                printf("Fail bad checksum returned %d\n", ret);
+                fail++;
+        }
+        comp[comp_len - 8] ^= 1;
+
+        comp[comp_len / 2] ^= 0x5a;
+        ref = inflate(comp, comp_len, out, MAX_TEST_SIZE, IGZIP_GZIP, 0, &out_len);
+        ret = inflate(comp, comp_len, out, MAX_TEST_SIZE, IGZIP_GZIP, MAX_THREADS, &out_len);
+        if (ret != ref || ret == ISAL_DECOMP_OK) {
+                printf("Fail corrupt input returned %d, expected %d\n", ret, ref);
+                fail++;
+        }
+
+exit:
+        printf("\nigzip_inflate_parallel_test: %s\n", fail ? "Fail" : "Pass");
+        free(in);
+        free(comp);
+        free(out);
+        return fail;
+}
@@ -0,0 +1,148 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+#include "crc.h"
+#include "test.h"
+#include "igzip_test_data.h"
+
+#define TEST_SIZE    (3 * 1024 * 1024 + 11)
+#define PATTERN_SIZE (20 * 1024)
+
+// Verifies comp feeding at most in_piece bytes per call
+static int
+verify(uint8_t *comp, uint32_t comp_len, uint16_t crc_flag, uint32_t in_piece,
+       uint32_t *total_out, uint32_t *crc)
+{
+        struct inflate_state state;
+        uint32_t in_pos = 0;
+        int ret;
+
+        isal_inflate_init(&state);
+        state.crc_flag = crc_flag;
+        state.next_out = NULL;
+        state.avail_out = 0;
+
+        do {
+                state.next_in = comp + in_pos;
+                state.avail_in = comp_len - in_pos < in_piece ? comp_len - in_pos : in_piece;
+                in_pos += state.avail_in;
+                ret = isal_inflate_verify(&state);
+                in_pos -= state.avail_in;
+        } while (ret == ISAL_DECOMP_OK && state.block_state != ISAL_BLOCK_FINISH &&
+                 in_pos < comp_len);
+
+        if (state.next_out != NULL || state.avail_out != 0)
+                return ISAL_INVALID_STATE;
+
+        *total_out = state.total_out;
+        *crc = state.crc;
+        if (ret == ISAL_DECOMP_OK && state.block_state != ISAL_BLOCK_FINISH)
+                return ISAL_END_INPUT;
+
+        return ret;
+}
+
+int
+main(int argc, char *argv[])
+{
+        uint16_t flags[] = { IGZIP_DEFLATE, IGZIP_GZIP, IGZIP_ZLIB };
+        uint32_t pieces[] = { 1, 4093, TEST_SIZE };
+        uint8_t *in, *comp;
+        uint32_t comp_size = 2 * TEST_SIZE, comp_len, total_out, crc, i, p;
+        int level, ret, fail = 0;
+
+        printf("igzip_inflate_verify_test seed=0x%x\n", TEST_SEED);
+        srand(TEST_SEED);
+
+        in = malloc(TEST_SIZE);
+        comp = malloc(comp_size);
+        if (in == NULL || comp == NULL) {
+                printf("alloc error: Fail\n");
+                return -1;
+        }
+
+        make_test_data(in, TEST_SIZE, PATTERN_SIZE, 192);
+
+        for (level = 0; level <= 3; level += 3) {
+                for (i = 0; i < sizeof(flags) / sizeof(flags[0]); i++) {
+                        comp_len = test_compress(in, TEST_SIZE, comp, comp_size, level, flags[i]);
+                        if (comp_len == 0) {
+                                printf("deflate failed\n");
+                                fail++;
+                                goto exit;
+                        }
+
+                        for (p = 0; p < sizeof(pieces) / sizeof(pieces[0]); p++) {
+                                if (pieces[p] == 1 && level > 0)
+                                        continue;
+                                ret = verify(comp, comp_len, flags[i], pieces[p], &total_out,
+                                             &crc);
+                                if (ret != ISAL_DECOMP_OK || total_out != TEST_SIZE) {
+                                        printf("Fail verify level=%d flag=%d piece=%d ret=%d\n",
+                                               level, flags[i], pieces[p], ret);
+                                        fail++;
+                                        goto exit;
+                                }
+                                if (flags[i] == IGZIP_GZIP &&
+                                    crc != crc32_gzip_refl(0, in, TEST_SIZE)) {
+                                        printf("Fail crc level=%d\n", level);
+                                        fail++;
+                                        goto exit;
+                                }
+                        }
+
+                        // A damaged trailer must fail the checksum
+                        if (flags[i] != IGZIP_DEFLATE) {
+                                comp[comp_len - 1] ^= 0x10;
+                                ret = verify(comp, comp_len, flags[i], TEST_SIZE, &total_out,
+                                             &crc);
+                                comp[comp_len - 1] ^= 0x10;
+                                if (ret != ISAL_INCORRECT_CHECKSUM) {
+                                        printf("Fail damaged trailer level=%d flag=%d ret=%d\n",
+                                               level, flags[i], ret);
+                                        fail++;
+                                        goto exit;
+                                }
+                        }
+                        printf(".");
+                        fflush(0);
+                }
+        }
+
+exit:
+        printf("\nigzip_inflate_verify_test: %s\n", fail ? "Fail" : "Pass");
+        free(in);
+        free(comp);
+        return fail;
+}
@@ -42,6 +42,7 @@ struct level_buf {
                 struct hash8k_buf lvl1;
                 struct hash_hist_buf lvl2;
                 struct hash_map_buf lvl3;
+                struct hash_map_buf lvl4;
         };
 };
 
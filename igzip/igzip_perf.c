@@ -36,13 +36,14 @@
 #include <getopt.h>
 #include "huff_codes.h"
 #include "igzip_lib.h"
+#include "crc.h"
 #include "test.h"
 
 #include <zlib.h>
 
 #define BUF_SIZE 1024
 
-#define OPTARGS "hl:f:z:i:d:stub:y:w:o:D:c"
+#define OPTARGS "hl:f:z:i:d:stukb:y:w:o:D:c"
 
 #if defined(__x86_64__) || defined(_M_X64)
 static int show_cycles = 0; /* -c: show cycles/byte instead of throughput */
@@ -163,6 +164,7 @@ struct inflate_modes {
         int32_t stateless;
         int32_t stateful;
         int32_t zlib;
+        int32_t checksum;
 };
 
 struct perf_info {
@@ -208,6 +210,8 @@ usage(void)
                                                                                                          "  -s          performance test isa-l stateful inflate\n"
                                                                                                          "  -t          performance test isa-l stateless inflate\n"
                                                                                                          "  -u          performance test zlib inflate\n"
+                                                                                                         "  -k          performance test isa-l stateless inflate with and without the gzip\n"
+                                                                                                         "              crc, to show the cost of the checksum\n"
                                                                                                          "  -D <file>   use dictionary file\n"
                                                                                                          "  -o <file>   output file to store compressed data (last one if multiple)\n"
                                                                                                          "  -b <size>   input buffer size, applies to stateful options (-f,-z,-s)\n"
@@ -416,6 +420,22 @@ isal_inflate_round(struct inflate_state *state, uint8_t *inbuf, uint32_t inbuf_s
         return 0;
 }
 
+/* Stateless inflate of a raw deflate stream, with the gzip crc of the output if crc is set */
+int
+isal_inflate_crc_round(struct inflate_state *state, uint8_t *inbuf, uint32_t inbuf_size,
+                       uint8_t *outbuf, uint32_t outbuf_size, int hist_bits, int crc)
+{
+        isal_inflate_init(state);
+        state->next_in = inbuf;
+        state->avail_in = inbuf_size;
+        state->next_out = outbuf;
+        state->avail_out = outbuf_size;
+        state->crc_flag = crc ? ISAL_GZIP_NO_HDR : ISAL_DEFLATE;
+        state->hist_bits = hist_bits;
+
+        return isal_inflate_stateless(state) != 0;
+}
+
 int
 isal_deflate_stateful_round(struct isal_zstream *stream, uint8_t *outbuf, uint32_t outbuf_size,
                             uint8_t *inbuf, uint32_t inbuf_size, uint32_t in_block_size,
@@ -693,6 +713,27 @@ isal_inflate_perf(uint8_t *inbuf, uint64_t inbuf_size, uint8_t *outbuf, uint64_t
         return check;
 }
 
+int
+isal_inflate_crc_perf(uint8_t *inbuf, uint64_t inbuf_size, uint8_t *outbuf, uint64_t outbuf_size,
+                      uint8_t *filebuf, uint64_t file_size, int hist_bits, int crc, int time,
+                      struct perf *start)
+{
+        struct inflate_state state;
+        int check;
+
+        check = isal_inflate_crc_round(&state, inbuf, inbuf_size, outbuf, outbuf_size, hist_bits,
+                                       crc);
+        if (check || state.total_out != file_size || memcmp(outbuf, filebuf, file_size) ||
+            (crc && state.crc != crc32_gzip_refl(0, filebuf, file_size)))
+                return 1;
+
+        BENCHMARK(start, time,
+                  isal_inflate_crc_round(&state, inbuf, inbuf_size, outbuf, outbuf_size,
+                                         hist_bits, crc));
+
+        return 0;
+}
+
 int
 isal_inflate_stateful_perf(uint8_t *inbuf, uint64_t inbuf_size, uint8_t *outbuf,
                            uint64_t outbuf_size, uint8_t *filebuf, uint64_t file_size,
@@ -758,7 +799,7 @@ main(int argc, char *argv[])
         FILE *dict_fn = NULL;
         unsigned char *compressbuf, *decompbuf, *filebuf;
         char *outfile = NULL;
-        int i, c, ret = 0;
+        int i, j, c, ret = 0;
         int dict_file_size = 0;
         uint8_t *dict_buf = NULL;
         uint64_t decompbuf_size, compressbuf_size;
@@ -866,6 +907,9 @@ main(int argc, char *argv[])
                 case 'u':
                         inflate_strat.zlib = 1;
                         break;
+                case 'k':
+                        inflate_strat.checksum = 1;
+                        break;
                 case 'b':
                         inflate_strat.stateful = 1;
                         info.inblock_size = atoi(optarg);
@@ -904,7 +948,8 @@ main(int argc, char *argv[])
         if (optind >= argc)
                 usage();
 
-        if (!inflate_strat.stateless && !inflate_strat.stateful && !inflate_strat.zlib) {
+        if (!inflate_strat.stateless && !inflate_strat.stateful && !inflate_strat.zlib &&
+            !inflate_strat.checksum) {
                 if (info.inblock_size == 0)
                         inflate_strat.stateless = 1;
                 else
@@ -1063,6 +1108,24 @@ main(int argc, char *argv[])
                                 print_perf_line(&info, "inflate");
                 }
 
+                if (inflate_strat.checksum && dict_file_size == 0) {
+                        /* The difference is the cost of the checksum pass over the output, which
+                         * reads it back from memory once it is larger than the last level cache */
+                        for (j = 1; j >= 0; j--) {
+                                ret = isal_inflate_crc_perf(compressbuf, info.deflate_size,
+                                                            decompbuf, decompbuf_size, filebuf,
+                                                            info.file_size, info.hist_bits, j,
+                                                            info.inflate_time, &info.start);
+                                if (ret) {
+                                        printf("    Error in isal crc inflate\n");
+                                        continue;
+                                }
+                                printf(j ? "    isal_crc_inflate->    "
+                                         : "    isal_no_crc_inflate-> ");
+                                perf_print(info.start, info.file_size);
+                        }
+                }
+
                 if (inflate_strat.zlib) {
                         info.inflate_mode = ZLIB;
                         ret = zlib_inflate_perf(compressbuf, info.deflate_size, decompbuf,
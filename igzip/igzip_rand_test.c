@@ -121,6 +121,7 @@ static const uint32_t gzip_extra_bytes = 18; /* gzip_hdr_bytes + gzip_trl_bytes
 static const uint32_t zlib_extra_bytes = 6;  /* zlib_hdr_bytes + zlib_trl_bytes */
 
 int inflate_type = 0;
+int strategy = ISAL_DEFAULT_STRATEGY;
 
 struct isal_hufftables *hufftables = NULL;
 struct isal_hufftables *hufftables_subset = NULL;
@@ -326,6 +327,9 @@ get_rand_level_buf_size(int level)
 {
         int size;
         switch (level) {
+        case 4:
+                size = rand() % IBUF_SIZE + ISAL_DEF_LVL4_MIN;
+                break;
         case 3:
                 size = rand() % IBUF_SIZE + ISAL_DEF_LVL3_MIN;
                 break;
@@ -1137,6 +1141,7 @@ compress_multi_pass(uint8_t *data, uint32_t data_size, uint8_t *compressed_buf,
         stream->avail_out = 0;
         stream->gzip_flag = gzip_flag;
         stream->level = level;
+        stream->strategy = strategy;
         stream->hist_bits = hist_bits;
 
         if (level >= 1) {
@@ -1329,6 +1334,7 @@ compress_single_pass(uint8_t *data, uint32_t data_size, uint8_t *compressed_buf,
         stream.end_of_stream = 1;
         stream.gzip_flag = gzip_flag;
         stream.level = level;
+        stream.strategy = strategy;
         stream.hist_bits = hist_bits;
 
         if (level >= 1) {
@@ -1405,6 +1411,7 @@ compress_ver_rep_buf(uint8_t *data, uint32_t data_size, uint64_t data_rep_size,
         stream.end_of_stream = 0;
         stream.gzip_flag = gzip_flag;
         stream.level = level;
+        stream.strategy = strategy;
 
         if (level >= 1) {
                 level_buf_size = get_rand_level_buf_size(stream.level);
@@ -1541,6 +1548,7 @@ compress_stateless(uint8_t *data, uint32_t data_size, uint8_t *compressed_buf,
         stream.next_out = compressed_buf;
         stream.gzip_flag = gzip_flag;
         stream.level = level;
+        stream.strategy = strategy;
         stream.hist_bits = hist_bits;
 
         if (level == 1) {
@@ -1647,6 +1655,7 @@ compress_stateless_full_flush(uint8_t *data, uint32_t data_size, uint8_t *compre
         stream.avail_out = *compressed_size;
         stream.next_out = compressed_buf;
         stream.level = level;
+        stream.strategy = strategy;
         stream.hist_bits = hist_bits;
 
         if (level == 1) {
@@ -1792,6 +1801,7 @@ compress_full_flush(uint8_t *data, uint32_t data_size, uint8_t *compressed_buf,
         stream.total_out = 0;
         stream.gzip_flag = gzip_flag;
         stream.level = level;
+        stream.strategy = strategy;
 
         if (level >= 1) {
                 level_buf_size = get_rand_level_buf_size(stream.level);
@@ -1927,6 +1937,7 @@ compress_swap_flush(uint8_t *data, uint32_t data_size, uint8_t *compressed_buf,
         stream.next_out = compressed_buf;
         stream.end_of_stream = 0;
         stream.gzip_flag = gzip_flag;
+        stream.strategy = strategy;
         if (level) {
                 stream.level = level;
                 level_buf_size = get_rand_level_buf_size(stream.level);
@@ -3109,6 +3120,32 @@ exit_stateful_full_flush:
         }
 
 exit_stateful_change_flush:
+        printf("%s\n", ret ? "Fail" : "Pass");
+        if (ret)
+                goto main_exit;
+
+        printf("igzip_rand_test strategies:             ");
+
+        for (i = 0; i < options.randoms / 4; i++) {
+                strategy = ISAL_HUFFMAN_ONLY + i % 3;
+                in_size = get_rand_data_length();
+                offset = rand() % (IBUF_SIZE + 1 - in_size);
+                in_buf += offset;
+
+                create_rand_repeat_data(in_buf, in_size);
+
+                ret |= test_compress_stateless(in_buf, in_size, NO_FLUSH);
+                ret |= test_compress(in_buf, in_size, rand() % 3);
+
+                in_buf -= offset;
+
+                if (options.verbose && (i % ((options.randoms / 4) / 16) == 0))
+                        printf(".");
+                if (ret)
+                        break;
+        }
+        strategy = ISAL_DEFAULT_STRATEGY;
+
         printf("%s\n", ret ? "Fail" : "Pass");
         if (ret)
                 goto main_exit;
@@ -0,0 +1,160 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/* Test data and compression helpers shared by the igzip unit tests */
+
+#ifndef _IGZIP_TEST_DATA_H
+#define _IGZIP_TEST_DATA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "igzip_lib.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED 0x1234
+#endif
+
+#define TEST_LEVEL_BUF_SIZE ISAL_DEF_LVL3_DEFAULT
+
+// Returns a level_buf large enough for every compression level
+static inline uint8_t *
+test_level_buf(void)
+{
+        static uint8_t level_buf[TEST_LEVEL_BUF_SIZE];
+
+        return level_buf;
+}
+
+// Fills buf with letters where, past the first pattern bytes, a byte repeats the one pattern
+// bytes back with a chance of repeat in 256, giving long range matches. With a pattern of 0
+// the data is random.
+static inline void
+make_test_data(uint8_t *buf, uint32_t len, uint32_t pattern, uint32_t repeat)
+{
+        uint32_t i;
+
+        for (i = 0; i < len; i++) {
+                if (pattern == 0)
+                        buf[i] = rand();
+                else if (i >= pattern && (uint32_t) (rand() & 0xff) < repeat)
+                        buf[i] = buf[i - pattern];
+                else
+                        buf[i] = 'a' + rand() % 16;
+        }
+}
+
+// Returns the inflate crc_flag that matches a deflate gzip_flag
+static inline uint32_t
+test_inflate_flag(uint16_t gzip_flag)
+{
+        switch (gzip_flag) {
+        case IGZIP_GZIP:
+                return ISAL_GZIP;
+        case IGZIP_GZIP_NO_HDR:
+                return ISAL_GZIP_NO_HDR_VER;
+        case IGZIP_ZLIB:
+                return ISAL_ZLIB;
+        default:
+                return ISAL_DEFLATE;
+        }
+}
+
+// Compresses in with a stream the caller has initialized, in one isal_deflate() call or with
+// a SYNC_FLUSH every flush_size bytes. Returns the compressed length, or 0 on error.
+static inline uint32_t
+test_deflate(struct isal_zstream *stream, uint8_t *in, uint32_t in_len, uint8_t *comp,
+             uint32_t comp_size, uint32_t flush_size)
+{
+        uint32_t pos = 0, len;
+
+        stream->next_out = comp;
+        stream->avail_out = comp_size;
+        stream->level_buf = test_level_buf();
+        stream->level_buf_size = TEST_LEVEL_BUF_SIZE;
+        if (flush_size != 0)
+                stream->flush = SYNC_FLUSH;
+        else
+                flush_size = in_len;
+
+        do {
+                len = in_len - pos < flush_size ? in_len - pos : flush_size;
+                stream->next_in = in + pos;
+                stream->avail_in = len;
+                stream->end_of_stream = (pos + len == in_len);
+                pos += len;
+                if (isal_deflate(stream) != COMP_OK || stream->avail_in != 0)
+                        return 0;
+        } while (pos < in_len);
+
+        return stream->internal_state.state == ZSTATE_END ? stream->total_out : 0;
+}
+
+static inline uint32_t
+test_compress(uint8_t *in, uint32_t in_len, uint8_t *comp, uint32_t comp_size, int level,
+              uint16_t gzip_flag)
+{
+        struct isal_zstream stream;
+
+        isal_deflate_init(&stream);
+        stream.level = level;
+        stream.gzip_flag = gzip_flag;
+        return test_deflate(&stream, in, in_len, comp, comp_size, 0);
+}
+
+// Inflates comp in one isal_inflate_stateless() call and compares the result with in
+static inline int
+test_inflate_check(uint8_t *in, uint32_t in_len, uint8_t *comp, uint32_t comp_len, uint8_t *out,
+                   uint32_t out_size, uint16_t gzip_flag, uint32_t hist_bits)
+{
+        struct inflate_state state;
+        int ret;
+
+        isal_inflate_init(&state);
+        state.next_in = comp;
+        state.avail_in = comp_len;
+        state.next_out = out;
+        state.avail_out = out_size;
+        state.crc_flag = test_inflate_flag(gzip_flag);
+        state.hist_bits = hist_bits;
+
+        ret = isal_inflate_stateless(&state);
+        if (ret != ISAL_DECOMP_OK) {
+                printf("inflate returned %d\n", ret);
+                return 1;
+        }
+        if (state.total_out != in_len || memcmp(in, out, in_len)) {
+                printf("decompressed data mismatch\n");
+                return 1;
+        }
+        return 0;
+}
+
+#endif // _IGZIP_TEST_DATA_H
@@ -90,6 +90,30 @@ deflateInit2_(z_streamp strm, int level, int method, int windowBits, int memLeve
                 return -1;
         }
 
+        // Map Zlib strategies to ISA-L strategies, Z_FILTERED has no counterpart
+        switch (strategy) {
+        case Z_DEFAULT_STRATEGY:
+        case Z_FILTERED:
+                isal_strm->strategy = ISAL_DEFAULT_STRATEGY;
+                break;
+        case Z_HUFFMAN_ONLY:
+                isal_strm->strategy = ISAL_HUFFMAN_ONLY;
+                break;
+        case Z_RLE:
+                isal_strm->strategy = ISAL_RLE;
+                break;
+        case Z_FIXED:
+                isal_strm->strategy = ISAL_FIXED;
+                break;
+        default:
+#ifdef DEBUG
+                fprintf(stderr, "Error: Invalid compression strategy\n");
+#endif
+                free(isal_strm->level_buf);
+                free(isal_strm);
+                return Z_STREAM_ERROR;
+        }
+
         if (!isal_strm->level_buf) {
                 free(isal_strm);
 #ifdef DEBUG
@@ -121,3 +121,9 @@ typedef struct internal_state {
 #define Z_BUF_ERROR    (-5)
 
 #define Z_DEFAULT_COMPRESSION 6
+
+#define Z_FILTERED         1
+#define Z_HUFFMAN_ONLY     2
+#define Z_RLE              3
+#define Z_FIXED            4
+#define Z_DEFAULT_STRATEGY 0
@@ -139,6 +139,243 @@ crc32_iscsi(unsigned char *buffer, //!< buffer to calculate CRC on
             unsigned int init_crc  //!< initial CRC value
 );
 
+/**
+ * @brief Generate RFC 1952 (gzip) CRC and copy, runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 32 bit CRC
+ */
+uint32_t
+crc32_gzip_refl_copy(uint32_t init_crc, //!< initial CRC value, 32 bits
+                     uint8_t *dst,      //!< buffer destination for copy
+                     uint8_t *src,      //!< buffer source to crc + copy
+                     uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate ISCSI CRC and copy, runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * Unlike crc32_iscsi() the arguments follow the order of crc16_t10dif_copy().
+ *
+ * @returns 32 bit CRC
+ */
+uint32_t
+crc32_iscsi_copy(uint32_t init_crc, //!< initial CRC value, 32 bits
+                 uint8_t *dst,      //!< buffer destination for copy
+                 uint8_t *src,      //!< buffer source to crc + copy
+                 uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief T10 DIF CRC of many independent buffers, runs appropriate version.
+ *
+ * Computes the CRC of each of n buffers in one call. On entry crcs[i] holds the
+ * initial CRC for bufs[i], on return it holds the CRC of that buffer, as if
+ * crc16_t10dif() were called on each buffer in turn. Suited to batches of small
+ * buffers such as disk sectors.
+ */
+void
+crc16_t10dif_mb(uint32_t n,                 //!< number of buffers
+                unsigned char *const *bufs, //!< array of n buffer pointers
+                const uint64_t *lens,       //!< array of n buffer lengths in bytes
+                uint16_t *crcs              //!< array of n CRCs, initial in, result out
+);
+
+/**
+ * @brief iSCSI CRC of many independent buffers, runs appropriate version.
+ *
+ * Computes the CRC of each of n buffers in one call. On entry crcs[i] holds the
+ * initial CRC for bufs[i], on return it holds the CRC of that buffer, as if
+ * crc32_iscsi() were called on each buffer in turn. Suited to batches of small
+ * buffers such as disk sectors.
+ */
+void
+crc32_iscsi_mb(uint32_t n,                 //!< number of buffers
+               unsigned char *const *bufs, //!< array of n buffer pointers
+               const uint64_t *lens,       //!< array of n buffer lengths in bytes
+               uint32_t *crcs              //!< array of n CRCs, initial in, result out
+);
+
+/* CRC combine functions */
+
+/*
+ * Combine functions produce the CRC of a concatenated buffer A|B from the CRC
+ * of A and the CRC of B computed independently with an initial CRC of 0, as
+ * though the buffers were processed sequentially. The data is not touched so
+ * large buffers can be split and their pieces checksummed in parallel.
+ *
+ * The work that depends on the length of B is available separately through
+ * *_combine_precompute() so that pieces of a common size can be joined with
+ * only *_combine_fast().
+ */
+
+/**
+ * @brief Combine T10 DIF CRCs of two adjacent buffers.
+ * @returns 16 bit CRC of the concatenated buffers
+ */
+uint16_t
+crc16_t10dif_combine(uint16_t crc1, //!< CRC of the first buffer
+                     uint16_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                     uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the T10 DIF combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc16_t10dif_combine_fast()
+ */
+uint16_t
+crc16_t10dif_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine T10 DIF CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 16 bit CRC of the concatenated buffers
+ */
+uint16_t
+crc16_t10dif_combine_fast(uint16_t crc1, //!< CRC of the first buffer
+                          uint16_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                          uint16_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine IEEE normal CRCs of two adjacent buffers.
+ * @returns 32 bit CRC of the concatenated buffers
+ */
+uint32_t
+crc32_ieee_combine(uint32_t crc1, //!< CRC of the first buffer
+                   uint32_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                   uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the IEEE normal combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc32_ieee_combine_fast()
+ */
+uint32_t
+crc32_ieee_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine IEEE normal CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 32 bit CRC of the concatenated buffers
+ */
+uint32_t
+crc32_ieee_combine_fast(uint32_t crc1, //!< CRC of the first buffer
+                        uint32_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                        uint32_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine gzip reflected CRCs of two adjacent buffers.
+ * @returns 32 bit CRC of the concatenated buffers
+ */
+uint32_t
+crc32_gzip_refl_combine(uint32_t crc1, //!< CRC of the first buffer
+                        uint32_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                        uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the gzip reflected combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc32_gzip_refl_combine_fast()
+ */
+uint32_t
+crc32_gzip_refl_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine gzip reflected CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 32 bit CRC of the concatenated buffers
+ */
+uint32_t
+crc32_gzip_refl_combine_fast(uint32_t crc1, //!< CRC of the first buffer
+                             uint32_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                             uint32_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine iSCSI CRCs of two adjacent buffers.
+ * @returns 32 bit CRC of the concatenated buffers
+ */
+uint32_t
+crc32_iscsi_combine(uint32_t crc1, //!< CRC of the first buffer
+                    uint32_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                    uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the iSCSI combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc32_iscsi_combine_fast()
+ */
+uint32_t
+crc32_iscsi_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine iSCSI CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 32 bit CRC of the concatenated buffers
+ */
+uint32_t
+crc32_iscsi_combine_fast(uint32_t crc1, //!< CRC of the first buffer
+                         uint32_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                         uint32_t xk    //!< constant from the matching precompute
+);
+
+/* Runtime parameterized CRC */
+
+/**
+ * @brief Context for a CRC with a polynomial chosen at runtime.
+ *
+ * Filled in by crc_engine_init() and read only afterwards, so one context can
+ * be shared by any number of threads.
+ */
+struct crc_engine {
+        uint64_t poly;          //!< polynomial in normal form without the x^width term
+        int width;              //!< CRC width in bits, 8 to 64
+        int reflected;          //!< non-zero for reflected (LSB first) input and output
+        int clmul;              //!< non-zero if this CPU can fold with carry-less multiply
+        uint64_t fold[4];       //!< folding constants over 512 and 128 bits derived from poly
+        uint64_t table[8][256]; //!< slice-by-8 tables derived from poly
+};
+
+/**
+ * @brief Initialize a CRC engine for an arbitrary polynomial.
+ *
+ * The polynomial is given in normal form, as in the usual CRC catalogs, for
+ * example 0x864CFB for CRC-24/OPENPGP or 0x1021 for CRC-16/CCITT. Reflected
+ * CRCs such as CRC-16/KERMIT set reflected and keep the same normal form.
+ *
+ * @returns 0 on success, -1 if width is out of range
+ */
+int
+crc_engine_init(uint64_t poly,         //!< CRC polynomial in normal form
+                int width,             //!< CRC width in bits, 8 to 64
+                int reflected,         //!< non-zero for a reflected CRC
+                struct crc_engine *ctx //!< context to initialize
+);
+
+/**
+ * @brief Update a CRC using an engine from crc_engine_init().
+ *
+ * The CRC register is passed in and returned without any initial or final
+ * inversion, the same way as crc32_iscsi(). Callers apply the init and xorout
+ * values of their CRC model, for example crc = ~0 before the first call and
+ * crc ^ ~0 after the last for CRC-32. Results are right aligned to the width.
+ *
+ * @returns updated CRC register
+ */
+uint64_t
+crc_engine_update(const struct crc_engine *ctx, //!< initialized engine
+                  uint64_t crc,                 //!< current CRC register
+                  const uint8_t *buf,           //!< buffer to calculate CRC on
+                  uint64_t len                  //!< buffer length in bytes (64-bit data)
+);
+
 /* Base functions */
 
 /**
@@ -194,6 +431,48 @@ crc32_gzip_refl_base(uint32_t seed, //!< initial CRC value, 32 bits
                      uint64_t len   //!< buffer length in bytes (64-bit data)
 );
 
+/**
+ * @brief Generate RFC 1952 (gzip) CRC and copy, runs baseline version.
+ * @returns 32 bit CRC
+ */
+uint32_t
+crc32_gzip_refl_copy_base(uint32_t init_crc, //!< initial CRC value, 32 bits
+                          uint8_t *dst,      //!< buffer destination for copy
+                          uint8_t *src,      //!< buffer source to crc + copy
+                          uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate ISCSI CRC and copy, runs baseline version.
+ * @returns 32 bit CRC
+ */
+uint32_t
+crc32_iscsi_copy_base(uint32_t init_crc, //!< initial CRC value, 32 bits
+                      uint8_t *dst,      //!< buffer destination for copy
+                      uint8_t *src,      //!< buffer source to crc + copy
+                      uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief T10 DIF CRC of many independent buffers, runs baseline version
+ */
+void
+crc16_t10dif_mb_base(uint32_t n,                 //!< number of buffers
+                     unsigned char *const *bufs, //!< array of n buffer pointers
+                     const uint64_t *lens,       //!< array of n buffer lengths in bytes
+                     uint16_t *crcs              //!< array of n CRCs, initial in, result out
+);
+
+/**
+ * @brief iSCSI CRC of many independent buffers, runs baseline version
+ */
+void
+crc32_iscsi_mb_base(uint32_t n,                 //!< number of buffers
+                    unsigned char *const *bufs, //!< array of n buffer pointers
+                    const uint64_t *lens,       //!< array of n buffer lengths in bytes
+                    uint32_t *crcs              //!< array of n CRCs, initial in, result out
+);
+
 #ifdef __cplusplus
 }
 #endif
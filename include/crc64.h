@@ -155,6 +155,386 @@ crc64_rocksoft_norm(uint64_t init_crc,        //!< initial CRC value, 64 bits
                     uint64_t len              //!< buffer length in bytes (64-bit data)
 );
 
+/**
+ * @brief Generate CRC from ECMA-182 standard in reflected format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_ecma_refl_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                     uint8_t *dst,      //!< buffer destination for copy
+                     uint8_t *src,      //!< buffer source to crc + copy
+                     uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from ECMA-182 standard in normal format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_ecma_norm_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                     uint8_t *dst,      //!< buffer destination for copy
+                     uint8_t *src,      //!< buffer source to crc + copy
+                     uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from ISO standard in reflected format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_iso_refl_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                    uint8_t *dst,      //!< buffer destination for copy
+                    uint8_t *src,      //!< buffer source to crc + copy
+                    uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from ISO standard in normal format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_iso_norm_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                    uint8_t *dst,      //!< buffer destination for copy
+                    uint8_t *src,      //!< buffer source to crc + copy
+                    uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Jones" coefficients in reflected format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_jones_refl_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                      uint8_t *dst,      //!< buffer destination for copy
+                      uint8_t *src,      //!< buffer source to crc + copy
+                      uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Jones" coefficients in normal format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_jones_norm_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                      uint8_t *dst,      //!< buffer destination for copy
+                      uint8_t *src,      //!< buffer source to crc + copy
+                      uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Rocksoft" coefficients in reflected format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_rocksoft_refl_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                         uint8_t *dst,      //!< buffer destination for copy
+                         uint8_t *src,      //!< buffer source to crc + copy
+                         uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Rocksoft" coefficients in normal format and copy,
+ * runs appropriate version.
+ *
+ * Stitched CRC + copy function. This function determines what instruction
+ * sets are enabled and selects the appropriate version at runtime.
+ *
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_rocksoft_norm_copy(uint64_t init_crc, //!< initial CRC value, 64 bits
+                         uint8_t *dst,      //!< buffer destination for copy
+                         uint8_t *src,      //!< buffer source to crc + copy
+                         uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Rocksoft reflected CRC of many independent buffers, runs appropriate version.
+ *
+ * Computes the CRC of each of n buffers in one call. On entry crcs[i] holds the
+ * initial CRC for bufs[i], on return it holds the CRC of that buffer, as if
+ * crc64_rocksoft_refl() were called on each buffer in turn. Suited to batches of small
+ * buffers such as disk sectors.
+ */
+void
+crc64_rocksoft_refl_mb(uint32_t n,                 //!< number of buffers
+                       unsigned char *const *bufs, //!< array of n buffer pointers
+                       const uint64_t *lens,       //!< array of n buffer lengths in bytes
+                       uint64_t *crcs              //!< array of n CRCs, initial in, result out
+);
+
+/* CRC combine functions */
+
+/*
+ * Combine functions produce the CRC of a concatenated buffer A|B from the CRC
+ * of A and the CRC of B computed independently with an initial CRC of 0, as
+ * though the buffers were processed sequentially. The data is not touched so
+ * large buffers can be split and their pieces checksummed in parallel.
+ *
+ * The work that depends on the length of B is available separately through
+ * *_combine_precompute() so that pieces of a common size can be joined with
+ * only *_combine_fast().
+ */
+
+/**
+ * @brief Combine ECMA-182 reflected CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_ecma_refl_combine(uint64_t crc1, //!< CRC of the first buffer
+                        uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                        uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the ECMA-182 reflected combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_ecma_refl_combine_fast()
+ */
+uint64_t
+crc64_ecma_refl_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine ECMA-182 reflected CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_ecma_refl_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                             uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                             uint64_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine ECMA-182 normal CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_ecma_norm_combine(uint64_t crc1, //!< CRC of the first buffer
+                        uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                        uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the ECMA-182 normal combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_ecma_norm_combine_fast()
+ */
+uint64_t
+crc64_ecma_norm_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine ECMA-182 normal CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_ecma_norm_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                             uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                             uint64_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine ISO reflected CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_iso_refl_combine(uint64_t crc1, //!< CRC of the first buffer
+                       uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                       uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the ISO reflected combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_iso_refl_combine_fast()
+ */
+uint64_t
+crc64_iso_refl_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine ISO reflected CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_iso_refl_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                            uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                            uint64_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine ISO normal CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_iso_norm_combine(uint64_t crc1, //!< CRC of the first buffer
+                       uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                       uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the ISO normal combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_iso_norm_combine_fast()
+ */
+uint64_t
+crc64_iso_norm_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine ISO normal CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_iso_norm_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                            uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                            uint64_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine Jones reflected CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_jones_refl_combine(uint64_t crc1, //!< CRC of the first buffer
+                         uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                         uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the Jones reflected combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_jones_refl_combine_fast()
+ */
+uint64_t
+crc64_jones_refl_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine Jones reflected CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_jones_refl_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                              uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                              uint64_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine Jones normal CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_jones_norm_combine(uint64_t crc1, //!< CRC of the first buffer
+                         uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                         uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the Jones normal combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_jones_norm_combine_fast()
+ */
+uint64_t
+crc64_jones_norm_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine Jones normal CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_jones_norm_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                              uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                              uint64_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine Rocksoft reflected CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_rocksoft_refl_combine(uint64_t crc1, //!< CRC of the first buffer
+                            uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                            uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the Rocksoft reflected combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_rocksoft_refl_combine_fast()
+ */
+uint64_t
+crc64_rocksoft_refl_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine Rocksoft reflected CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_rocksoft_refl_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                                 uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                                 uint64_t xk    //!< constant from the matching precompute
+);
+
+/**
+ * @brief Combine Rocksoft normal CRCs of two adjacent buffers.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_rocksoft_norm_combine(uint64_t crc1, //!< CRC of the first buffer
+                            uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                            uint64_t len2  //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Precompute the Rocksoft normal combine constant for a second buffer of len2 bytes.
+ * @returns constant to pass to crc64_rocksoft_norm_combine_fast()
+ */
+uint64_t
+crc64_rocksoft_norm_combine_precompute(uint64_t len2 //!< length of the second buffer in bytes
+);
+
+/**
+ * @brief Combine Rocksoft normal CRCs of two adjacent buffers using a precomputed constant.
+ * @returns 64 bit CRC of the concatenated buffers
+ */
+uint64_t
+crc64_rocksoft_norm_combine_fast(uint64_t crc1, //!< CRC of the first buffer
+                                 uint64_t crc2, //!< CRC of the second buffer, from initial CRC 0
+                                 uint64_t xk    //!< constant from the matching precompute
+);
+
 /* Arch specific versions */
 
 /**
@@ -341,6 +721,112 @@ crc64_rocksoft_norm_base(uint64_t init_crc,        //!< initial CRC value, 64 bi
                          uint64_t len              //!< buffer length in bytes (64-bit data)
 );
 
+/**
+ * @brief Generate CRC from ECMA-182 standard in reflected format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_ecma_refl_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                          uint8_t *dst,      //!< buffer destination for copy
+                          uint8_t *src,      //!< buffer source to crc + copy
+                          uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from ECMA-182 standard in normal format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_ecma_norm_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                          uint8_t *dst,      //!< buffer destination for copy
+                          uint8_t *src,      //!< buffer source to crc + copy
+                          uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from ISO standard in reflected format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_iso_refl_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                         uint8_t *dst,      //!< buffer destination for copy
+                         uint8_t *src,      //!< buffer source to crc + copy
+                         uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from ISO standard in normal format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_iso_norm_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                         uint8_t *dst,      //!< buffer destination for copy
+                         uint8_t *src,      //!< buffer source to crc + copy
+                         uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Jones" coefficients in reflected format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_jones_refl_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                           uint8_t *dst,      //!< buffer destination for copy
+                           uint8_t *src,      //!< buffer source to crc + copy
+                           uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Jones" coefficients in normal format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_jones_norm_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                           uint8_t *dst,      //!< buffer destination for copy
+                           uint8_t *src,      //!< buffer source to crc + copy
+                           uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Rocksoft" coefficients in reflected format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_rocksoft_refl_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                              uint8_t *dst,      //!< buffer destination for copy
+                              uint8_t *src,      //!< buffer source to crc + copy
+                              uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Generate CRC from "Rocksoft" coefficients in normal format and copy,
+ * runs baseline version.
+ * @returns 64 bit CRC
+ */
+uint64_t
+crc64_rocksoft_norm_copy_base(uint64_t init_crc, //!< initial CRC value, 64 bits
+                              uint8_t *dst,      //!< buffer destination for copy
+                              uint8_t *src,      //!< buffer source to crc + copy
+                              uint64_t len       //!< buffer length in bytes (64-bit data)
+);
+
+/**
+ * @brief Rocksoft reflected CRC of many independent buffers, runs baseline version
+ */
+void
+crc64_rocksoft_refl_mb_base(uint32_t n,                 //!< number of buffers
+                            unsigned char *const *bufs, //!< array of n buffer pointers
+                            const uint64_t *lens,       //!< array of n buffer lengths in bytes
+                            uint64_t *crcs              //!< array of n CRCs, initial in, result out
+);
+
 #ifdef __cplusplus
 }
 #endif
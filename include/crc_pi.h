@@ -0,0 +1,135 @@
+/**********************************************************************
+  Copyright(c) 2026 Intel Corporation All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+    * Neither the name of Intel Corporation nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**********************************************************************/
+
+/**
+ *  @file  crc_pi.h
+ *  @brief Protection information generate and verify.
+ *
+ *  Functions to generate and verify T10 DIF and NVMe end-to-end protection
+ *  information (PI) over an extent of sectors in one call. Two PI formats are
+ *  supported, each stored big endian:
+ *
+ *  - 16b guard, 8 byte tuple: crc16_t10dif() guard, 16-bit application tag
+ *    and 32-bit reference tag.
+ *  - 64b guard, 16 byte tuple: crc64_rocksoft_refl() guard, 16-bit
+ *    application tag and 48-bit reference tag.
+ *
+ *  Metadata may be interleaved after each data block (DIF) or held in a
+ *  separate buffer (DIX). When the metadata is larger than the tuple, the
+ *  tuple is placed either in its first or last bytes. With the tuple last,
+ *  the guard also covers the metadata bytes that precede it.
+ *
+ *  The reference tag starts at the given value and increments for every
+ *  block. A block whose application tag is 0xffff is not checked.
+ */
+
+#ifndef _CRC_PI_H_
+#define _CRC_PI_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Guard types */
+#define ISAL_PI_GUARD_16 0 //!< 8 byte tuple with a 16-bit CRC guard
+#define ISAL_PI_GUARD_64 1 //!< 16 byte tuple with a 64-bit CRC guard
+
+/* Metadata layouts */
+#define ISAL_PI_DIF 0 //!< metadata interleaved after each data block
+#define ISAL_PI_DIX 1 //!< metadata in a separate buffer
+
+/* Fields to check in isal_pi_verify() */
+#define ISAL_PI_CHECK_GUARD 0x1
+#define ISAL_PI_CHECK_APP   0x2
+#define ISAL_PI_CHECK_REF   0x4
+#define ISAL_PI_CHECK_ALL   (ISAL_PI_CHECK_GUARD | ISAL_PI_CHECK_APP | ISAL_PI_CHECK_REF)
+
+/* Tuple sizes */
+#define ISAL_PI_16_TUPLE_SIZE 8
+#define ISAL_PI_64_TUPLE_SIZE 16
+
+/* Return codes */
+#define ISAL_PI_INVALID_FORMAT -1
+
+/** @brief Layout of the sectors in an extent. */
+struct isal_pi_format {
+        uint32_t block_size; //!< data bytes per block, for example 512 or 4096
+        uint32_t md_size;    //!< metadata bytes per block, at least the tuple size
+        uint32_t guard_type; //!< ISAL_PI_GUARD_16 or ISAL_PI_GUARD_64
+        uint32_t layout;     //!< ISAL_PI_DIF or ISAL_PI_DIX
+        uint32_t pi_last;    //!< non-zero to place the tuple in the last bytes of metadata
+        uint32_t check;      //!< ISAL_PI_CHECK_* flags for isal_pi_verify()
+};
+
+/**
+ * @brief Generate protection information for nblocks blocks.
+ *
+ * Computes the guard of every block and writes the tuple with app_tag and an
+ * incrementing reference tag into the metadata. Other metadata bytes are left
+ * unchanged.
+ *
+ * @returns 0 on success, ISAL_PI_INVALID_FORMAT for an invalid format
+ */
+int
+isal_pi_generate(const struct isal_pi_format *fmt, //!< extent layout
+                 uint8_t *data,                    //!< data blocks, metadata interleaved for DIF
+                 uint8_t *md,                      //!< metadata for DIX, ignored for DIF
+                 uint32_t nblocks,                 //!< number of blocks
+                 uint64_t ref_tag,                 //!< reference tag of the first block
+                 uint16_t app_tag                  //!< application tag for every block
+);
+
+/**
+ * @brief Verify protection information of nblocks blocks.
+ *
+ * Checks the fields selected in fmt->check against the data and the expected
+ * tags. The application tag is compared under app_mask. Bit i of fail_map is
+ * set when block i fails; the caller provides (nblocks + 63) / 64 words, which
+ * are cleared first.
+ *
+ * @returns number of failing blocks, or ISAL_PI_INVALID_FORMAT for an invalid format
+ */
+int
+isal_pi_verify(const struct isal_pi_format *fmt, //!< extent layout
+               const uint8_t *data,              //!< data blocks, metadata interleaved for DIF
+               const uint8_t *md,                //!< metadata for DIX, ignored for DIF
+               uint32_t nblocks,                 //!< number of blocks
+               uint64_t ref_tag,                 //!< expected reference tag of the first block
+               uint16_t app_tag,                 //!< expected application tag
+               uint16_t app_mask,                //!< bits of the application tag to compare
+               uint64_t *fail_map                //!< bitmap of failing blocks, may be NULL
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _CRC_PI_H_
@@ -119,6 +119,84 @@ void
 ec_encode_data_base(int len, int k, int rows, unsigned char *gftbls, unsigned char **data,
                     unsigned char **coding);
 
+/**
+ * @brief Generate or decode erasure codes on blocks of data using several threads.
+ *
+ * Same as ec_encode_data() but splits len into num_threads contiguous slices,
+ * 64 byte aligned, and encodes each slice on its own thread. Slice i is always
+ * handled by thread i, so buffers first touched with the same split stay local
+ * to the node of the thread using them. Small lengths use fewer threads. When
+ * the library is built without threads the slices run in the calling thread.
+ *
+ * The threads are created and joined on every call, which costs tens of
+ * microseconds or more. Callers that encode repeatedly should keep a pool from
+ * ec_thread_pool_create() and use ec_encode_data_pool() instead.
+ *
+ * @param len         Length of each block of data (vector) of source or dest data.
+ * @param k           The number of vector sources or rows in the generator matrix
+ *                    for coding.
+ * @param rows        The number of output vectors to concurrently encode/decode.
+ * @param gftbls      Pointer to array of input tables generated from coding
+ *                    coefficients in ec_init_tables(). Must be of size 32*k*rows
+ * @param data        Array of pointers to source input buffers.
+ * @param coding      Array of pointers to coded output buffers.
+ * @param num_threads Maximum number of threads to use, including the calling thread.
+ * @returns none
+ */
+void
+ec_encode_data_mt(int len, int k, int rows, unsigned char *gftbls, unsigned char **data,
+                  unsigned char **coding, int num_threads);
+
+/**
+ * @brief Worker threads for multi-threaded erasure code calls.
+ */
+struct ec_thread_pool;
+
+/**
+ * @brief Start a pool of worker threads for ec_encode_data_pool().
+ *
+ * Starts num_threads - 1 threads that wait for work, the calling thread of
+ * each call being the last one. The pool may be used from any thread, calls
+ * on the same pool run one at a time. If some threads cannot be started the
+ * pool works with those that did.
+ *
+ * @param num_threads Number of threads to use, including the calling thread,
+ *                    at most 256.
+ * @returns pointer to the pool, or NULL on allocation failure
+ */
+struct ec_thread_pool *
+ec_thread_pool_create(int num_threads);
+
+/**
+ * @brief Stop the threads of a pool and free it.
+ *
+ * @param pool pool from ec_thread_pool_create(), may be NULL
+ * @returns none
+ */
+void
+ec_thread_pool_free(struct ec_thread_pool *pool);
+
+/**
+ * @brief Generate or decode erasure codes on blocks of data using a thread pool.
+ *
+ * Same as ec_encode_data_mt() with the threads of pool, so no thread is created
+ * per call. Slice i is handled by the same pool thread on every call.
+ *
+ * @param len    Length of each block of data (vector) of source or dest data.
+ * @param k      The number of vector sources or rows in the generator matrix
+ *               for coding.
+ * @param rows   The number of output vectors to concurrently encode/decode.
+ * @param gftbls Pointer to array of input tables generated from coding
+ *               coefficients in ec_init_tables(). Must be of size 32*k*rows
+ * @param data   Array of pointers to source input buffers.
+ * @param coding Array of pointers to coded output buffers.
+ * @param pool   Pool from ec_thread_pool_create(), NULL runs ec_encode_data().
+ * @returns none
+ */
+void
+ec_encode_data_pool(int len, int k, int rows, unsigned char *gftbls, unsigned char **data,
+                    unsigned char **coding, struct ec_thread_pool *pool);
+
 /**
  * @brief Generate update for encode or decode of erasure codes from single source, runs appropriate
  * version.
@@ -1132,6 +1210,129 @@ gf_gen_cauchy1_matrix(unsigned char *a, int m, int k);
 int
 gf_invert_matrix(unsigned char *in, unsigned char *out, const int n);
 
+/**
+ * @brief Generate a decode matrix from an encode matrix and erasure list.
+ *
+ * Selects the first k surviving fragments as decode sources, inverts the
+ * matching rows of the encode matrix and builds one decode row for each erased
+ * fragment, source or parity. The result can be expanded with ec_init_tables()
+ * and applied with ec_encode_data() to the sources listed in decode_index.
+ *
+ * @param k             number of source fragments
+ * @param m             total number of fragments, sources + parity
+ * @param encode_matrix [m x k] encode matrix
+ * @param erasure_list  indexes of the erased fragments
+ * @param nerrs         number of erased fragments, 1 to m - k
+ * @param decode_matrix [nerrs x k] output decode matrix, rows in erasure_list order
+ * @param decode_index  [k] output indexes of the fragments to use as sources
+ * @returns 0 successful, other fail on invalid erasure list or singular matrix
+ */
+
+int
+ec_gen_decode_matrix(int k, int m, unsigned char *encode_matrix,
+                     const unsigned char *erasure_list, int nerrs, unsigned char *decode_matrix,
+                     unsigned char *decode_index);
+
+/**********************************************************************
+ * Erasure decode with a cache of decode tables.
+ *
+ * Building the decode tables for an erasure pattern costs a k x k matrix
+ * inversion and a table expansion. When the same patterns repeat, such as
+ * while rebuilding a failed device, a cache keyed by erasure list keeps the
+ * tables of the most recently used patterns so only the dot product remains.
+ */
+
+struct ec_decode_cache;
+
+/**
+ * @brief Create a decode table cache for an erasure code.
+ *
+ * The encode matrix is copied, so the caller's copy may be freed. A cache may
+ * be shared by several threads when the library is built with threads.
+ *
+ * @param k             number of source fragments
+ * @param m             total number of fragments, sources + parity, at most 255
+ * @param encode_matrix [m x k] encode matrix
+ * @param entries       maximum number of erasure patterns to keep
+ * @returns pointer to the cache, or NULL on invalid parameters or allocation failure
+ */
+
+struct ec_decode_cache *
+ec_decode_cache_create(int k, int m, const unsigned char *encode_matrix, int entries);
+
+/**
+ * @brief Free a decode table cache.
+ *
+ * @param cache cache from ec_decode_cache_create(), may be NULL
+ * @returns none
+ */
+
+void
+ec_decode_cache_free(struct ec_decode_cache *cache);
+
+/**
+ * @brief Recover erased fragments using cached decode tables.
+ *
+ * Looks up the decode tables for the erasure list, building and caching them
+ * with ec_gen_decode_matrix() and ec_init_tables() on a miss, then regenerates
+ * every erased fragment with ec_encode_data(). When the cache is full the
+ * least recently used pattern is replaced.
+ *
+ * @param cache        cache from ec_decode_cache_create()
+ * @param len          length of each fragment in bytes
+ * @param erasure_list indexes of the erased fragments, the order is part of the key
+ * @param nerrs        number of erased fragments, 1 to m - k
+ * @param frags        [m] array of pointers to the fragments, erased entries are not read
+ * @param recover      [nerrs] array of pointers to outputs, in erasure_list order
+ * @returns 0 successful, other fail on invalid erasure list, singular matrix or
+ *          allocation failure
+ */
+
+int
+ec_decode_data(struct ec_decode_cache *cache, int len, const unsigned char *erasure_list,
+               int nerrs, unsigned char **frags, unsigned char **recover);
+
+/**
+ * @brief Recover erased fragments using cached decode tables and several threads.
+ *
+ * Same as ec_decode_data() with the regeneration done by ec_encode_data_mt().
+ *
+ * @param cache        cache from ec_decode_cache_create()
+ * @param len          length of each fragment in bytes
+ * @param erasure_list indexes of the erased fragments, the order is part of the key
+ * @param nerrs        number of erased fragments, 1 to m - k
+ * @param frags        [m] array of pointers to the fragments, erased entries are not read
+ * @param recover      [nerrs] array of pointers to outputs, in erasure_list order
+ * @param num_threads  maximum number of threads to use, including the calling thread
+ * @returns 0 successful, other fail on invalid erasure list, singular matrix or
+ *          allocation failure
+ */
+
+int
+ec_decode_data_mt(struct ec_decode_cache *cache, int len, const unsigned char *erasure_list,
+                  int nerrs, unsigned char **frags, unsigned char **recover, int num_threads);
+
+/**
+ * @brief Recover erased fragments using cached decode tables and a thread pool.
+ *
+ * Same as ec_decode_data() with the regeneration done by ec_encode_data_pool().
+ *
+ * @param cache        cache from ec_decode_cache_create()
+ * @param len          length of each fragment in bytes
+ * @param erasure_list indexes of the erased fragments, the order is part of the key
+ * @param nerrs        number of erased fragments, 1 to m - k
+ * @param frags        [m] array of pointers to the fragments, erased entries are not read
+ * @param recover      [nerrs] array of pointers to outputs, in erasure_list order
+ * @param pool         pool from ec_thread_pool_create(), may be NULL
+ * @returns 0 successful, other fail on invalid erasure list, singular matrix or
+ *          allocation failure
+ */
+
+int
+ec_decode_data_pool(struct ec_decode_cache *cache, int len, const unsigned char *erasure_list,
+                    int nerrs, unsigned char **frags, unsigned char **recover,
+                    struct ec_thread_pool *pool);
+
 /*************************************************************/
 
 #ifdef __cplusplus
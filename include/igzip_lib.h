@@ -126,6 +126,7 @@ extern "C" {
 #define IGZIP_LVL1_HASH_SIZE IGZIP_HASH8K_HASH_SIZE
 #define IGZIP_LVL2_HASH_SIZE IGZIP_HASH_HIST_SIZE
 #define IGZIP_LVL3_HASH_SIZE IGZIP_HASH_MAP_HASH_SIZE
+#define IGZIP_LVL4_HASH_SIZE IGZIP_HASH_MAP_HASH_SIZE
 
 #ifdef LONGER_HUFFTABLE
 enum { IGZIP_DIST_TABLE_SIZE = 8 * 1024 };
@@ -157,6 +158,24 @@ enum { IGZIP_LIT_TABLE_SIZE = ISAL_DEF_LIT_SYMBOLS };
 #define IGZIP_ZLIB        3
 #define IGZIP_ZLIB_NO_HDR 4
 
+/* Deflate Strategies */
+#define ISAL_DEFAULT_STRATEGY 0 /* Default, match finding chosen by the level */
+#define ISAL_HUFFMAN_ONLY     1 /* Literals only, no match finding */
+#define ISAL_RLE              2 /* Distance one matches only */
+#define ISAL_FIXED            3 /* Level match finding with the fixed Huffman code */
+
+/* BGZF blocked gzip */
+#define ISAL_BGZF_MAX_BLOCK   (64 * IGZIP_K) /* Largest member, header and trailer included */
+#define ISAL_BGZF_BLOCK_INPUT 0xff00         /* Input bytes per member written */
+#define ISAL_BGZF_HDR_SIZE    18
+#define ISAL_BGZF_EOF_SIZE    28 /* Empty member marking the end of a file */
+
+/* Output size that isal_bgzf_compress() can always compress len bytes of input into */
+#define ISAL_BGZF_BOUND(len)                                                                       \
+        ((((uint64_t) (len) + ISAL_BGZF_BLOCK_INPUT - 1) / ISAL_BGZF_BLOCK_INPUT) *                \
+                 ISAL_BGZF_MAX_BLOCK +                                                             \
+         ISAL_BGZF_EOF_SIZE)
+
 /* Compression Return values */
 #define COMP_OK                0
 #define INVALID_FLUSH          -7
@@ -238,6 +257,9 @@ enum isal_block_state {
 #define ISAL_ZLIB_NO_HDR_VER 5
 #define ISAL_GZIP_NO_HDR_VER 6
 
+/* Flags for isal_inflate_compact_save() */
+#define ISAL_INFLATE_COMPACT_DEFLATE 1 /* Store the history deflate compressed */
+
 /* Inflate Return values */
 #define ISAL_DECOMP_OK          0  /* No errors encountered while decompressing */
 #define ISAL_END_INPUT          1  /* End of input reached */
@@ -271,7 +293,7 @@ struct isal_mod_hist {
 };
 
 #define ISAL_DEF_MIN_LEVEL 0
-#define ISAL_DEF_MAX_LEVEL 3
+#define ISAL_DEF_MAX_LEVEL 4
 
 /* Defines used set level data sizes */
 /* has to be at least sizeof(struct level_buf) + sizeof(struct lvlX_buf */
@@ -282,6 +304,8 @@ struct isal_mod_hist {
 #define ISAL_DEF_LVL2_TOKEN_SIZE 4
 #define ISAL_DEF_LVL3_REQ        4 * IGZIP_K + 4 * 4 * IGZIP_K + 2 * IGZIP_LVL3_HASH_SIZE
 #define ISAL_DEF_LVL3_TOKEN_SIZE 4
+#define ISAL_DEF_LVL4_REQ        4 * IGZIP_K + 4 * 4 * IGZIP_K + 2 * IGZIP_LVL4_HASH_SIZE
+#define ISAL_DEF_LVL4_TOKEN_SIZE 4
 
 /* Data sizes for level specific data options */
 #define ISAL_DEF_LVL0_MIN         ISAL_DEF_LVL0_REQ
@@ -312,6 +336,13 @@ struct isal_mod_hist {
 #define ISAL_DEF_LVL3_EXTRA_LARGE (ISAL_DEF_LVL3_REQ + ISAL_DEF_LVL3_TOKEN_SIZE * 128 * IGZIP_K)
 #define ISAL_DEF_LVL3_DEFAULT     ISAL_DEF_LVL3_LARGE
 
+#define ISAL_DEF_LVL4_MIN         (ISAL_DEF_LVL4_REQ + ISAL_DEF_LVL4_TOKEN_SIZE * 1 * IGZIP_K)
+#define ISAL_DEF_LVL4_SMALL       (ISAL_DEF_LVL4_REQ + ISAL_DEF_LVL4_TOKEN_SIZE * 16 * IGZIP_K)
+#define ISAL_DEF_LVL4_MEDIUM      (ISAL_DEF_LVL4_REQ + ISAL_DEF_LVL4_TOKEN_SIZE * 32 * IGZIP_K)
+#define ISAL_DEF_LVL4_LARGE       (ISAL_DEF_LVL4_REQ + ISAL_DEF_LVL4_TOKEN_SIZE * 64 * IGZIP_K)
+#define ISAL_DEF_LVL4_EXTRA_LARGE (ISAL_DEF_LVL4_REQ + ISAL_DEF_LVL4_TOKEN_SIZE * 128 * IGZIP_K)
+#define ISAL_DEF_LVL4_DEFAULT     ISAL_DEF_LVL4_LARGE
+
 #define IGZIP_NO_HIST       0
 #define IGZIP_HIST          1
 #define IGZIP_DICT_HIST     2
@@ -418,9 +449,12 @@ struct isal_zstream {
         uint16_t flush;         //!< Flush type can be NO_FLUSH, SYNC_FLUSH or FULL_FLUSH
         uint16_t gzip_flag;     //!< Indicate if gzip compression is to be performed
         uint16_t hist_bits;     //!< Log base 2 of maximum lookback distance, 0 is use default
+        uint16_t strategy;      //!< Deflate strategy, ISAL_DEFAULT_STRATEGY is default
         struct isal_zstate internal_state; //!< Internal state for this stream
 };
 
+struct isal_deflate_compact;
+
 /******************************************************************************/
 /* Inflate structures */
 /******************************************************************************/
@@ -507,6 +541,9 @@ struct inflate_huff_code_small {
         uint16_t long_code_lookup[ISAL_HUFF_CODE_SMALL_LONG_ALIGNED]; //!< Long code lookup table
 };
 
+struct isal_inflate_hdr_cache;
+struct isal_inflate_compact;
+
 /** @brief Holds decompression state information*/
 struct inflate_state {
         uint8_t *next_out;                            //!< Next output Byte
@@ -543,6 +580,10 @@ struct inflate_state {
         uint8_t tmp_out_buffer[2 * ISAL_DEF_HIST_SIZE +
                                ISAL_LOOK_AHEAD]; //!< Temporary buffer containing data from the
                                                  //!< output stream
+        struct isal_inflate_hdr_cache *hdr_cache; //!< Optional cache of decoded dynamic headers
+        uint32_t hdr_type; //!< Kind of header the current block's tables were built from
+        uint8_t hdr_lengths[ISAL_DEF_LIT_LEN_SYMBOLS +
+                            ISAL_DEF_DIST_SYMBOLS]; //!< Code lengths of the current dynamic header
 };
 
 /******************************************************************************/
@@ -795,6 +836,19 @@ isal_deflate_reset_dict(struct isal_zstream *stream, struct isal_dict *dict_str)
  * ISAL_DEFL_LVLx_MEDIUM, ISAL_DEFL_LVLx_LARGE, and ISAL_DEFL_LVLx_EXTRA_LARGE
  * are also provided as other suggested sizes.
  *
+ * Level 4 finds matches like level 3 but picks between them and literals with
+ * a shortest path parse, pricing symbols with the Huffman costs estimated from
+ * the histogram of the block being built. It is several times slower than
+ * level 3 and meant for data that is compressed once and kept.
+ *
+ * The strategy field selects how levels 1 and above search for matches and is
+ * ignored at level 0. ISAL_HUFFMAN_ONLY skips match finding and only Huffman
+ * codes literals, ISAL_RLE only emits distance one matches for runs of a
+ * repeated byte, and ISAL_FIXED keeps the level's match finding but codes every
+ * block with the fixed Huffman code instead of a dynamic one. At level 0 a fixed
+ * code is selected with isal_deflate_set_hufftables(). The strategy may be
+ * changed between calls to isal_deflate().
+ *
  * The equivalent of the zlib FLUSH_SYNC operation is currently supported.
  * Flush types can be NO_FLUSH, SYNC_FLUSH or FULL_FLUSH. Default flush type is
  * NO_FLUSH. A SYNC_ OR FULL_ flush will byte align the deflate block by
@@ -824,7 +878,8 @@ isal_deflate_reset_dict(struct isal_zstream *stream, struct isal_dict *dict_str)
  * @return COMP_OK (if everything is ok),
  *         INVALID_FLUSH (if an invalid FLUSH is selected),
  *         ISAL_INVALID_LEVEL (if an invalid compression level is selected),
- *         ISAL_INVALID_LEVEL_BUF (if the level buffer is not large enough).
+ *         ISAL_INVALID_LEVEL_BUF (if the level buffer is not large enough),
+ *         INVALID_PARAM (if an invalid strategy is selected).
  */
 int
 isal_deflate(struct isal_zstream *stream);
@@ -863,11 +918,102 @@ isal_deflate(struct isal_zstream *stream);
  *         INVALID_FLUSH (if an invalid FLUSH is selected),
  *         ISAL_INVALID_LEVEL (if an invalid compression level is selected),
  *         ISAL_INVALID_LEVEL_BUF (if the level buffer is not large enough),
+ *         INVALID_PARAM (if an invalid strategy is selected),
  *         STATELESS_OVERFLOW (if output buffer will not fit output).
  */
 int
 isal_deflate_stateless(struct isal_zstream *stream);
 
+/**
+ * @brief Parallel one shot compression of a single stream.
+ *
+ * Compresses the entire input buffer into one deflate, gzip or zlib stream
+ * using up to num_threads worker threads. The input is split into chunks that
+ * are compressed independently. Each chunk after the first is primed with the
+ * last ISAL_DEF_HIST_SIZE bytes of the previous chunk as a dictionary, so
+ * matches can cross chunk boundaries and the ratio stays close to that of a
+ * single thread. Chunks are byte aligned with a sync flush and concatenated,
+ * and the gzip/zlib trailer is written with the checksum of the whole input.
+ *
+ * The stream must be initialized with isal_deflate_stateless_init() or
+ * isal_deflate_init(). The level, strategy, hufftables, gzip_flag and hist_bits
+ * fields are used as in isal_deflate_stateless(). The level_buf is not used,
+ * each worker allocates its own. The flush and end_of_stream fields are ignored and
+ * the output is always a complete stream. If the library is built without
+ * thread support the chunks are compressed on the calling thread.
+ *
+ * @param  stream Structure holding state information on the compression streams.
+ * @param  num_threads Maximum number of threads to use, including the caller.
+ * @return COMP_OK (if everything is ok),
+ *         ISAL_INVALID_LEVEL (if an invalid compression level is selected),
+ *         INVALID_PARAM (if an invalid strategy is selected),
+ *         ISAL_INVALID_LEVEL_BUF (if worker memory could not be allocated),
+ *         STATELESS_OVERFLOW (if output buffer will not fit output).
+ */
+int
+isal_deflate_parallel(struct isal_zstream *stream, uint32_t num_threads);
+
+/**
+ * @brief Save the state of a stream between isal_deflate() calls in compact form.
+ *
+ * For servers holding very many long lived compressors, such as WebSocket
+ * permessage-deflate with context takeover. Instead of keeping an isal_zstream
+ * and level_buf per stream, each thread keeps one isal_zstream and level_buf as
+ * scratch space and streams are kept in compact form. A compact stream holds
+ * only the bit buffer, the counters and stream parameters, and the last
+ * 2^hist_bits bytes of history. The hash tables are rebuilt from the history by
+ * isal_deflate_compact_load().
+ *
+ * A stream can only be saved at a block boundary with no buffered input, which
+ * is the case after isal_deflate() has consumed all input with flush set to
+ * SYNC_FLUSH or FULL_FLUSH and had room for all output, and after the end of
+ * the stream.
+ *
+ * @param  stream Scratch stream after an isal_deflate() call.
+ * @param  compact Compact stream, *compact may be NULL for a new one and is
+ *         reallocated as needed.
+ * @return COMP_OK, or ISAL_INVALID_STATE if the stream is not at a point where
+ *         it can be saved or if out of memory.
+ */
+int
+isal_deflate_compact_save(struct isal_zstream *stream, struct isal_deflate_compact **compact);
+
+/**
+ * @brief Restore a compact stream into a scratch isal_zstream.
+ *
+ * Sets everything isal_deflate() needs to continue the saved stream, including
+ * level, strategy, hufftables, gzip_flag, hist_bits, total_in and total_out. The
+ * next_in, avail_in, next_out, avail_out, flush, end_of_stream, level_buf and
+ * level_buf_size fields are left as set by the caller. The level_buf must be
+ * set before the load and be large enough for the saved level, as the hash
+ * table is rebuilt in it.
+ *
+ * @param  stream Scratch stream.
+ * @param  compact Compact stream from isal_deflate_compact_save().
+ * @return COMP_OK,
+ *         ISAL_INVALID_LEVEL_BUF (if level_buf is not set for the saved level),
+ *         ISAL_INVALID_LEVEL (if level_buf_size is too small for the saved level).
+ */
+int
+isal_deflate_compact_load(struct isal_zstream *stream, const struct isal_deflate_compact *compact);
+
+/**
+ * @brief Size in bytes of a compact stream.
+ *
+ * @param  compact Compact stream from isal_deflate_compact_save().
+ * @return Size of the allocation holding the compact stream.
+ */
+uint32_t
+isal_deflate_compact_size(const struct isal_deflate_compact *compact);
+
+/**
+ * @brief Free a compact stream.
+ *
+ * @param  compact Compact stream to free, may be NULL.
+ */
+void
+isal_deflate_compact_free(struct isal_deflate_compact *compact);
+
 /******************************************************************************/
 /* Inflate functions */
 /******************************************************************************/
@@ -994,6 +1140,23 @@ isal_read_zlib_header(struct inflate_state *state, struct isal_zlib_header *zlib
 int
 isal_inflate(struct inflate_state *state);
 
+/**
+ * @brief Verify deflate data without writing the decompressed output.
+ *
+ * Same interface as isal_inflate() except that next_out and avail_out are not
+ * used. The data is decoded into the history window inside inflate_state only,
+ * so integrity checks run at decode speed without an output buffer. The gzip or
+ * zlib checksum selected by crc_flag is computed and checked against the
+ * trailer as in isal_inflate(), and total_out counts the decompressed bytes.
+ *
+ * Call again with more input until block_state is ISAL_BLOCK_FINISH.
+ *
+ * @param  state Structure holding state information on the compression streams.
+ * @return Same values as isal_inflate().
+ */
+int
+isal_inflate_verify(struct inflate_state *state);
+
 /**
  * @brief Fast data (deflate) stateless decompression for storage applications.
  *
@@ -1023,6 +1186,350 @@ isal_inflate(struct inflate_state *state);
 int
 isal_inflate_stateless(struct inflate_state *state);
 
+/**
+ * @brief Parallel one shot decompression of a single stream.
+ *
+ * Same interface and result as isal_inflate_stateless(), but the deflate data
+ * is split into compressed chunks that are decoded by up to num_threads
+ * threads. Each chunk after the first searches for the start of a dynamic
+ * block near its beginning. Until the output preceding a chunk is known its
+ * references into that window are kept as markers, which are replaced when
+ * the chunks are joined in order. A chunk whose search did not find the block
+ * the previous chunk ended on is decoded again by the calling thread, so the
+ * result never depends on the search. Streams with few dynamic blocks, such as
+ * those made of stored or static blocks, get little or no speedup.
+ *
+ * Inputs smaller than two chunks, or num_threads <= 1, are passed on to
+ * isal_inflate_stateless(). If the library is built without thread support
+ * the chunks are decoded on the calling thread.
+ *
+ * @param  state Structure holding state information on the compression streams.
+ * @param  num_threads Maximum number of threads to use, including the caller.
+ * @return Same as isal_inflate_stateless().
+ */
+int
+isal_inflate_parallel(struct inflate_state *state, uint32_t num_threads);
+
+/**
+ * @brief Random access index of checkpoints into a deflate, gzip or zlib stream.
+ *
+ * An index is built during one complete isal_inflate() style pass over a
+ * single stream. It holds a checkpoint at a block boundary about every spacing
+ * bytes of output, made of the input bit offset, the output offset and the
+ * last ISAL_DEF_HIST_SIZE bytes of output. isal_inflate_seek() restarts
+ * decompression at the checkpoint closest to an output offset, so a random
+ * read costs at most about spacing bytes of decompression.
+ */
+struct isal_inflate_index;
+
+/**
+ * @brief Allocate an empty inflate index.
+ *
+ * @param  spacing Output bytes between checkpoints, at least ISAL_DEF_HIST_SIZE.
+ * @return Index to pass to isal_inflate_index_build(), or NULL if out of memory.
+ */
+struct isal_inflate_index *
+isal_inflate_index_create(uint64_t spacing);
+
+/**
+ * @brief Free an index from isal_inflate_index_create() or isal_inflate_index_load().
+ *
+ * @param  index Index to free, may be NULL.
+ */
+void
+isal_inflate_index_free(struct isal_inflate_index *index);
+
+/**
+ * @brief Decompress like isal_inflate() while adding checkpoints to an index.
+ *
+ * Called in place of isal_inflate() for every call of a single stream pass,
+ * starting from an initialized state. The crc_flag of the state at the first
+ * call is kept in the index. Checkpoints are taken at the first block boundary
+ * after each spacing bytes of output, so streams with very large blocks get
+ * fewer of them.
+ *
+ * @param  state Structure holding state information on the decompression stream.
+ * @param  index Index being built.
+ * @return Same as isal_inflate(), or ISAL_INVALID_STATE if a checkpoint could
+ *         not be allocated.
+ */
+int
+isal_inflate_index_build(struct inflate_state *state, struct isal_inflate_index *index);
+
+/**
+ * @brief Set up an inflate state to decompress from the checkpoint nearest an output offset.
+ *
+ * The state is reset and primed with the window and bit position of the last
+ * checkpoint at or before offset. The caller then passes input starting at
+ * byte *in_offset of the stream to isal_inflate() and discards the first
+ * offset - *out_offset bytes of output. Decompression from a checkpoint is raw
+ * deflate: the wrapper trailer is not checked and the state's crc is not that
+ * of the stream. Before the first checkpoint the state is set up to decompress
+ * the stream from its start with the crc_flag the index was built with.
+ *
+ * @param  state Structure holding state information on the decompression stream.
+ * @param  index Index of the stream.
+ * @param  offset Output offset to read from.
+ * @param  in_offset Returns the input byte offset to continue from.
+ * @param  out_offset Returns the output offset decompression restarts at.
+ * @return ISAL_DECOMP_OK or ISAL_INVALID_STATE.
+ */
+int
+isal_inflate_seek(struct inflate_state *state, const struct isal_inflate_index *index,
+                  uint64_t offset, uint64_t *in_offset, uint64_t *out_offset);
+
+/**
+ * @brief Upper bound of the serialized size of an index.
+ *
+ * @param  index Index to serialize.
+ * @return Bytes needed by isal_inflate_index_save().
+ */
+uint64_t
+isal_inflate_index_size(const struct isal_inflate_index *index);
+
+/**
+ * @brief Serialize an index into a portable byte format.
+ *
+ * Checkpoint windows are stored deflate compressed when that makes them smaller.
+ *
+ * @param  index Index to serialize.
+ * @param  buf Output buffer.
+ * @param  len Size of buf on input, at least isal_inflate_index_size().
+ *             Returns the number of bytes written.
+ * @return ISAL_DECOMP_OK or ISAL_OUT_OVERFLOW.
+ */
+int
+isal_inflate_index_save(const struct isal_inflate_index *index, uint8_t *buf, uint64_t *len);
+
+/**
+ * @brief Load an index written by isal_inflate_index_save().
+ *
+ * @param  buf Serialized index.
+ * @param  len Length of buf.
+ * @return Index, or NULL if buf is not a valid index or out of memory.
+ */
+struct isal_inflate_index *
+isal_inflate_index_load(const uint8_t *buf, uint64_t len);
+
+/**
+ * @brief Allocate a cache of decoded dynamic huffman headers.
+ *
+ * Building the decode tables of a dynamic block costs more than decoding a
+ * small block. Streams that repeat the same few headers, such as those made
+ * with custom isal_hufftables or many SYNC_FLUSH points, decode faster when a
+ * cache is set in inflate_state.hdr_cache. Headers are matched on their
+ * decoded code lengths, so a hit always yields the same tables as a rebuild.
+ *
+ * A cache may be shared by any number of inflate states used from one thread
+ * at a time. isal_inflate_init() and isal_inflate_reset() clear hdr_cache, so
+ * set it after them. isal_inflate_stateless() clears it and does not use a cache.
+ *
+ * @param  entries Number of headers to keep, each takes about 24 KiB.
+ * @return Cache, or NULL if out of memory.
+ */
+struct isal_inflate_hdr_cache *
+isal_inflate_hdr_cache_create(uint32_t entries);
+
+/**
+ * @brief Free a cache from isal_inflate_hdr_cache_create().
+ *
+ * @param  cache Cache to free, may be NULL.
+ */
+void
+isal_inflate_hdr_cache_free(struct isal_inflate_hdr_cache *cache);
+
+/**
+ * @brief Save the state of a stream between isal_inflate() calls in compact form.
+ *
+ * For servers holding very many open streams. Instead of keeping an inflate_state
+ * per stream, each thread keeps one inflate_state as scratch space and streams
+ * are kept in compact form. A compact stream holds only the bit buffer, the
+ * counters, the code lengths of the current block, any output not yet returned
+ * and the last 2^hist_bits bytes of history (32 KiB when hist_bits is 0). The
+ * decode tables are rebuilt by isal_inflate_compact_load().
+ *
+ * With flags set to ISAL_INFLATE_COMPACT_DEFLATE the history is stored deflate
+ * compressed when that makes it smaller, which costs time on save and load.
+ *
+ * next_in, avail_in, next_out, avail_out and hdr_cache are not saved.
+ *
+ * @param  state State after a call to isal_inflate().
+ * @param  compact Compact stream, *compact may be NULL for a new one and is
+ *         reallocated as needed.
+ * @param  flags 0 or ISAL_INFLATE_COMPACT_DEFLATE.
+ * @return ISAL_DECOMP_OK or ISAL_INVALID_STATE if out of memory.
+ */
+int
+isal_inflate_compact_save(struct inflate_state *state, struct isal_inflate_compact **compact,
+                          uint32_t flags);
+
+/**
+ * @brief Restore a compact stream into a scratch inflate_state.
+ *
+ * All of state except next_in, avail_in, next_out, avail_out and hdr_cache is
+ * overwritten, so the same scratch state can be used for any stream. State must
+ * have been through isal_inflate_init() once. A hdr_cache set on it speeds up
+ * rebuilding the tables of streams that repeat the same dynamic header.
+ *
+ * @param  state Scratch state to load into.
+ * @param  compact Compact stream from isal_inflate_compact_save().
+ * @return ISAL_DECOMP_OK or ISAL_INVALID_BLOCK if the history does not decode.
+ */
+int
+isal_inflate_compact_load(struct inflate_state *state, const struct isal_inflate_compact *compact);
+
+/**
+ * @brief Size in bytes of a compact stream.
+ *
+ * @param  compact Compact stream from isal_inflate_compact_save().
+ * @return Allocated size.
+ */
+uint32_t
+isal_inflate_compact_size(const struct isal_inflate_compact *compact);
+
+/**
+ * @brief Free a compact stream.
+ *
+ * @param  compact Compact stream to free, may be NULL.
+ */
+void
+isal_inflate_compact_free(struct isal_inflate_compact *compact);
+
+/******************************************************************************/
+/* BGZF functions */
+/******************************************************************************/
+/**
+ * @brief Index of the members of a BGZF file.
+ *
+ * BGZF, as used by samtools and htslib, is a series of gzip members of at most
+ * ISAL_BGZF_MAX_BLOCK bytes, each with a "BC" extra subfield holding the
+ * member size, followed by an empty member as end of file marker. The index
+ * holds the compressed and uncompressed offsets of the start of every member
+ * that holds data, except the first one at offset 0, as in a .gzi file.
+ */
+struct isal_bgzf_index;
+
+/**
+ * @brief Allocate an empty BGZF index.
+ *
+ * @return Index, or NULL if out of memory.
+ */
+struct isal_bgzf_index *
+isal_bgzf_index_create(void);
+
+/**
+ * @brief Free an index from isal_bgzf_index_create() or isal_bgzf_index_load().
+ *
+ * @param  index Index to free, may be NULL.
+ */
+void
+isal_bgzf_index_free(struct isal_bgzf_index *index);
+
+/**
+ * @brief Compress into BGZF members using several threads.
+ *
+ * All of the input is compressed, in members of ISAL_BGZF_BLOCK_INPUT bytes
+ * except for the last one of each call, which may be shorter. Members are
+ * independent and are compressed by up to num_threads threads, including the
+ * caller. A file may be written with several calls, each given a multiple of
+ * ISAL_BGZF_BLOCK_INPUT bytes except the last. If end_of_stream is set the end
+ * of file marker is written after the members.
+ *
+ * The stream must be initialized with isal_deflate_stateless_init() or
+ * isal_deflate_init(). The level, strategy and hufftables fields are used as
+ * in isal_deflate_stateless(). The gzip_flag, flush and level_buf fields are
+ * not used, each worker allocates its own level buffer. If avail_out is less
+ * than ISAL_BGZF_BOUND(avail_in) the members are compressed into a temporary
+ * buffer first.
+ *
+ * @param  stream Structure holding state information on the compression streams.
+ * @param  num_threads Maximum number of threads to use, including the caller.
+ * @param  index Index the members written are added to, may be NULL. It must
+ *               be empty at the first call for a file.
+ * @return COMP_OK (if everything is ok),
+ *         ISAL_INVALID_LEVEL (if an invalid compression level is selected),
+ *         INVALID_PARAM (if an invalid strategy is selected),
+ *         ISAL_INVALID_LEVEL_BUF (if memory could not be allocated),
+ *         STATELESS_OVERFLOW (if output buffer will not fit output).
+ */
+int
+isal_bgzf_compress(struct isal_zstream *stream, uint32_t num_threads,
+                   struct isal_bgzf_index *index);
+
+/**
+ * @brief Build the index of a BGZF file from its member headers.
+ *
+ * Only the member headers and trailers are read, nothing is decompressed.
+ * Entries already in the index are dropped.
+ *
+ * @param  in BGZF file.
+ * @param  in_len Length of in.
+ * @param  index Index to fill.
+ * @return ISAL_DECOMP_OK (if everything is ok),
+ *         ISAL_INVALID_WRAPPER (if a member does not have a BGZF header),
+ *         ISAL_END_INPUT (if the last member is truncated),
+ *         ISAL_INVALID_STATE (if an entry could not be allocated).
+ */
+int
+isal_bgzf_index_build(const uint8_t *in, uint64_t in_len, struct isal_bgzf_index *index);
+
+/**
+ * @brief Read uncompressed data at an offset of a BGZF file.
+ *
+ * Only the members holding the range are decompressed, each one with
+ * isal_inflate_stateless() and with its crc and size checked.
+ *
+ * @param  index Index of the file.
+ * @param  in BGZF file.
+ * @param  in_len Length of in.
+ * @param  offset Uncompressed offset to read from.
+ * @param  out Output buffer.
+ * @param  len Bytes to read on input. Returns the bytes read, which is less
+ *             only at the end of the file.
+ * @return ISAL_DECOMP_OK (if everything is ok),
+ *         ISAL_INVALID_WRAPPER (if a member does not have a BGZF header),
+ *         ISAL_END_INPUT (if a member is truncated),
+ *         ISAL_INVALID_STATE (if scratch memory could not be allocated),
+ *         or the isal_inflate_stateless() error of a corrupt member.
+ */
+int
+isal_bgzf_read_at(const struct isal_bgzf_index *index, const uint8_t *in, uint64_t in_len,
+                  uint64_t offset, uint8_t *out, uint64_t *len);
+
+/**
+ * @brief Size of an index saved in .gzi format.
+ *
+ * @param  index Index to serialize.
+ * @return Bytes needed by isal_bgzf_index_save().
+ */
+uint64_t
+isal_bgzf_index_size(const struct isal_bgzf_index *index);
+
+/**
+ * @brief Serialize an index in the .gzi format of htslib.
+ *
+ * The format is a little endian u64 entry count followed by a u64 compressed
+ * offset and a u64 uncompressed offset per entry.
+ *
+ * @param  index Index to serialize.
+ * @param  buf Output buffer.
+ * @param  len Size of buf on input, at least isal_bgzf_index_size().
+ *             Returns the number of bytes written.
+ * @return ISAL_DECOMP_OK or ISAL_OUT_OVERFLOW.
+ */
+int
+isal_bgzf_index_save(const struct isal_bgzf_index *index, uint8_t *buf, uint64_t *len);
+
+/**
+ * @brief Load an index in .gzi format.
+ *
+ * @param  buf Serialized index.
+ * @param  len Length of buf.
+ * @return Index, or NULL if buf is not a valid index or out of memory.
+ */
+struct isal_bgzf_index *
+isal_bgzf_index_load(const uint8_t *buf, uint64_t len);
+
 /******************************************************************************/
 /* Other functions */
 /******************************************************************************/
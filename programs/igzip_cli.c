@@ -41,8 +41,21 @@
 #include <errno.h>
 #include "igzip_lib.h" /* Normally you use isa-l.h instead for external programs */
 
+#if defined(HAVE_MMAP)
+#include <sys/mman.h>
+#endif
+#if defined(HAVE_WRITEV)
+#include <sys/uio.h>
+#endif
+#if defined(HAVE_POSIX_FADVISE)
+#include <fcntl.h>
+#endif
+
 #if defined(HAVE_THREADS)
 #include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
 #include "crc.h"
 #endif
 
@@ -62,8 +75,8 @@
 #define FILE_READ_ERROR  -3
 #define FILE_WRITE_ERROR -4
 
-#define BUF_SIZE   1024
-#define BLOCK_SIZE (1024 * 1024)
+#define BUF_SIZE    1024
+#define BLOCK_SIZE  (1024 * 1024)
 
 #define MAX_FILEPATH_BUF 4096
 
@@ -86,7 +99,7 @@ int stdin_file_name_len = 1;
 
 enum compression_modes { COMPRESS_MODE, DECOMPRESS_MODE };
 
-enum long_only_opt_val { RM };
+enum long_only_opt_val { RM, BGZF };
 
 enum log_types { INFORM, WARN, ERROR, VERBOSE };
 
@@ -160,6 +173,7 @@ struct cli_options {
         int name;
         int test;
         int threads;
+        int bgzf;
         uint8_t *in_buf;
         uint8_t *out_buf;
         uint8_t *level_buf;
@@ -195,6 +209,7 @@ init_options(struct cli_options *options)
         options->out_buf_size = 0;
         options->level_buf_size = 0;
         options->threads = 1;
+        options->bgzf = false;
 };
 
 int
@@ -298,7 +313,8 @@ usage(int exit_code)
                   " -n, --no-name        do not save/use file name and timestamp in "
                   "compress/decompress\n"
                   " -t, --test           test compressed file integrity\n"
-                  " -T, --threads <n>    use n threads to compress if enabled\n"
+                  " -T, --threads <n>    use n threads to (de)compress, at most one per cpu\n"
+                  "     --bgzf           compress to BGZF blocks, with a .gzi index for a file\n"
                   " -q, --quiet          suppress warnings\n\n"
                   "with no infile, or when infile is - , read standard input\n\n",
                   ISAL_DEF_MAX_LEVEL);
@@ -421,155 +437,1015 @@ open_out_file(FILE **out, char *outfile_name)
 
 #if defined(HAVE_THREADS)
 
-#define MAX_THREADS  8
-#define MAX_JOBQUEUE 16 /* must be a power of 2 */
+/* Threads hand buffers to each other through slots, the thread owning a slot is given by the
+ * slot status alone. A thread waiting for a slot backs off with pipe_backoff(). */
+
+#define PIPE_SPINS    64
+#define PIPE_YIELDS   1024
+#define PIPE_SLEEP_NS 50000
+
+enum slot_status { SLOT_FREE = 0, SLOT_READ, SLOT_DONE, SLOT_FAIL };
+
+static inline uint64_t
+pipe_now_ns(void)
+{
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Spin, then yield, then sleep while another stage catches up */
+static inline void
+pipe_backoff(uint32_t *spins)
+{
+        struct timespec ts = { 0, PIPE_SLEEP_NS };
+
+        if (*spins >= PIPE_YIELDS)
+                nanosleep(&ts, NULL);
+        else if (*spins >= PIPE_SPINS)
+                sched_yield();
+        (*spins)++;
+}
+
+#endif // defined(HAVE_THREADS)
+
+/*
+ * Regular input files are mapped a window at a time and given to the library in place instead
+ * of being copied into in_buf. Output is queued as a batch of buffers and written with a single
+ * writev(). Input pages that have been used and output pages already written are dropped from
+ * the page cache, so long jobs do not evict everything else. Other files, and systems without
+ * mmap() or writev(), go through stdio.
+ *
+ * With threads, file_in_async() and file_out_async() move the I/O to helper threads so it
+ * overlaps with compression. A reader thread fills a ring of input buffers ahead of the caller
+ * and a writer thread writes out the batches the caller has queued, so that while buffer N is
+ * compressed buffer N+1 is read and batch N-1 is written. Mapped input needs no reader thread,
+ * the kernel is asked to read the next window ahead instead.
+ */
+
+#define IN_MAP_WINDOW (1024 * ISAL_BGZF_BLOCK_INPUT) /* About 64 MiB, page and BGZF aligned */
+#define OUT_BATCH     16                             /* Buffers queued per writev() */
+#define OUT_POOL_BUFS 4                              /* Buffers out_buf is split into */
+#define IO_RING_SLOTS 3                              /* Buffers being read, used and written */
+
+#if defined(HAVE_THREADS)
+struct io_slot {
+        atomic_int status;
+        uint8_t *buf;
+        size_t len; /* Input read into buf */
+        int eof;
+#if defined(HAVE_WRITEV)
+        struct iovec iov[OUT_BATCH]; /* Output batch to write */
+        uint8_t *owned[OUT_BATCH];
+        int count;
+#endif
+};
 
-enum job_status { JOB_UNALLOCATED = 0, JOB_ALLOCATED, JOB_SUCCESS, JOB_FAIL };
+struct io_ring {
+        struct io_slot slots[IO_RING_SLOTS];
+        uint8_t *bufs;
+        uint64_t seq; /* Next slot of the calling thread */
+        int eof;      /* The slot held by the calling thread is the last one */
+        atomic_int done;
+        pthread_t thread;
+        uint64_t io_ns;    /* Time the helper thread spent in I/O */
+        uint64_t stall_ns; /* Time the calling thread waited for the helper thread */
+};
+#endif
 
-struct thread_job {
-        uint8_t *next_in;
-        uint32_t avail_in;
-        uint8_t *next_out;
-        uint32_t avail_out;
-        uint32_t total_out;
-        uint32_t type;
-        uint32_t status;
+struct file_in {
+        FILE *in;
+        char *name;
+        uint8_t *buf;
+        size_t buf_size;
+#if defined(HAVE_MMAP)
+        int fd; /* -1 when reading through stdio */
+        uint8_t *map;
+        size_t map_len;
+        uint64_t map_off; /* File offset of map */
+        uint64_t pos;     /* File offset of the next window */
+        uint64_t size;
+#endif
+#if defined(HAVE_THREADS)
+        struct io_ring *ring; /* NULL when reading in the calling thread */
+#endif
 };
-struct thread_pool {
-        pthread_t threads[MAX_THREADS];
-        struct thread_job job[MAX_JOBQUEUE];
-        pthread_mutex_t mutex;
-        pthread_cond_t cond;
-        int head;
-        int tail;
-        int queue;
-        int shutdown;
+
+struct file_out {
+        FILE *out;
+        char *name;
+        uint8_t *pool;
+        size_t buf_size;
+        int next_buf;
+#if defined(HAVE_WRITEV)
+        int fd; /* -1 when writing through stdio */
+        int regular;
+        struct iovec iov[OUT_BATCH];
+        uint8_t *owned[OUT_BATCH]; /* Buffers to free once written */
+        int count;
+        uint64_t last_off; /* File offset of the previous batch */
+#endif
+#if defined(HAVE_THREADS)
+        struct io_ring *ring; /* NULL when writing in the calling thread */
+#endif
 };
 
-// Globals for thread pool
-struct thread_pool pool;
+#if defined(HAVE_THREADS)
+/* Allocates a ring with slot_size bytes of buffer per slot */
+static struct io_ring *
+io_ring_alloc(size_t slot_size)
+{
+        struct io_ring *ring = malloc_safe(sizeof(struct io_ring));
+        int i;
+
+        ring->bufs = malloc_safe(IO_RING_SLOTS * slot_size);
+        for (i = 0; i < IO_RING_SLOTS; i++) {
+                atomic_init(&ring->slots[i].status, SLOT_FREE);
+                ring->slots[i].buf = ring->bufs + i * slot_size;
+                ring->slots[i].len = 0;
+                ring->slots[i].eof = 0;
+#if defined(HAVE_WRITEV)
+                ring->slots[i].count = 0;
+#endif
+        }
+        ring->seq = 0;
+        ring->eof = 0;
+        atomic_init(&ring->done, 0);
+        ring->io_ns = 0;
+        ring->stall_ns = 0;
+        return ring;
+}
+
+static void
+io_ring_free(struct io_ring *ring)
+{
+        free(ring->bufs);
+        free(ring);
+}
+
+/* Waits in the calling thread for the helper thread to move slot to status */
+static void
+io_ring_wait(struct io_ring *ring, struct io_slot *slot, int status)
+{
+        uint64_t start = 0;
+        uint32_t spins = 0;
+
+        while (atomic_load_explicit(&slot->status, memory_order_acquire) != status) {
+                if (start == 0)
+                        start = pipe_now_ns();
+                pipe_backoff(&spins);
+        }
+        if (start != 0)
+                ring->stall_ns += pipe_now_ns() - start;
+}
+
+/* Stops the helper thread once it is done with the slots handed to it. The I/O time not waited
+ * for by the calling thread is the part that overlapped with its work. */
+static void
+io_ring_stop(struct io_ring *ring, const char *what)
+{
+        uint64_t hidden;
+
+        atomic_store_explicit(&ring->done, 1, memory_order_release);
+        pthread_join(ring->thread, NULL);
+
+        hidden = ring->io_ns > ring->stall_ns ? ring->io_ns - ring->stall_ns : 0;
+        log_print(VERBOSE, "Async %s: %.3f ms of I/O, waited %.3f ms, %.0f%% overlapped\n", what,
+                  ring->io_ns / 1e6, ring->stall_ns / 1e6,
+                  ring->io_ns ? 100.0 * hidden / ring->io_ns : 100.0);
+        io_ring_free(ring);
+}
+#endif
+
+void
+file_in_open(struct file_in *fi, FILE *in, char *name, uint8_t *buf, size_t buf_size)
+{
+#if defined(HAVE_MMAP)
+        struct stat st;
+#endif
+
+        fi->in = in;
+        fi->name = name;
+        fi->buf = buf;
+        fi->buf_size = buf_size;
+#if defined(HAVE_THREADS)
+        fi->ring = NULL;
+#endif
+#if defined(HAVE_MMAP)
+        fi->fd = -1;
+        fi->map = NULL;
+        fi->map_len = 0;
+        fi->map_off = 0;
+        fi->pos = 0;
+        fi->size = 0;
+
+        if (in == stdin || fstat(fileno(in), &st) != 0 || !S_ISREG(st.st_mode) ||
+            ftello(in) != 0)
+                return;
+
+        fi->fd = fileno(in);
+        fi->size = st.st_size;
+#if defined(HAVE_POSIX_FADVISE)
+        posix_fadvise(fi->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#endif
+}
+
+#if defined(HAVE_MMAP)
+/* Unmaps the current window, dropping the pages before file offset used from the cache */
+static void
+file_in_unmap(struct file_in *fi, uint64_t used)
+{
+        if (fi->map == NULL)
+                return;
+
+        munmap(fi->map, fi->map_len);
+#if defined(HAVE_POSIX_FADVISE)
+        if (used > fi->map_off)
+                posix_fadvise(fi->fd, fi->map_off, used - fi->map_off, POSIX_FADV_DONTNEED);
+#endif
+        fi->map = NULL;
+}
+
+/* Maps len bytes from file offset off, returns a pointer to them or NULL */
+static uint8_t *
+file_in_map(struct file_in *fi, uint64_t off, uint64_t len)
+{
+        uint64_t start = off & ~((uint64_t) sysconf(_SC_PAGESIZE) - 1);
+        uint8_t *map;
+
+        map = mmap(NULL, len + off - start, PROT_READ, MAP_PRIVATE, fi->fd, start);
+        if (map == MAP_FAILED)
+                return NULL;
 
-static inline int
-pool_has_space(void)
+#if defined(MADV_SEQUENTIAL)
+        madvise(map, len + off - start, MADV_SEQUENTIAL);
+#endif
+        fi->map = map;
+        fi->map_len = len + off - start;
+        fi->map_off = start;
+        return map + off - start;
+}
+#endif
+
+#if defined(HAVE_THREADS)
+static void *
+file_in_reader(void *arg)
+{
+        struct file_in *fi = arg;
+        struct io_ring *ring = fi->ring;
+        struct io_slot *slot;
+        uint64_t seq, start;
+        uint32_t spins;
+
+        for (seq = 0;; seq++) {
+                slot = &ring->slots[seq % IO_RING_SLOTS];
+
+                spins = 0;
+                while (atomic_load_explicit(&slot->status, memory_order_acquire) != SLOT_FREE) {
+                        if (atomic_load_explicit(&ring->done, memory_order_relaxed))
+                                return NULL;
+                        pipe_backoff(&spins);
+                }
+                if (atomic_load_explicit(&ring->done, memory_order_relaxed))
+                        return NULL;
+
+                start = pipe_now_ns();
+                slot->len = fread_safe(slot->buf, 1, fi->buf_size, fi->in, fi->name);
+                slot->eof = feof(fi->in);
+                ring->io_ns += pipe_now_ns() - start;
+                atomic_store_explicit(&slot->status, SLOT_READ, memory_order_release);
+
+                if (slot->eof)
+                        return NULL;
+        }
+}
+
+static size_t
+file_in_ring_read(struct file_in *fi, uint8_t **next)
 {
-        return ((pool.head + 1) % MAX_JOBQUEUE) != pool.tail;
+        struct io_ring *ring = fi->ring;
+        struct io_slot *slot;
+
+        *next = fi->buf;
+        if (ring->eof)
+                return 0;
+
+        /* The previous slot is used up, give it back to the reader */
+        if (ring->seq > 0)
+                atomic_store_explicit(&ring->slots[(ring->seq - 1) % IO_RING_SLOTS].status,
+                                      SLOT_FREE, memory_order_release);
+
+        slot = &ring->slots[ring->seq++ % IO_RING_SLOTS];
+        io_ring_wait(ring, slot, SLOT_READ);
+        ring->eof = slot->eof;
+        *next = slot->buf;
+        return slot->len;
 }
+#endif
 
-static inline int
-pool_has_work(void)
+/* Returns the next input in *next and its length, 0 at the end of the file. The input returned
+ * by the previous call must be used up. */
+size_t
+file_in_read(struct file_in *fi, uint8_t **next)
 {
-        return (pool.queue != pool.head);
+#if defined(HAVE_MMAP)
+        uint64_t len;
+#endif
+
+#if defined(HAVE_THREADS)
+        if (fi->ring != NULL)
+                return file_in_ring_read(fi, next);
+#endif
+#if defined(HAVE_MMAP)
+        if (fi->fd >= 0) {
+                file_in_unmap(fi, fi->pos);
+                len = fi->size - fi->pos;
+                if (len > IN_MAP_WINDOW)
+                        len = IN_MAP_WINDOW;
+
+                *next = len ? file_in_map(fi, fi->pos, len) : fi->buf;
+                if (*next != NULL) {
+                        fi->pos += len;
+#if defined(HAVE_POSIX_FADVISE)
+                        /* Have the next window read while this one is used */
+                        if (fi->pos < fi->size)
+                                posix_fadvise(fi->fd, fi->pos, IN_MAP_WINDOW, POSIX_FADV_WILLNEED);
+#endif
+                        return len;
+                }
+
+                /* Carry on through stdio from the same place */
+                fi->fd = -1;
+                if (fseeko(fi->in, fi->pos, SEEK_SET) != 0) {
+                        log_print(ERROR, "igzip: Error encountered while reading file %s\n",
+                                  fi->name);
+                        exit(FILE_READ_ERROR);
+                }
+        }
+#endif
+        *next = fi->buf;
+        return fread_safe(fi->buf, 1, fi->buf_size, fi->in, fi->name);
 }
 
 int
-pool_get_work(void)
+file_in_eof(struct file_in *fi)
 {
-        assert(pool.queue != pool.head);
-        pool.queue = (pool.queue + 1) % MAX_JOBQUEUE;
-        return pool.queue;
+#if defined(HAVE_THREADS)
+        if (fi->ring != NULL)
+                return fi->ring->eof;
+#endif
+#if defined(HAVE_MMAP)
+        if (fi->fd >= 0)
+                return fi->pos >= fi->size;
+#endif
+        return feof(fi->in);
 }
 
+/* Makes *next, the *avail bytes of the last read not yet used, and the rest of the file a single
+ * buffer. A mapped file is mapped up to its end, otherwise the rest is read into a new buffer
+ * returned in *alloc for the caller to free, if it is at most max_read bytes. Not for use after
+ * file_in_async(). Returns 0 on success. */
 int
-pool_put_work(struct isal_zstream *stream)
+file_in_rest(struct file_in *fi, uint8_t **next, uint32_t *avail, uint8_t **alloc, size_t max_read)
 {
-        pthread_mutex_lock(&pool.mutex);
-        if (!pool_has_space() || pool.shutdown) {
-                pthread_mutex_unlock(&pool.mutex);
-                return 1;
+        size_t file_size, in_size;
+        off_t file_pos;
+#if defined(HAVE_MMAP)
+        uint8_t *window = fi->map, *rest;
+        size_t window_len = fi->map_len;
+        uint64_t off;
+
+        if (fi->fd >= 0) {
+                off = fi->pos - *avail;
+                if (fi->size - off > UINT32_MAX)
+                        return 1;
+
+                /* Map the rest before dropping the window holding the unused input */
+                rest = file_in_map(fi, off, fi->size - off);
+                if (rest == NULL)
+                        return 1;
+                if (window != NULL)
+                        munmap(window, window_len);
+
+                fi->pos = fi->size;
+                *next = rest;
+                *avail = fi->size - off;
+                return 0;
         }
-        int idx = (pool.head + 1) % MAX_JOBQUEUE;
-        pool.job[idx].next_in = stream->next_in;
-        pool.job[idx].avail_in = stream->avail_in;
-        pool.job[idx].next_out = stream->next_out;
-        pool.job[idx].avail_out = stream->avail_out;
-        pool.job[idx].status = JOB_ALLOCATED;
-        pool.job[idx].type = stream->end_of_stream == 0 ? 0 : 1;
-        pool.head = idx;
-        pthread_cond_signal(&pool.cond);
-        pthread_mutex_unlock(&pool.mutex);
+#endif
+        file_size = get_filesize(fi->in);
+        file_pos = ftello(fi->in);
+        if (file_pos < 0 || file_size < (size_t) file_pos ||
+            file_size - file_pos > UINT32_MAX - *avail || file_size - file_pos > max_read)
+                return 1;
+
+        in_size = *avail + (file_size - file_pos);
+        *alloc = malloc(in_size);
+        if (*alloc == NULL)
+                return 1;
+
+        memcpy(*alloc, *next, *avail);
+        *avail += fread_safe(*alloc + *avail, 1, file_size - file_pos, fi->in, fi->name);
+        *next = *alloc;
         return 0;
 }
 
+/* Reads ahead in a helper thread from now on. Mapped input and input already at its end are
+ * left as they are. */
+void
+file_in_async(struct file_in *fi)
+{
+#if defined(HAVE_THREADS)
+#if defined(HAVE_MMAP)
+        if (fi->fd >= 0)
+                return;
+#endif
+        if (feof(fi->in))
+                return;
+
+        fi->ring = io_ring_alloc(fi->buf_size);
+        if (pthread_create(&fi->ring->thread, NULL, file_in_reader, fi) != 0) {
+                io_ring_free(fi->ring);
+                fi->ring = NULL;
+        }
+#endif
+}
+
+void
+file_in_close(struct file_in *fi)
+{
+#if defined(HAVE_THREADS)
+        if (fi->ring != NULL) {
+                io_ring_stop(fi->ring, "read");
+                fi->ring = NULL;
+        }
+#endif
+#if defined(HAVE_MMAP)
+        if (fi->fd >= 0 || fi->map != NULL)
+                file_in_unmap(fi, fi->map_off + fi->map_len);
+#endif
+}
+
+void
+file_out_open(struct file_out *fo, FILE *out, char *name, uint8_t *pool, size_t buf_size)
+{
+#if defined(HAVE_WRITEV)
+        struct stat st;
+#endif
+
+        fo->out = out;
+        fo->name = name;
+        fo->pool = pool;
+        fo->buf_size = buf_size;
+        fo->next_buf = 0;
+#if defined(HAVE_THREADS)
+        fo->ring = NULL;
+#endif
+#if defined(HAVE_WRITEV)
+        fo->fd = out != NULL ? fileno(out) : -1;
+        fo->regular = fo->fd >= 0 && fstat(fo->fd, &st) == 0 && S_ISREG(st.st_mode);
+        fo->count = 0;
+        fo->last_off = 0;
+#endif
+}
+
+#if defined(HAVE_WRITEV)
+/* Writes the n buffers of iov, then frees the owned ones */
+static void
+file_out_write(struct file_out *fo, struct iovec *iov, uint8_t **owned, int n)
+{
+        int i, count = n;
+        off_t off = 0;
+        ssize_t ret;
+
+        /* Anything written through stdio goes first */
+        fflush(fo->out);
+        if (fo->regular)
+                off = ftello(fo->out);
+
+        while (n > 0) {
+                ret = writev(fo->fd, iov, n);
+                if (ret < 0 && errno == EINTR)
+                        continue;
+                if (ret < 0) {
+                        log_print(ERROR, "igzip: Error encountered while writing to file %s\n",
+                                  fo->name);
+                        exit(FILE_WRITE_ERROR);
+                }
+
+                while (n > 0 && (size_t) ret >= iov->iov_len) {
+                        ret -= iov->iov_len;
+                        iov++;
+                        n--;
+                }
+                if (n > 0) {
+                        iov->iov_base = (uint8_t *) iov->iov_base + ret;
+                        iov->iov_len -= ret;
+                }
+        }
+
+        for (i = 0; i < count; i++)
+                free(owned[i]);
+
+#if defined(HAVE_POSIX_FADVISE)
+        /* Start writeback of this batch and drop the previous one, written back by now */
+        if (fo->regular && off > 0) {
+                posix_fadvise(fo->fd, off, 0, POSIX_FADV_DONTNEED);
+                posix_fadvise(fo->fd, fo->last_off, off - fo->last_off, POSIX_FADV_DONTNEED);
+                fo->last_off = off;
+        }
+#endif
+}
+
+#if defined(HAVE_THREADS)
+static void *
+file_out_writer(void *arg)
+{
+        struct file_out *fo = arg;
+        struct io_ring *ring = fo->ring;
+        struct io_slot *slot;
+        uint64_t seq, start;
+        uint32_t spins;
+
+        for (seq = 0;; seq++) {
+                slot = &ring->slots[seq % IO_RING_SLOTS];
+
+                spins = 0;
+                while (atomic_load_explicit(&slot->status, memory_order_acquire) != SLOT_READ) {
+                        /* Every batch queued before done was set is written */
+                        if (atomic_load_explicit(&ring->done, memory_order_acquire) &&
+                            atomic_load_explicit(&slot->status, memory_order_acquire) !=
+                                    SLOT_READ)
+                                return NULL;
+                        pipe_backoff(&spins);
+                }
+
+                start = pipe_now_ns();
+                file_out_write(fo, slot->iov, slot->owned, slot->count);
+                ring->io_ns += pipe_now_ns() - start;
+                atomic_store_explicit(&slot->status, SLOT_FREE, memory_order_release);
+        }
+}
+
+/* Hands the batch to the writer and moves on to the buffers of the next slot */
+static void
+file_out_ring_queue(struct file_out *fo)
+{
+        struct io_ring *ring = fo->ring;
+        struct io_slot *slot = &ring->slots[ring->seq++ % IO_RING_SLOTS];
+
+        memcpy(slot->iov, fo->iov, fo->count * sizeof(struct iovec));
+        memcpy(slot->owned, fo->owned, fo->count * sizeof(uint8_t *));
+        slot->count = fo->count;
+        atomic_store_explicit(&slot->status, SLOT_READ, memory_order_release);
+
+        slot = &ring->slots[ring->seq % IO_RING_SLOTS];
+        io_ring_wait(ring, slot, SLOT_FREE);
+        fo->pool = slot->buf;
+        fo->count = 0;
+}
+#endif
+#endif
+
+void
+file_out_flush(struct file_out *fo)
+{
+#if defined(HAVE_WRITEV)
+        if (fo->count > 0) {
+#if defined(HAVE_THREADS)
+                if (fo->ring != NULL)
+                        file_out_ring_queue(fo);
+#endif
+                if (fo->count > 0) {
+                        file_out_write(fo, fo->iov, fo->owned, fo->count);
+                        fo->count = 0;
+                }
+        }
+#endif
+        fo->next_buf = 0;
+}
+
+/* Returns a free buffer of buf_size bytes from the pool */
+uint8_t *
+file_out_buf(struct file_out *fo)
+{
+        if (fo->next_buf == OUT_POOL_BUFS)
+                file_out_flush(fo);
+
+        return fo->pool + fo->next_buf++ * fo->buf_size;
+}
+
+/* Queues len bytes of buf for writing. A buffer from malloc() given as owned is freed once
+ * written, a pool buffer stays in use until the next flush. */
+void
+file_out_put(struct file_out *fo, uint8_t *buf, size_t len, int owned)
+{
+        if (fo->out == NULL) {
+                if (owned)
+                        free(buf);
+                return;
+        }
+
+#if defined(HAVE_WRITEV)
+        if (fo->fd >= 0) {
+                if (fo->count == OUT_BATCH)
+                        file_out_flush(fo);
+
+                fo->iov[fo->count].iov_base = buf;
+                fo->iov[fo->count].iov_len = len;
+                fo->owned[fo->count] = owned ? buf : NULL;
+                fo->count++;
+                return;
+        }
+#endif
+        fwrite_safe(buf, 1, len, fo->out, fo->name);
+        if (owned)
+                free(buf);
+}
+
+/* Writes in a helper thread from now on, with a pool of buffers per batch being filled or
+ * written. Nothing may be queued or taken from the pool yet. */
+void
+file_out_async(struct file_out *fo)
+{
+#if defined(HAVE_THREADS) && defined(HAVE_WRITEV)
+        if (fo->out == NULL || fo->fd < 0)
+                return;
+
+        fo->ring = io_ring_alloc(OUT_POOL_BUFS * fo->buf_size);
+        if (pthread_create(&fo->ring->thread, NULL, file_out_writer, fo) != 0) {
+                io_ring_free(fo->ring);
+                fo->ring = NULL;
+                return;
+        }
+        fo->pool = fo->ring->slots[0].buf;
+#endif
+}
+
+/* Waits for everything flushed to be written */
+void
+file_out_close(struct file_out *fo)
+{
+#if defined(HAVE_THREADS)
+        if (fo->ring != NULL) {
+                io_ring_stop(fo->ring, "write");
+                fo->ring = NULL;
+        }
+#endif
+}
+
+#if defined(HAVE_THREADS)
+
+/* Threaded compression is a three stage pipeline. A reader thread fills the
+ * slots of a ring in order, any number of compressor threads take the next
+ * filled slot and deflate it as an independent full flushed block, and the
+ * calling thread writes the slots out in order and frees them for the reader.
+ * Each slot moves FREE -> READ -> DONE -> FREE, the stage owning a slot is
+ * given by its status alone so the stages only share atomics. */
+
+#define PIPE_SLOTS_PER_THREAD 2
+#define PIPE_MIN_SLOTS        4
+#define PIPE_NO_THREADS       -1
+
+#define THREAD_BUF_SIZE  (PIPE_SLOTS_PER_THREAD * 3 * BLOCK_SIZE)
+#define THREAD_MEM_SHARE 8 /* Thread buffers may take up to 1/8 of physical memory */
+
+/* Largest useful -T, more threads than online cpus only contend for the same cores and each
+ * thread adds THREAD_BUF_SIZE of slot buffers */
+static int
+thread_limit(void)
+{
+        long cpus = 1, limit;
+#if defined(_SC_NPROCESSORS_ONLN)
+        cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        cpus = cpus < 1 ? 1 : cpus;
+#endif
+        limit = cpus;
+#if defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+        {
+                long pages = sysconf(_SC_PHYS_PAGES), page_size = sysconf(_SC_PAGESIZE);
+                uint64_t budget;
+
+                if (pages > 0 && page_size > 0) {
+                        budget = (uint64_t) pages * page_size / THREAD_MEM_SHARE;
+                        if (budget / THREAD_BUF_SIZE < (uint64_t) limit)
+                                limit = budget / THREAD_BUF_SIZE;
+                }
+        }
+#endif
+        return limit < 1 ? 1 : limit;
+}
+
+struct pipe_slot {
+        atomic_int status;
+        atomic_uint_fast64_t seq; /* job held by the slot */
+        uint8_t *in;
+        uint8_t *out;
+        uint32_t in_len;
+        uint32_t out_len;
+        uint32_t crc;
+        int end_of_stream;
+};
+
+struct pipeline {
+        struct pipe_slot *slots;
+        uint64_t num_slots;
+        atomic_uint_fast64_t next_job; /* next job to claim by a compressor */
+        atomic_uint_fast64_t num_jobs; /* set by the reader at end of input */
+        atomic_int abort;
+        atomic_uint_fast64_t compress_stall_ns;
+        uint64_t read_stall_ns;
+        uint64_t write_stall_ns;
+        FILE *in;
+        char *infile_name;
+};
+
+void *
+pipe_reader(void *arg)
+{
+        struct pipeline *pl = arg;
+        struct pipe_slot *slot;
+        uint64_t seq, start;
+        uint32_t spins;
+
+        for (seq = 0;; seq++) {
+                slot = &pl->slots[seq % pl->num_slots];
+
+                spins = 0;
+                start = 0;
+                while (atomic_load_explicit(&slot->status, memory_order_acquire) != SLOT_FREE) {
+                        if (atomic_load_explicit(&pl->abort, memory_order_relaxed))
+                                return NULL;
+                        if (start == 0)
+                                start = pipe_now_ns();
+                        pipe_backoff(&spins);
+                }
+                if (start != 0)
+                        pl->read_stall_ns += pipe_now_ns() - start;
+
+                slot->in_len = fread_safe(slot->in, 1, BLOCK_SIZE, pl->in, pl->infile_name);
+                slot->end_of_stream = feof(pl->in);
+
+                /* The job count is published before the last job so any stage seeing the
+                 * last job also sees the count */
+                if (slot->end_of_stream)
+                        atomic_store_explicit(&pl->num_jobs, seq + 1, memory_order_relaxed);
+
+                atomic_store_explicit(&slot->seq, seq, memory_order_relaxed);
+                atomic_store_explicit(&slot->status, SLOT_READ, memory_order_release);
+
+                if (slot->end_of_stream)
+                        return NULL;
+        }
+}
+
 void *
-thread_worker(void *none)
+pipe_compressor(void *arg)
 {
+        struct pipeline *pl = arg;
+        struct pipe_slot *slot;
         struct isal_zstream wstream;
-        int check;
-        int work_idx;
         int level = global_options.level;
         int level_size = level_size_buf[level];
         uint8_t *level_buf = malloc_safe(level_size);
+        uint64_t seq, start, stall = 0;
+        uint32_t spins;
+        int check;
+
         log_print(VERBOSE, "Start worker\n");
 
-        while (!pool.shutdown) {
-                pthread_mutex_lock(&pool.mutex);
-                while (!pool_has_work() && !pool.shutdown) {
-                        pthread_cond_wait(&pool.cond, &pool.mutex);
+        while (!atomic_load_explicit(&pl->abort, memory_order_relaxed)) {
+                seq = atomic_fetch_add_explicit(&pl->next_job, 1, memory_order_relaxed);
+                slot = &pl->slots[seq % pl->num_slots];
+
+                spins = 0;
+                start = 0;
+                while (atomic_load_explicit(&slot->status, memory_order_acquire) != SLOT_READ ||
+                       atomic_load_explicit(&slot->seq, memory_order_relaxed) != seq) {
+                        if (seq >= atomic_load_explicit(&pl->num_jobs, memory_order_acquire) ||
+                            atomic_load_explicit(&pl->abort, memory_order_relaxed))
+                                goto worker_quit;
+                        if (start == 0)
+                                start = pipe_now_ns();
+                        pipe_backoff(&spins);
                 }
-                if (pool.shutdown) {
-                        pthread_mutex_unlock(&pool.mutex);
-                        continue;
-                }
-
-                work_idx = pool_get_work();
-                pthread_cond_signal(&pool.cond);
-                pthread_mutex_unlock(&pool.mutex);
+                if (start != 0)
+                        stall += pipe_now_ns() - start;
 
                 isal_deflate_stateless_init(&wstream);
-                wstream.next_in = pool.job[work_idx].next_in;
-                wstream.next_out = pool.job[work_idx].next_out;
-                wstream.avail_in = pool.job[work_idx].avail_in;
-                wstream.avail_out = pool.job[work_idx].avail_out;
-                wstream.end_of_stream = pool.job[work_idx].type;
+                wstream.next_in = slot->in;
+                wstream.next_out = slot->out;
+                wstream.avail_in = slot->in_len;
+                wstream.avail_out = 2 * BLOCK_SIZE;
+                wstream.end_of_stream = slot->end_of_stream;
                 wstream.flush = FULL_FLUSH;
-                wstream.level = global_options.level;
+                wstream.level = level;
                 wstream.level_buf = level_buf;
                 wstream.level_buf_size = level_size;
 
                 check = isal_deflate_stateless(&wstream);
-                log_print(VERBOSE, "Worker finished job %d, out=%d\n", work_idx, wstream.total_out);
+                log_print(VERBOSE, "Worker finished job %llu, out=%d\n", (unsigned long long) seq,
+                          wstream.total_out);
 
-                pool.job[work_idx].total_out = wstream.total_out;
-                pool.job[work_idx].status = JOB_SUCCESS + check; // complete or fail
-                if (check)
-                        break;
+                slot->crc = crc32_gzip_refl(0, slot->in, slot->in_len);
+                slot->out_len = wstream.total_out;
+                atomic_store_explicit(&slot->status, check ? SLOT_FAIL : SLOT_DONE,
+                                      memory_order_release);
         }
+
+worker_quit:
+        atomic_fetch_add_explicit(&pl->compress_stall_ns, stall, memory_order_relaxed);
         free(level_buf);
         log_print(VERBOSE, "Worker quit\n");
-        pthread_exit(NULL);
+        return NULL;
 }
 
+/* Runs the pipeline on in and writes hdr then the deflate blocks to out in order. Returns 0 on
+ * success with the checksum and length of the input in crc and total_in, or PIPE_NO_THREADS
+ * if the threads could not be started, before anything is read or written. */
 int
-pool_create(void)
+pipe_compress(FILE *in, char *infile_name, FILE *out, char *outfile_name, uint8_t *hdr,
+              uint32_t hdr_len, uint32_t *crc, uint64_t *total_in)
 {
-        int i;
-        int nthreads = global_options.threads - 1;
-        pool.head = 0;
-        pool.tail = 0;
-        pool.queue = 0;
-        pool.shutdown = 0;
-        for (i = 0; i < nthreads; i++)
-                pthread_create(&pool.threads[i], NULL, thread_worker, NULL);
-
-        log_print(VERBOSE, "Created %d pool threads\n", nthreads);
-        return 0;
-}
+        struct pipeline pl;
+        struct pipe_slot *slot;
+        pthread_t reader, *compressors;
+        uint8_t *bufs;
+        uint64_t seq, i, start;
+        uint32_t spins;
+        int status, ret = 0;
+        int nthreads = global_options.threads, started;
+
+        pl.num_slots = (uint64_t) nthreads * PIPE_SLOTS_PER_THREAD;
+        if (pl.num_slots < PIPE_MIN_SLOTS)
+                pl.num_slots = PIPE_MIN_SLOTS;
+
+        pl.slots = malloc_safe(pl.num_slots * sizeof(struct pipe_slot));
+        bufs = malloc_safe(pl.num_slots * 3 * BLOCK_SIZE);
+        compressors = malloc_safe(nthreads * sizeof(pthread_t));
+
+        for (i = 0; i < pl.num_slots; i++) {
+                atomic_init(&pl.slots[i].status, SLOT_FREE);
+                atomic_init(&pl.slots[i].seq, 0);
+                pl.slots[i].in = bufs + i * 3 * BLOCK_SIZE;
+                pl.slots[i].out = pl.slots[i].in + BLOCK_SIZE;
+        }
+        atomic_init(&pl.next_job, 0);
+        atomic_init(&pl.num_jobs, UINT64_MAX);
+        atomic_init(&pl.abort, 0);
+        atomic_init(&pl.compress_stall_ns, 0);
+        pl.read_stall_ns = 0;
+        pl.write_stall_ns = 0;
+        pl.in = in;
+        pl.infile_name = infile_name;
+
+        /* The compressors go first as they do not touch the input. Fewer of them only slow the
+         * pipeline down, without the reader nothing can be done. */
+        for (started = 0; started < nthreads; started++)
+                if (pthread_create(&compressors[started], NULL, pipe_compressor, &pl) != 0)
+                        break;
+        if (started == 0 || pthread_create(&reader, NULL, pipe_reader, &pl) != 0) {
+                atomic_store_explicit(&pl.abort, 1, memory_order_relaxed);
+                ret = PIPE_NO_THREADS;
+                goto pipe_compress_join;
+        }
 
-void
-pool_quit(void)
-{
-        int i;
-        pthread_mutex_lock(&pool.mutex);
-        pool.shutdown = 1;
-        pthread_mutex_unlock(&pool.mutex);
-        pthread_cond_broadcast(&pool.cond);
-        for (i = 0; i < global_options.threads - 1; i++)
-                pthread_join(pool.threads[i], NULL);
-        log_print(VERBOSE, "Deleted %d pool threads\n", i);
+        log_print(VERBOSE, "Created %d compressor threads, %llu slots\n", started,
+                  (unsigned long long) pl.num_slots);
+
+        fwrite_safe(hdr, 1, hdr_len, out, outfile_name);
+
+        *crc = 0;
+        *total_in = 0;
+        for (seq = 0; seq < atomic_load_explicit(&pl.num_jobs, memory_order_acquire); seq++) {
+                slot = &pl.slots[seq % pl.num_slots];
+
+                spins = 0;
+                start = 0;
+                while ((status = atomic_load_explicit(&slot->status, memory_order_acquire)) <
+                               SLOT_DONE ||
+                       atomic_load_explicit(&slot->seq, memory_order_relaxed) != seq) {
+                        if (start == 0)
+                                start = pipe_now_ns();
+                        pipe_backoff(&spins);
+                }
+                if (start != 0)
+                        pl.write_stall_ns += pipe_now_ns() - start;
+
+                if (status == SLOT_FAIL) {
+                        ret = 1;
+                        atomic_store_explicit(&pl.abort, 1, memory_order_relaxed);
+                        break;
+                }
+
+                fwrite_safe(slot->out, 1, slot->out_len, out, outfile_name);
+                *crc = crc32_gzip_refl_combine(*crc, slot->crc, slot->in_len);
+                *total_in += slot->in_len;
+                atomic_store_explicit(&slot->status, SLOT_FREE, memory_order_release);
+        }
+
+        pthread_join(reader, NULL);
+
+        log_print(VERBOSE,
+                  "Pipeline stalls: reader %.3f ms, compressors %.3f ms, writer %.3f ms\n",
+                  pl.read_stall_ns / 1e6,
+                  atomic_load_explicit(&pl.compress_stall_ns, memory_order_relaxed) / 1e6,
+                  pl.write_stall_ns / 1e6);
+
+pipe_compress_join:
+        for (i = 0; i < (uint64_t) started; i++)
+                pthread_join(compressors[i], NULL);
+
+        free(compressors);
+        free(bufs);
+        free(pl.slots);
+        return ret;
 }
 
 #endif // defined(HAVE_THREADS)
 
+/*
+ * BGZF output: independent members of ISAL_BGZF_BLOCK_INPUT bytes each, compressed
+ * BGZF_BLOCKS_PER_THREAD at a time per thread. A .gzi index is written next to a
+ * named output file.
+ */
+#define BGZF_BLOCKS_PER_THREAD 16
+
+int
+bgzf_compress(FILE *in, char *infile_name, FILE *out, char *outfile_name)
+{
+        struct isal_zstream stream;
+        struct isal_bgzf_index *index;
+        struct file_in fi;
+        FILE *gzi = NULL;
+        char *gzi_name = NULL;
+        uint8_t *inbuf, *outbuf, *gzi_buf, *next;
+        uint64_t chunk, gzi_len, len;
+        int ret, eof;
+
+        chunk = (uint64_t) ISAL_BGZF_BLOCK_INPUT * BGZF_BLOCKS_PER_THREAD * global_options.threads;
+        inbuf = malloc_safe(chunk);
+        outbuf = malloc_safe(ISAL_BGZF_BOUND(chunk));
+        index = isal_bgzf_index_create();
+        if (index == NULL) {
+                log_print(ERROR, "igzip: Failed to allocate required memory\n");
+                exit(MALLOC_FAILED);
+        }
+
+        isal_deflate_stateless_init(&stream);
+        stream.level = global_options.level;
+        file_in_open(&fi, in, infile_name, inbuf, chunk);
+
+        /* Mapped windows are a multiple of the member input size, like chunk */
+        do {
+                len = file_in_read(&fi, &next);
+                eof = file_in_eof(&fi);
+                do {
+                        stream.next_in = next;
+                        stream.avail_in = len < chunk ? len : chunk;
+                        stream.end_of_stream = eof && stream.avail_in == len;
+                        stream.next_out = outbuf;
+                        stream.avail_out = ISAL_BGZF_BOUND(chunk);
+                        next += stream.avail_in;
+                        len -= stream.avail_in;
+
+                        ret = isal_bgzf_compress(&stream, global_options.threads, index);
+                        if (ret != COMP_OK)
+                                goto bgzf_cleanup;
+
+                        fwrite_safe(outbuf, 1, stream.next_out - outbuf, out, outfile_name);
+                } while (len > 0);
+        } while (!eof);
+
+        if (outfile_name != NULL && out != stdout) {
+                gzi_name = malloc_safe(strlen(outfile_name) + sizeof(".gzi"));
+                strcpy(gzi_name, outfile_name);
+                strcat(gzi_name, ".gzi");
+
+                gzi_len = isal_bgzf_index_size(index);
+                gzi_buf = malloc_safe(gzi_len);
+                isal_bgzf_index_save(index, gzi_buf, &gzi_len);
+
+                gzi = fopen_safe(gzi_name, "wb");
+                if (gzi != NULL) {
+                        fwrite_safe(gzi_buf, 1, gzi_len, gzi, gzi_name);
+                        fclose(gzi);
+                        log_print(VERBOSE, "Wrote index %s\n", gzi_name);
+                }
+                free(gzi_buf);
+                free(gzi_name);
+        }
+
+bgzf_cleanup:
+        file_in_close(&fi);
+        isal_bgzf_index_free(index);
+        free(outbuf);
+        free(inbuf);
+        return ret;
+}
+
 int
 compress_file(void)
 {
@@ -579,7 +1455,9 @@ compress_file(void)
         int level_size = 0;
         struct isal_zstream stream;
         struct isal_gzip_header gz_hdr;
-        int ret, success = 0;
+        struct file_in fi;
+        struct file_out fo;
+        int ret, success = 0, threaded = 0;
 
         char *infile_name = global_options.infile_name;
         char *outfile_name = global_options.outfile_name;
@@ -626,9 +1504,27 @@ compress_file(void)
 
         inbuf_size = global_options.in_buf_size;
         outbuf_size = global_options.out_buf_size;
-
         inbuf = global_options.in_buf;
-        outbuf = global_options.out_buf;
+
+        file_in_open(&fi, in, infile_name, inbuf, inbuf_size);
+        file_out_open(&fo, out, outfile_name, global_options.out_buf, outbuf_size);
+
+        if (global_options.bgzf) {
+                if (bgzf_compress(in, infile_name, out, outfile_name)) {
+                        log_print(ERROR, "igzip: Error encountered while compressing file %s\n",
+                                  infile_name);
+                        goto compress_file_cleanup;
+                }
+                success = 1;
+                goto compress_file_cleanup;
+        }
+
+        if (global_options.threads == 1) {
+                file_in_async(&fi);
+                file_out_async(&fo);
+        }
+
+        outbuf = file_out_buf(&fo);
         level_size = global_options.level_buf_size;
         level_buf = global_options.level_buf;
 
@@ -653,111 +1549,37 @@ compress_file(void)
 
         isal_write_gzip_header(&stream, &gz_hdr);
 
-        if (global_options.threads > 1) {
 #if defined(HAVE_THREADS)
-                int q;
-                int end_of_stream = 0;
-                uint32_t crc = 0;
-                uint64_t total_in = 0;
-
-                // Write the header
-                fwrite_safe(outbuf, 1, stream.total_out, out, outfile_name);
-
-                do {
-                        size_t nread;
-                        size_t inbuf_used = 0;
-                        size_t outbuf_used = 0;
-                        uint8_t *iptr = inbuf;
-                        uint8_t *optr = outbuf;
-
-                        for (q = 0; q < MAX_JOBQUEUE - 1; q++) {
-                                inbuf_used += BLOCK_SIZE;
-                                outbuf_used += 2 * BLOCK_SIZE;
-                                if (inbuf_used > inbuf_size || outbuf_used > outbuf_size)
-                                        break;
-
-                                nread = fread_safe(iptr, 1, BLOCK_SIZE, in, infile_name);
-                                crc = crc32_gzip_refl(crc, iptr, nread);
-                                end_of_stream = feof(in);
-                                total_in += nread;
-                                stream.next_in = iptr;
-                                stream.next_out = optr;
-                                stream.avail_in = nread;
-                                stream.avail_out = 2 * BLOCK_SIZE;
-                                stream.end_of_stream = end_of_stream;
-                                ret = pool_put_work(&stream);
-                                if (ret || end_of_stream)
-                                        break;
-
-                                iptr += BLOCK_SIZE;
-                                optr += 2 * BLOCK_SIZE;
-                        }
-
-                        while (pool.tail != pool.head) { // Unprocessed jobs
-                                int t = (pool.tail + 1) % MAX_JOBQUEUE;
-                                if (pool.job[t].status >= JOB_SUCCESS) { // Finished next
-                                        if (pool.job[t].status > JOB_SUCCESS) {
-                                                success = 0;
-                                                log_print(ERROR,
-                                                          "igzip: Error encountered while "
-                                                          "compressing file %s\n",
-                                                          infile_name);
-                                                goto compress_file_cleanup;
-                                        }
-                                        fwrite_safe(pool.job[t].next_out, 1, pool.job[t].total_out,
-                                                    out, outfile_name);
-
-                                        pool.job[t].total_out = 0;
-                                        pool.job[t].status = 0;
-                                        pool.tail = t;
-                                        pthread_cond_broadcast(&pool.cond);
-                                }
-                                // Pick up a job while we wait
-                                pthread_mutex_lock(&pool.mutex);
-                                if (!pool_has_work()) {
-                                        pthread_mutex_unlock(&pool.mutex);
-                                        continue;
-                                }
-
-                                int work_idx = pool_get_work();
-                                pthread_cond_signal(&pool.cond);
-                                pthread_mutex_unlock(&pool.mutex);
-
-                                isal_deflate_stateless_init(&stream);
-                                stream.next_in = pool.job[work_idx].next_in;
-                                stream.next_out = pool.job[work_idx].next_out;
-                                stream.avail_in = pool.job[work_idx].avail_in;
-                                stream.avail_out = pool.job[work_idx].avail_out;
-                                stream.end_of_stream = pool.job[work_idx].type;
-                                stream.flush = FULL_FLUSH;
-                                stream.level = global_options.level;
-                                stream.level_buf = level_buf;
-                                stream.level_buf_size = level_size;
-                                int check = isal_deflate_stateless(&stream);
-                                log_print(VERBOSE, "Self   finished job %d, out=%d\n", work_idx,
-                                          stream.total_out);
-                                pool.job[work_idx].total_out = stream.total_out;
-                                pool.job[work_idx].status = JOB_SUCCESS + check; // complete or fail
-                        }
-                } while (!end_of_stream);
-
-                // Write gzip trailer
-                fwrite_safe(&crc, sizeof(uint32_t), 1, out, outfile_name);
-                fwrite_safe(&total_in, sizeof(uint32_t), 1, out, outfile_name);
-
-#else // No compiled threading support but asked for threads > 1
-                assert(1);
+        if (global_options.threads > 1) {
+                uint32_t crc;
+                uint64_t total_in;
+
+                // Writes the header once its threads are running
+                ret = pipe_compress(in, infile_name, out, outfile_name, outbuf, stream.total_out,
+                                    &crc, &total_in);
+                if (ret == PIPE_NO_THREADS) {
+                        log_print(VERBOSE, "Could not start threads, compressing on one\n");
+                } else if (ret != 0) {
+                        log_print(ERROR, "igzip: Error encountered while compressing file %s\n",
+                                  infile_name);
+                        goto compress_file_cleanup;
+                } else {
+                        // Write gzip trailer
+                        fwrite_safe(&crc, sizeof(uint32_t), 1, out, outfile_name);
+                        fwrite_safe(&total_in, sizeof(uint32_t), 1, out, outfile_name);
+                        threaded = 1;
+                }
+        }
 #endif
-        } else { // Single thread
+        if (!threaded) { // Single thread
                 do {
                         if (stream.avail_in == 0) {
-                                stream.next_in = inbuf;
-                                stream.avail_in =
-                                        fread_safe(stream.next_in, 1, inbuf_size, in, infile_name);
-                                stream.end_of_stream = feof(in);
+                                stream.avail_in = file_in_read(&fi, &stream.next_in);
+                                stream.end_of_stream = file_in_eof(&fi);
                         }
 
                         if (stream.next_out == NULL) {
+                                outbuf = file_out_buf(&fo);
                                 stream.next_out = outbuf;
                                 stream.avail_out = outbuf_size;
                         }
@@ -771,15 +1593,21 @@ compress_file(void)
                                 goto compress_file_cleanup;
                         }
 
-                        fwrite_safe(outbuf, 1, stream.next_out - outbuf, out, outfile_name);
+                        file_out_put(&fo, outbuf, stream.next_out - outbuf, 0);
                         stream.next_out = NULL;
 
-                } while (!feof(in) || stream.avail_out == 0);
+                } while (!file_in_eof(&fi) || stream.avail_out == 0);
+                file_out_flush(&fo);
         }
 
         success = 1;
 
 compress_file_cleanup:
+        if (out != NULL) {
+                file_in_close(&fi);
+                file_out_close(&fo);
+        }
+
         if (out != NULL && out != stdout)
                 fclose(out);
 
@@ -795,14 +1623,406 @@ compress_file_cleanup:
         return (success == 0);
 }
 
+#if defined(HAVE_THREADS)
+
+/* Other than BGZF members, a member is decompressed in one call only up to PARALLEL_MAX_OUT
+ * bytes, and input that cannot be mapped is read into memory only up to PARALLEL_MAX_READ bytes.
+ * Larger ones are streamed. */
+#define PARALLEL_MAX_OUT  (256 * 1024 * 1024)
+#define PARALLEL_MAX_READ (256 * 1024 * 1024)
+#define INFLATE_MAX_RATIO 1032 /* A match of 258 bytes coded in 2 bits */
+
+/* The members of a multi-member file are decompressed a member at a time by worker threads. A
+ * BGZF member header, as written by bgzip, gives the size of its member, so the next member start
+ * is found without inflating. Other member starts are found by searching for gzip headers, and as
+ * those bytes can also occur inside compressed data, each match is only a candidate. The calling
+ * thread writes the members in order and takes a candidate only where the member before it ended,
+ * candidates inside a member are dropped. A member is decoded into a buffer of at most
+ * MEMBER_MAX_OUT bytes, the calling thread carries on with a larger one from where its worker
+ * stopped and writes the rest straight out. */
+
+#define MEMBER_WINDOW_PER_THREAD 4
+#define MEMBER_INIT_ENTRIES      64
+#define MEMBER_INIT_OUT          (256 * 1024)
+#define MEMBER_MAX_OUT           (8 * 1024 * 1024)
+#define MEMBER_MIN_SIZE          20 /* Header, empty static block and trailer */
+
+struct member_job {
+        atomic_int status; /* SLOT_FREE until decoded, then SLOT_DONE or SLOT_FAIL */
+        size_t offset;
+        size_t in_len; /* Member size given by its BGZF header, else 0 */
+        size_t end;    /* Input offset the member ended at */
+        uint8_t *out;
+        size_t out_len;
+        struct inflate_state *rest; /* State to finish a member larger than MEMBER_MAX_OUT */
+};
+
+struct member_set {
+        struct member_job *members;
+        size_t num_members;
+        uint8_t *buf;
+        size_t len;
+        size_t window;
+        int hdr_read;              /* The header of the first member was read by the caller */
+        atomic_size_t next_member; /* next member to claim by a worker */
+        atomic_size_t written;     /* members the writer is done with */
+        atomic_int abort;
+};
+
+/* Returns the size of the member if p holds a BGZF header, else 0 */
+static size_t
+member_bgzf_size(const uint8_t *p, size_t avail)
+{
+        if (avail < ISAL_BGZF_HDR_SIZE || p[0] != 31 || p[1] != 139 || p[2] != 8 ||
+            (p[3] & 0xe4) != 4 || p[10] != 6 || p[11] != 0 || p[12] != 'B' || p[13] != 'C' ||
+            p[14] != 2 || p[15] != 0)
+                return 0;
+        return (size_t) (p[16] | p[17] << 8) + 1;
+}
+
+/* Returns the offset of the first possible gzip header at or after from, or len if none */
+static size_t
+member_next(const uint8_t *buf, size_t len, size_t from)
+{
+        const uint8_t *p;
+
+        while (from < len && len - from >= MEMBER_MIN_SIZE) {
+                p = memchr(buf + from, 31, len - from - MEMBER_MIN_SIZE + 1);
+                if (p == NULL)
+                        break;
+                if (p[1] == 139 && p[2] == 8 && (p[3] & 0xe0) == 0)
+                        return p - buf;
+                from = p - buf + 1;
+        }
+        return len;
+}
+
+/* Lists the members of buf, the first one first_len bytes long or of unknown size if 0. A BGZF
+ * member is followed by the member its header size leads to, any other one by the next possible
+ * gzip header. Returns the number of members. */
+static size_t
+scan_members(uint8_t *buf, size_t len, size_t first_len, struct member_job **members)
+{
+        struct member_job *m = NULL;
+        size_t num = 0, size = 0, from = 0, bsize = first_len;
+
+        while (from < len) {
+                if (num == size) {
+                        size = size ? 2 * size : MEMBER_INIT_ENTRIES;
+                        m = realloc(m, size * sizeof(*m));
+                        if (m == NULL) {
+                                log_print(ERROR, "igzip: Failed to allocate required memory\n");
+                                exit(MALLOC_FAILED);
+                        }
+                }
+
+                memset(&m[num], 0, sizeof(*m));
+                m[num].offset = from;
+                m[num].in_len = bsize <= len - from ? bsize : 0;
+                from = m[num].in_len != 0 ? from + bsize : member_next(buf, len, from + 1);
+                bsize = member_bgzf_size(buf + from, len - from);
+                num++;
+        }
+
+        *members = m;
+        return num;
+}
+
+static int
+inflate_member(struct member_set *set, size_t i)
+{
+        struct member_job *m = &set->members[i];
+        struct inflate_state state;
+        size_t out_size = MEMBER_INIT_OUT;
+        uint32_t isize;
+        uint8_t *p;
+
+        /* A BGZF trailer gives the decompressed size */
+        if (m->in_len >= 8) {
+                p = set->buf + m->offset + m->in_len - 4;
+                isize = p[0] | p[1] << 8 | p[2] << 16 | (uint32_t) p[3] << 24;
+                if (isize > ISAL_BGZF_MAX_BLOCK)
+                        return 1;
+                out_size = isize + 1;
+        }
+        m->out = malloc(out_size);
+        if (m->out == NULL)
+                return 1;
+
+        isal_inflate_init(&state);
+        state.crc_flag = i == 0 && set->hdr_read ? ISAL_GZIP_NO_HDR_VER : ISAL_GZIP;
+        state.next_in = set->buf + m->offset;
+        state.avail_in = m->in_len != 0 ? m->in_len : set->len - m->offset;
+        state.next_out = m->out;
+        state.avail_out = out_size;
+
+        while (1) {
+                if (isal_inflate(&state) != ISAL_DECOMP_OK)
+                        return 1;
+                if (state.block_state == ISAL_BLOCK_FINISH)
+                        break;
+                if (state.avail_out != 0)
+                        return 1; // Input ended inside the member
+
+                if (out_size >= MEMBER_MAX_OUT) {
+                        /* Too large to hold, the writer finishes it */
+                        m->rest = malloc(sizeof(state));
+                        if (m->rest == NULL)
+                                return 1;
+                        memcpy(m->rest, &state, sizeof(state));
+                        m->out_len = state.total_out;
+                        return 0;
+                }
+
+                out_size = out_size * 2 < MEMBER_MAX_OUT ? out_size * 2 : MEMBER_MAX_OUT;
+                p = realloc(m->out, out_size);
+                if (p == NULL)
+                        return 1;
+                m->out = p;
+                state.next_out = p + state.total_out;
+                state.avail_out = out_size - state.total_out;
+        }
+
+        m->end = state.next_in - set->buf;
+        m->out_len = state.total_out;
+        return 0;
+}
+
+void *
+member_worker(void *arg)
+{
+        struct member_set *set = arg;
+        size_t i;
+        uint32_t spins;
+        int ret;
+
+        while (!atomic_load_explicit(&set->abort, memory_order_relaxed)) {
+                i = atomic_fetch_add_explicit(&set->next_member, 1, memory_order_relaxed);
+                if (i >= set->num_members)
+                        break;
+
+                /* Stay within a window of the writer to bound the memory held */
+                spins = 0;
+                while (i >= atomic_load_explicit(&set->written, memory_order_acquire) +
+                                    set->window) {
+                        if (atomic_load_explicit(&set->abort, memory_order_relaxed))
+                                return NULL;
+                        pipe_backoff(&spins);
+                }
+
+                ret = inflate_member(set, i);
+                atomic_store_explicit(&set->members[i].status, ret ? SLOT_FAIL : SLOT_DONE,
+                                      memory_order_release);
+        }
+        return NULL;
+}
+
+/* Inflates the rest of the member in state straight to the output. Returns 0 once the member
+ * has ended. */
+static int
+member_stream(struct inflate_state *state, struct file_out *fo)
+{
+        uint8_t *outbuf;
+
+        do {
+                outbuf = file_out_buf(fo);
+                state->next_out = outbuf;
+                state->avail_out = global_options.out_buf_size;
+                if (isal_inflate(state) != ISAL_DECOMP_OK)
+                        return 1;
+                file_out_put(fo, outbuf, state->next_out - outbuf, 0);
+        } while (state->block_state != ISAL_BLOCK_FINISH && state->avail_out == 0);
+
+        return state->block_state != ISAL_BLOCK_FINISH;
+}
+
+/* Decompresses and writes the members of buf in order, the first one first_len bytes long if it
+ * is a BGZF member, else 0, and with its header already read if hdr_read is set. Returns 0 with
+ * state set after the last member decoded, 1 with state untouched if the first member was not
+ * decoded, or -1 if a member failed after part of it was written. */
+int
+decompress_members(struct inflate_state *state, uint8_t *buf, size_t len, size_t first_len,
+                   int hdr_read, struct file_out *fo)
+{
+        struct member_set set;
+        struct member_job *m;
+        pthread_t *workers;
+        size_t i, expect = 0, count = 0;
+        int nthreads = global_options.threads, started, status, ret = 0;
+        uint32_t spins;
+
+        set.num_members = scan_members(buf, len, first_len, &set.members);
+        set.buf = buf;
+        set.len = len;
+        set.hdr_read = hdr_read;
+        set.window = (size_t) nthreads * MEMBER_WINDOW_PER_THREAD;
+        atomic_init(&set.next_member, 0);
+        atomic_init(&set.written, 0);
+        atomic_init(&set.abort, 0);
+        for (i = 0; i < set.num_members; i++)
+                atomic_init(&set.members[i].status, SLOT_FREE);
+
+        workers = malloc_safe(nthreads * sizeof(pthread_t));
+        for (started = 0; started < nthreads; started++)
+                if (pthread_create(&workers[started], NULL, member_worker, &set) != 0)
+                        break;
+
+        /* Without workers nothing is decoded, the writer leaves everything to the stream */
+        i = 0;
+        while (started > 0 && expect < len) {
+                /* Drop the candidates inside the last member */
+                while (i < set.num_members && set.members[i].offset < expect)
+                        atomic_store_explicit(&set.written, ++i, memory_order_release);
+
+                if (i == set.num_members || set.members[i].offset != expect) {
+                        /* A member the scan missed, such as one after a false BGZF header */
+                        if (len - expect < MEMBER_MIN_SIZE || buf[expect] != 31 ||
+                            buf[expect + 1] != 139)
+                                break; // Junk is left to the stream
+                        isal_inflate_init(state);
+                        state->crc_flag = ISAL_GZIP;
+                        state->next_in = buf + expect;
+                        state->avail_in = len - expect;
+                        if (member_stream(state, fo)) {
+                                ret = -1;
+                                break;
+                        }
+                        expect = state->next_in - buf;
+                        count++;
+                        continue;
+                }
+
+                m = &set.members[i];
+                spins = 0;
+                while ((status = atomic_load_explicit(&m->status, memory_order_acquire)) ==
+                       SLOT_FREE)
+                        pipe_backoff(&spins);
+                if (status != SLOT_DONE)
+                        break;
+
+                file_out_put(fo, m->out, m->out_len, 1);
+                m->out = NULL;
+                if (m->rest != NULL) {
+                        if (member_stream(m->rest, fo)) {
+                                ret = -1;
+                                break;
+                        }
+                        m->end = m->rest->next_in - buf;
+                }
+                expect = m->end;
+                count++;
+                atomic_store_explicit(&set.written, ++i, memory_order_release);
+        }
+
+        atomic_store_explicit(&set.abort, 1, memory_order_relaxed);
+        for (i = 0; i < (size_t) started; i++)
+                pthread_join(workers[i], NULL);
+        for (i = 0; i < set.num_members; i++) {
+                free(set.members[i].out);
+                free(set.members[i].rest);
+        }
+        free(set.members);
+        free(workers);
+        file_out_flush(fo);
+
+        log_print(VERBOSE, "Decompressed %llu members of %llu candidates on %d threads\n",
+                  (unsigned long long) count, (unsigned long long) set.num_members, started);
+
+        if (ret != 0 || count == 0)
+                return ret ? ret : 1;
+
+        state->next_in = buf + expect;
+        state->avail_in = len - expect;
+        state->block_state = ISAL_BLOCK_FINISH;
+        return 0;
+}
+
+/* Decompresses the member whose header is in state, its first hdr_len bytes in hdr. The rest of
+ * the file is mapped, or read into *file_buf if at most PARALLEL_MAX_READ bytes. A BGZF member
+ * and the members following it are decompressed a member per thread. Any other member of up to
+ * PARALLEL_MAX_OUT bytes is decompressed with isal_inflate_parallel(), and the members right
+ * after it a member per thread. If the first member does not decompress in one call, state is
+ * left at the start of the buffered data so streaming can carry on. Returns 0 when the first
+ * member has been written, with state after the last member written, or -1 if a later member
+ * failed after part of it was written. */
+int
+decompress_parallel(struct inflate_state *state, struct file_in *fi, struct file_out *fo,
+                    unsigned char **file_buf, const uint8_t *hdr, size_t hdr_len)
+{
+        struct inflate_state par_state;
+        unsigned char *outbuf, *buf;
+        size_t bsize, out_size;
+        uint32_t in_size;
+        int ret;
+
+        if (fi->in == stdin || state->read_in_length != 0 || state->tmp_in_size != 0)
+                return 1;
+
+        if (file_in_rest(fi, &state->next_in, &state->avail_in, file_buf, PARALLEL_MAX_READ))
+                return 1;
+
+        buf = state->next_in;
+        in_size = state->avail_in;
+        if (in_size < 4)
+                return 1;
+
+        bsize = hdr_len >= ISAL_BGZF_HDR_SIZE ? member_bgzf_size(hdr, ISAL_BGZF_HDR_SIZE) : 0;
+        if (bsize > hdr_len)
+                return decompress_members(state, buf, in_size, bsize - hdr_len, 1, fo);
+
+        /* ISIZE at the end of the file is the size of the last member only, other members or junk
+         * may follow this one. Give it as much output as its input could inflate to, up to
+         * PARALLEL_MAX_OUT, and stream it if it is larger. The pages never written to are left
+         * untouched by malloc() of a large buffer. */
+        out_size = in_size < PARALLEL_MAX_OUT / INFLATE_MAX_RATIO ? in_size * INFLATE_MAX_RATIO
+                                                                  : PARALLEL_MAX_OUT;
+        outbuf = malloc(out_size);
+        if (outbuf == NULL)
+                return 1;
+
+        isal_inflate_init(&par_state);
+        par_state.crc_flag = ISAL_GZIP_NO_HDR_VER;
+        par_state.next_in = state->next_in;
+        par_state.avail_in = state->avail_in;
+        par_state.next_out = outbuf;
+        par_state.avail_out = out_size;
+
+        ret = isal_inflate_parallel(&par_state, global_options.threads);
+        if (ret != ISAL_DECOMP_OK) {
+                log_print(VERBOSE, "igzip: Parallel decompression of %s returned %d, streaming\n",
+                          fi->name, ret);
+                free(outbuf);
+                return 1;
+        }
+
+        file_out_put(fo, outbuf, par_state.total_out, 1);
+        file_out_flush(fo);
+
+        state->next_in = par_state.next_in;
+        state->avail_in = par_state.avail_in;
+        state->block_state = ISAL_BLOCK_FINISH;
+
+        /* Look for more members where this one ended */
+        if (state->avail_in >= MEMBER_MIN_SIZE && state->next_in[0] == 31 &&
+            state->next_in[1] == 139) {
+                bsize = member_bgzf_size(state->next_in, state->avail_in);
+                if (decompress_members(state, state->next_in, state->avail_in, bsize, 0, fo) < 0)
+                        return -1;
+        }
+        return 0;
+}
+#endif
+
 int
 decompress_file(void)
 {
         FILE *in = NULL, *out = NULL;
-        unsigned char *inbuf = NULL, *outbuf = NULL;
+        unsigned char *inbuf = NULL, *outbuf = NULL, *file_buf = NULL;
         size_t inbuf_size, outbuf_size;
         struct inflate_state state;
         struct isal_gzip_header gz_hdr;
+        struct file_in fi;
+        struct file_out fo = { 0 };
         const int terminal = 0, implicit = 1, stripped = 2;
         int ret = 0, success = 0, outfile_type = terminal;
 
@@ -815,6 +2035,10 @@ decompress_file(void)
         size_t suffix_len = global_options.suffix_len;
         int suffix_index = 0;
         uint32_t file_time;
+#if defined(HAVE_THREADS)
+        uint8_t hdr[ISAL_BGZF_HDR_SIZE];
+        size_t hdr_len;
+#endif
 
         // Allocate mem and setup to hold gzip header info
         if (infile_name_len == stdin_file_name_len && infile_name != NULL &&
@@ -870,7 +2094,7 @@ decompress_file(void)
         inbuf_size = global_options.in_buf_size;
         outbuf_size = global_options.out_buf_size;
         inbuf = global_options.in_buf;
-        outbuf = global_options.out_buf;
+        file_in_open(&fi, in, infile_name, inbuf, inbuf_size);
 
         isal_gzip_header_init(&gz_hdr);
         if (outfile_type == implicit) {
@@ -880,8 +2104,11 @@ decompress_file(void)
 
         isal_inflate_init(&state);
         state.crc_flag = ISAL_GZIP_NO_HDR_VER;
-        state.next_in = inbuf;
-        state.avail_in = fread_safe(state.next_in, 1, inbuf_size, in, infile_name);
+        state.avail_in = file_in_read(&fi, &state.next_in);
+#if defined(HAVE_THREADS)
+        hdr_len = state.avail_in;
+        memcpy(hdr, state.next_in, hdr_len < sizeof(hdr) ? hdr_len : sizeof(hdr));
+#endif
 
         // Actually read and save the header info
         ret = isal_read_gzip_header(&state, &gz_hdr);
@@ -893,6 +2120,9 @@ decompress_file(void)
 
         if (outfile_type == implicit)
                 file_time = gz_hdr.time;
+#if defined(HAVE_THREADS)
+        hdr_len -= state.avail_in;
+#endif
 
         /* RFC 1952 §2.3.1: the NAME field stores a bare filename with any
          * directory components already removed by the compressor. Strip any
@@ -929,36 +2159,50 @@ decompress_file(void)
                 if (out == NULL)
                         goto decompress_file_cleanup;
         }
+        file_out_open(&fo, out, outfile_name, global_options.out_buf, outbuf_size);
+
+#if defined(HAVE_THREADS)
+        // Testing checks the data with isal_inflate_verify() while streaming
+        if (global_options.threads > 1 && global_options.test == NO_TEST &&
+            decompress_parallel(&state, &fi, &fo, &file_buf, hdr, hdr_len) < 0) {
+                log_print(ERROR, "igzip: Error encountered while decompressing file %s\n",
+                          infile_name);
+                goto decompress_file_cleanup;
+        }
+#endif
+
+        file_in_async(&fi);
+        file_out_async(&fo);
 
         // Start reading in compressed data and decompress
-        do {
-                if (state.avail_in == 0) {
-                        state.next_in = inbuf;
-                        state.avail_in = fread_safe(state.next_in, 1, inbuf_size, in, infile_name);
-                }
+        while (state.block_state != ISAL_BLOCK_FINISH) {
+                if (state.avail_in == 0)
+                        state.avail_in = file_in_read(&fi, &state.next_in);
 
+                outbuf = file_out_buf(&fo);
                 state.next_out = outbuf;
                 state.avail_out = outbuf_size;
 
-                ret = isal_inflate(&state);
+                // When testing only check the data, the output buffer is left untouched
+                if (global_options.test == TEST)
+                        ret = isal_inflate_verify(&state);
+                else
+                        ret = isal_inflate(&state);
                 if (ret != ISAL_DECOMP_OK) {
                         log_print(ERROR, "igzip: Error encountered while decompressing file %s\n",
                                   infile_name);
                         goto decompress_file_cleanup;
                 }
 
-                if (out != NULL)
-                        fwrite_safe(outbuf, 1, state.next_out - outbuf, out, outfile_name);
+                file_out_put(&fo, outbuf, state.next_out - outbuf, 0);
 
-        } while (state.block_state != ISAL_BLOCK_FINISH // while not done
-                 && (!feof(in) || state.avail_out == 0) // and work to do
-        );
+                if (file_in_eof(&fi) && state.avail_out != 0) // no work left to do
+                        break;
+        }
 
         // Add the following to look for and decode additional concatenated files
-        if (!feof(in) && state.avail_in == 0) {
-                state.next_in = inbuf;
-                state.avail_in = fread_safe(state.next_in, 1, inbuf_size, in, infile_name);
-        }
+        if (!file_in_eof(&fi) && state.avail_in == 0)
+                state.avail_in = file_in_read(&fi, &state.next_in);
 
         while (state.avail_in > 0 && state.next_in[0] == 31) {
                 // Look for magic numbers for gzip header. Follows the gzread() decision
@@ -969,16 +2213,17 @@ decompress_file(void)
                 isal_inflate_reset(&state);
                 state.crc_flag = ISAL_GZIP; // Let isal_inflate() process extra headers
                 do {
-                        if (state.avail_in == 0 && !feof(in)) {
-                                state.next_in = inbuf;
-                                state.avail_in =
-                                        fread_safe(state.next_in, 1, inbuf_size, in, infile_name);
-                        }
+                        if (state.avail_in == 0 && !file_in_eof(&fi))
+                                state.avail_in = file_in_read(&fi, &state.next_in);
 
+                        outbuf = file_out_buf(&fo);
                         state.next_out = outbuf;
                         state.avail_out = outbuf_size;
 
-                        ret = isal_inflate(&state);
+                        if (global_options.test == TEST)
+                                ret = isal_inflate_verify(&state);
+                        else
+                                ret = isal_inflate(&state);
                         if (ret != ISAL_DECOMP_OK) {
                                 log_print(ERROR,
                                           "igzip: Error while decompressing extra concatenated"
@@ -987,17 +2232,15 @@ decompress_file(void)
                                 goto decompress_file_cleanup;
                         }
 
-                        if (out != NULL)
-                                fwrite_safe(outbuf, 1, state.next_out - outbuf, out, outfile_name);
+                        file_out_put(&fo, outbuf, state.next_out - outbuf, 0);
 
                 } while (state.block_state != ISAL_BLOCK_FINISH &&
-                         (!feof(in) || state.avail_out == 0));
+                         (!file_in_eof(&fi) || state.avail_out == 0));
 
-                if (!feof(in) && state.avail_in == 0) {
-                        state.next_in = inbuf;
-                        state.avail_in = fread_safe(state.next_in, 1, inbuf_size, in, infile_name);
-                }
+                if (!file_in_eof(&fi) && state.avail_in == 0)
+                        state.avail_in = file_in_read(&fi, &state.next_in);
         }
+        file_out_flush(&fo);
 
         if (state.block_state != ISAL_BLOCK_FINISH)
                 log_print(ERROR, "igzip: Error %s does not contain a complete gzip file\n",
@@ -1006,6 +2249,10 @@ decompress_file(void)
                 success = 1;
 
 decompress_file_cleanup:
+        if (in != NULL && inbuf != NULL)
+                file_in_close(&fi);
+        file_out_close(&fo);
+
         if (out != NULL && out != stdout) {
                 fclose(out);
                 if (success)
@@ -1021,6 +2268,8 @@ decompress_file_cleanup:
         if (allocated_name != NULL)
                 free(allocated_name);
 
+        free(file_buf);
+
         return (success == 0);
 }
 
@@ -1054,6 +2303,7 @@ main(int argc, char *argv[])
                                          { "name", no_argument, NULL, 'N' },
                                          { "test", no_argument, NULL, 't' },
                                          { "threads", required_argument, NULL, 'T' },
+                                         { "bgzf", no_argument, &long_only_flag, BGZF },
                                          /* Possible future extensions
                                             {"recursive, no_argument, NULL, 'r'},
                                             {"list", no_argument, NULL, 'l'},
@@ -1081,6 +2331,9 @@ main(int argc, char *argv[])
                         case RM:
                                 global_options.remove = true;
                                 break;
+                        case BGZF:
+                                global_options.bgzf = true;
+                                break;
                         default:
                                 bad_option = 1;
                                 bad_c = c;
@@ -1132,7 +2385,7 @@ main(int argc, char *argv[])
                 case 'T':
 #if defined(HAVE_THREADS)
                         c = atoi(optarg);
-                        c = c > MAX_THREADS ? MAX_THREADS : c;
+                        c = c > thread_limit() ? thread_limit() : c;
                         c = c < 1 ? 1 : c;
                         global_options.threads = c;
 #endif
@@ -1171,15 +2424,8 @@ main(int argc, char *argv[])
         global_options.in_buf_size = BLOCK_SIZE;
         global_options.out_buf_size = BLOCK_SIZE;
 
-#if defined(HAVE_THREADS)
-        if (global_options.threads > 1) {
-                global_options.in_buf_size += (BLOCK_SIZE * MAX_JOBQUEUE);
-                global_options.out_buf_size += (BLOCK_SIZE * MAX_JOBQUEUE * 2);
-                pool_create();
-        }
-#endif
         global_options.in_buf = malloc_safe(global_options.in_buf_size);
-        global_options.out_buf = malloc_safe(global_options.out_buf_size);
+        global_options.out_buf = malloc_safe(OUT_POOL_BUFS * global_options.out_buf_size);
         global_options.level_buf_size = level_size_buf[global_options.level];
         global_options.level_buf = malloc_safe(global_options.level_buf_size);
 
@@ -1203,10 +2449,6 @@ main(int argc, char *argv[])
                         optind++;
                 }
         }
-#if defined(HAVE_THREADS)
-        if (global_options.threads > 1)
-                pool_quit();
-#endif
 
         free(global_options.in_buf);
         free(global_options.out_buf);
@@ -82,6 +82,14 @@ ret=0
 (for i in `seq 3`; do $IGZIP -c $TEST_FILE ; done) | $IGZIP -t || ret=1
 pass_check $ret "Multiple gzip concatenated files"
 
+# Concatenated files also decompress with threads, the members after the first are streamed
+ret=0
+(for i in `seq 3`; do $IGZIP -c $TEST_FILE ; done) > $file1$ds
+(for i in `seq 3`; do cat $TEST_FILE ; done) > $file2
+$IGZIP -dc -T 4 $file1$ds | cmp -s - $file2 || ret=1
+pass_check $ret "Parallel decompression of concatenated files"
+clear_dir
+
 if command -V md5sum >/dev/null 2>&1; then
     sum1=$((for i in `seq 15`; do $IGZIP -c $TEST_FILE; done) |  $IGZIP -cd | md5sum)
     sum2=$((for i in `seq 15`; do cat $TEST_FILE; done) | md5sum)
@@ -232,6 +240,16 @@ $IGZIP -t $file1$ds &> /dev/null && ret=1
 pass_check $ret "Test test"
 clear_dir
 
+# BGZF output is plain gzip members and gets a .gzi index
+ret=0
+cp $TEST_FILE $file1
+$IGZIP --bgzf -T 2 $file1 -o $file1$ds || ret=1
+[ -s $file1$ds.gzi ] || ret=1
+$IGZIP -dc $file1$ds | cmp -s - $file1 || ret=1
+$IGZIP -dc -T 4 $file1$ds | cmp -s - $file1 || ret=1
+pass_check $ret "BGZF compression"
+clear_dir
+
 # Large stream test with threading if enabled
 ret=0
 (for i in `seq 100`; do cat $TEST_FILE ; done) | $IGZIP -c -T 4 | $IGZIP -t || ret=1